@@ -25,14 +25,30 @@ set(SECUREMR_UTILS_SRCS "")
 
 if (USE_SECURE_MR_UTILS)
     list(APPEND SECUREMR_UTILS_SRCS
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/framegate.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/gatedpipeline.cpp
         ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/pipeline.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/parametric.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/partition.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/pipelinegraph.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/pipelinepool.cpp
         ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/rendercommand.cpp
         ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/serialization.cpp
         ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/session.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/tensorarena.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/tensorbandwidth.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/tensormemory.cpp
         ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/tensor.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/securemr_utils/trace.cpp
     )
 endif()
 
+# Host-side reference kernels of the SecureMR operators, opt-in per sample
+if (USE_SECURE_MR_UTILS AND USE_SECURE_MR_HOST_KERNELS)
+    include(${CMAKE_CURRENT_LIST_DIR}/securemr_utils/host/host.cmake)
+    list(APPEND SECUREMR_UTILS_SRCS ${SECUREMR_HOST_KERNEL_SRCS})
+endif()
+
 # Dependency: OpenXR
 include("${CMAKE_CURRENT_LIST_DIR}/../external/openxr/openxr.cmake")
 # Dependency: Vulkan
@@ -0,0 +1,221 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "framegate.h"
+
+#include <utility>
+#include <vector>
+
+namespace SecureMR {
+
+namespace {
+
+// Milliseconds per unit of the high word of a nanosecond timestamp
+constexpr float MILLIS_PER_HIGH_WORD = 4294.967296f;
+
+TensorAttribute ScalarMat(const XrSecureMrTensorDataTypePICO dataType) {
+  return {.dimensions = {1, 1}, .channels = 1, .usage = XR_SECURE_MR_TENSOR_TYPE_MAT_PICO, .dataType = dataType};
+}
+
+float BudgetMillis(const std::chrono::nanoseconds budget) {
+  return std::chrono::duration<float, std::milli>(budget).count();
+}
+
+}  // namespace
+
+FrameGate::FrameGate(std::shared_ptr<FrameworkSession> session, std::shared_ptr<GlobalTensor> timestamp,
+                     std::string name, FrameGateOptions options)
+    : m_session(std::move(session)),
+      m_timestamp(std::move(timestamp)),
+      m_name(std::move(name)),
+      m_options(std::move(options)) {
+  CHECK_MSG(m_timestamp != nullptr, "FrameGate: null timestamp tensor")
+
+  m_condition = std::make_shared<GlobalTensor>(m_session,
+                                               TensorAttribute_ScalarArray{1, XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO});
+  m_condition->setData(std::vector<int8_t>{0});
+  m_candidate = std::make_shared<GlobalTensor>(m_session, TensorAttribute_TimeStamp{});
+  m_lastProcessed = std::make_shared<GlobalTensor>(m_session, TensorAttribute_TimeStamp{});
+  m_lastProcessed->setData(std::vector<int32_t>{0, 0, 0, 0});
+  m_session->bandwidth().label(*m_condition, m_name + " condition");
+  m_session->bandwidth().label(*m_candidate, m_name + " candidate frame");
+  m_session->bandwidth().label(*m_lastProcessed, m_name + " last processed frame");
+
+  createGatePipeline();
+  createMarkPipeline();
+}
+
+void FrameGate::createGatePipeline() {
+  m_gate = std::make_unique<ParametricPipeline>(m_session);
+  auto& gate = *m_gate->pipeline();
+  const auto floatMat = ScalarMat(XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO);
+  const auto intMat = ScalarMat(XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO);
+  const auto floatData = [](const float value) {
+    const auto* bytes = reinterpret_cast<const int8_t*>(&value);
+    return std::vector<int8_t>(bytes, bytes + sizeof(value));
+  };
+
+  // Step 1: the budget written by the host, and the placeholders of the global tensors
+  auto budgetMillis = m_gate->addParameter(m_name + " budget (ms)", floatMat,
+                                           floatData(BudgetMillis(m_options.budget)));
+  auto timestamp = PipelineTensor::PipelinePlaceholderLike(m_gate->pipeline(), m_timestamp);
+  auto lastProcessed = PipelineTensor::PipelinePlaceholderLike(m_gate->pipeline(), m_lastProcessed);
+  auto candidate = PipelineTensor::PipelinePlaceholderLike(m_gate->pipeline(), m_candidate);
+  auto condition = PipelineTensor::PipelinePlaceholderLike(m_gate->pipeline(), m_condition);
+  m_gate->bind(timestamp, m_timestamp).bind(condition, m_condition).bind(candidate, m_candidate);
+
+  // Step 2: local tensors
+  const auto local = [this](const TensorAttribute& attribute) {
+    return std::make_shared<PipelineTensor>(m_gate->pipeline(), attribute);
+  };
+  auto nowStamp = local(TensorAttribute_TimeStamp{});
+  auto highWord = local(intMat), lowWord = local(intMat), nowHighWord = local(intMat), nowLowWord = local(intMat);
+  auto high = local(floatMat), low = local(floatMat), lowWrapped = local(floatMat);
+  auto nowHigh = local(floatMat), nowLow = local(floatMat), nowLowWrapped = local(floatMat);
+  auto ageMillis = local(floatMat), fresh = local(intMat);
+
+  // Step 3: "now" is the capture time of the newest camera frame when the gate executes, so that a gate queued
+  // behind a slow consumer measures the age at its execution, in the clock of the camera timestamps
+  gate.cameraAccess(nullptr, nullptr, nowStamp, nullptr);
+
+  // Step 4: the age of the frame, from the differences of the words, which are small enough for FLOAT32. A low word
+  // beyond INT32 reads 2^32 too low, i.e., one high word too low.
+  gate.assignment((*timestamp)[0][0], highWord)
+      .assignment((*timestamp)[0][1], lowWord)
+      .assignment((*nowStamp)[0][0], nowHighWord)
+      .assignment((*nowStamp)[0][1], nowLowWord)
+      .typeConvert(highWord, high)
+      .typeConvert(lowWord, low)
+      .typeConvert(nowHighWord, nowHigh)
+      .typeConvert(nowLowWord, nowLow)
+      .compareTo(*low < std::vector<float>{0.0f}, lowWrapped)
+      .compareTo(*nowLow < std::vector<float>{0.0f}, nowLowWrapped)
+      .arithmetic(Fmt("({0} + {1} - {2} - {3}) * %.6f + ({4} - {5}) * 0.000001", MILLIS_PER_HIGH_WORD),
+                  {nowHigh, nowLowWrapped, high, lowWrapped, nowLow, low}, ageMillis)
+      .compareTo(*ageMillis < budgetMillis, fresh);
+
+  if (m_options.requireNewFrame) {
+    // Step 5: a new frame differs from the last processed one in either word
+    m_gate->bind(lastProcessed, m_lastProcessed);
+    auto lastHighWord = local(intMat), lastLowWord = local(intMat);
+    auto highChanged = local(intMat), lowChanged = local(intMat), isNew = local(intMat);
+    auto changes = local(TensorAttribute{.dimensions = {2, 1}, .channels = 1,
+                                         .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
+    auto gates = local(TensorAttribute{.dimensions = {2, 1}, .channels = 1,
+                                       .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
+    gate.assignment((*lastProcessed)[0][0], lastHighWord)
+        .assignment((*lastProcessed)[0][1], lastLowWord)
+        .compareTo(*highWord != lastHighWord, highChanged)
+        .compareTo(*lowWord != lastLowWord, lowChanged)
+        .assignment(highChanged, (*changes)[{{0, 1}, {0, 1}}])
+        .assignment(lowChanged, (*changes)[{{1, 2}, {0, 1}}])
+        .any(changes, isNew)
+        .assignment(fresh, (*gates)[{{0, 1}, {0, 1}}])
+        .assignment(isNew, (*gates)[{{1, 2}, {0, 1}}])
+        .all(gates, condition);
+  } else {
+    gate.assignment(fresh, condition);
+  }
+
+  // Step 6: the frame judged, recorded by the mark pipeline if the consumer ran
+  gate.assignment(timestamp, candidate);
+}
+
+void FrameGate::createMarkPipeline() {
+  m_mark = std::make_shared<Pipeline>(m_session);
+  auto candidate = PipelineTensor::PipelinePlaceholderLike(m_mark, m_candidate);
+  auto lastProcessed = PipelineTensor::PipelinePlaceholderLike(m_mark, m_lastProcessed);
+  m_mark->assignment(candidate, lastProcessed);
+  m_markArguments = {{candidate, m_candidate}, {lastProcessed, m_lastProcessed}};
+}
+
+XrSecureMrPipelineRunPICO FrameGate::evaluate() {
+  std::string text;
+  XrSecureMrPipelineRunPICO lastMark;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    lastMark = m_lastMark;
+    ++m_stats.evaluations;
+    if (m_lastFrame.has_value()) {
+      if (m_options.requireNewFrame && m_frameProcessed) {
+        ++m_stats.skippedDuplicate;
+      } else if (Clock::now() - *m_lastFrame >= m_options.budget) {
+        ++m_stats.skippedStale;
+      } else {
+        m_frameProcessed = true;
+      }
+    }
+    if (m_options.reportEvery > 0 && m_stats.evaluations % m_options.reportEvery == 0) text = reportLocked();
+  }
+  if (!text.empty()) Log::Write(Log::Level::Info, text);
+
+  // The gate overwrites the condition and the candidate, so it waits for the previous gated run and its mark
+  return m_gate->submit(lastMark);
+}
+
+XrSecureMrPipelineRunPICO FrameGate::markProcessed(const XrSecureMrPipelineRunPICO consumerRun) {
+  const auto run = m_mark->submit(m_markArguments, consumerRun, m_condition);
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_lastMark = run;
+  return run;
+}
+
+XrSecureMrPipelineRunPICO FrameGate::submit(
+    Pipeline& pipeline, const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap) {
+  const auto run = pipeline.submit(argumentMap, evaluate(), m_condition);
+  markProcessed(run);
+  return run;
+}
+
+void FrameGate::noteFrame() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  ++m_stats.framesNoted;
+  m_lastFrame = Clock::now();
+  m_frameProcessed = false;
+}
+
+void FrameGate::setBudget(const std::chrono::nanoseconds budget) {
+  const float millis = BudgetMillis(budget);
+  m_gate->set(m_name + " budget (ms)", &millis, 1);
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_options.budget = budget;
+}
+
+std::chrono::nanoseconds FrameGate::budget() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_options.budget;
+}
+
+FrameGate::Stats FrameGate::stats() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_stats;
+}
+
+std::string FrameGate::report() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return reportLocked();
+}
+
+std::string FrameGate::reportLocked() const {
+  std::string text = Fmt("Frame gate \"%s\" (%.1f ms budget): %llu evaluations", m_name.c_str(),
+                         BudgetMillis(m_options.budget), static_cast<unsigned long long>(m_stats.evaluations));
+  if (m_stats.framesNoted == 0) return text + ", skips not estimated without noted frames";
+  return text + Fmt(", %llu frames, ~%llu runs skipped (%llu duplicate, %llu stale)",
+                    static_cast<unsigned long long>(m_stats.framesNoted),
+                    static_cast<unsigned long long>(m_stats.skipped()),
+                    static_cast<unsigned long long>(m_stats.skippedDuplicate),
+                    static_cast<unsigned long long>(m_stats.skippedStale));
+}
+
+}  // namespace SecureMR
@@ -0,0 +1,154 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_FRAMEGATE_H_
+#define SECUREMR_UTILS_FRAMEGATE_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "parametric.h"
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+struct FrameGateOptions {
+  /**
+   * Oldest camera frame still worth processing
+   */
+  std::chrono::nanoseconds budget = std::chrono::milliseconds(100);
+  /**
+   * Also skip a frame already processed by a previous gated submission
+   */
+  bool requireNewFrame = true;
+  /**
+   * Log the report every this many evaluations, 0 for no periodic report
+   */
+  uint64_t reportEvery = 0;
+};
+
+/**
+ * Gates the submissions of a pipeline consuming camera frames on the age and novelty of the current frame, so that
+ * an expensive consumer, e.g., model inference or 2D to 3D mapping, skips frames which are stale or which it has
+ * already processed.
+ * <br/>
+ * The gate is a small pipeline reading the 4-channel INT32 timestamp global tensor written by the camera access
+ * operator, <code>{nanoseconds >> 32, nanoseconds & 0xffffffff, ...}</code>, and comparing it with the timestamp of
+ * the newest camera frame, read by its own camera access when the gate executes, i.e., after any consumer it waits
+ * for. It writes the INT8 <code>condition</code> global tensor, non-zero if the frame is younger than the budget
+ * and, with <code>requireNewFrame</code>, differs from the last frame which passed the gate.
+ * The last frame is recorded by a second small pipeline submitted after the consumer, under the same condition, and
+ * the next evaluation waits for it, so that the condition stays unchanged while the consumer is pending.
+ * <br/>
+ * The decisions stay in the secure runtime, so the skipped runs reported are estimated on the host: from the
+ * submissions of the pipeline producing the frames, announced by <code>noteFrame</code>, taking the time of the last
+ * one as the time of the current frame. Without <code>noteFrame</code>, only evaluations are counted.
+ */
+class FrameGate {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stats {
+    uint64_t evaluations = 0;
+    uint64_t framesNoted = 0;
+    /**
+     * Evaluations estimated to skip the consumer, as its frame is a duplicate or is stale
+     */
+    uint64_t skippedDuplicate = 0;
+    uint64_t skippedStale = 0;
+
+    [[nodiscard]] uint64_t skipped() const { return skippedDuplicate + skippedStale; }
+  };
+
+  /**
+   * @param timestamp The timestamp global tensor the camera access operator writes, of
+   *                  <code>TensorAttribute_TimeStamp</code>
+   * @param name Name of the gate in the reports and of its global tensors in the bandwidth reports
+   */
+  FrameGate(std::shared_ptr<FrameworkSession> session, std::shared_ptr<GlobalTensor> timestamp, std::string name,
+            FrameGateOptions options = {});
+
+  /**
+   * The condition tensor to pass to <code>Pipeline::submit</code>, valid once the run returned by
+   * <code>evaluate</code> completes
+   */
+  [[nodiscard]] const std::shared_ptr<GlobalTensor>& condition() const { return m_condition; }
+
+  /**
+   * Submit the gate pipeline, after the last run of <code>markProcessed</code>
+   * @return The run writing the condition, for the gated submission to wait for
+   */
+  XrSecureMrPipelineRunPICO evaluate();
+
+  /**
+   * Record the frame of a gated submission as processed, if the condition held, and let the next evaluation wait for
+   * it. Needed after a gated submission done without <code>submit</code>.
+   */
+  XrSecureMrPipelineRunPICO markProcessed(XrSecureMrPipelineRunPICO consumerRun);
+
+  /**
+   * Evaluate the gate, submit the pipeline under its condition, and mark its frame as processed
+   * @return The run of the gated pipeline
+   */
+  XrSecureMrPipelineRunPICO submit(
+      Pipeline& pipeline, const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap);
+
+  /**
+   * Announce a submission of the pipeline writing the timestamp, for the estimated skips
+   */
+  void noteFrame();
+
+  void setBudget(std::chrono::nanoseconds budget);
+  [[nodiscard]] std::chrono::nanoseconds budget() const;
+
+  [[nodiscard]] Stats stats() const;
+  /**
+   * One-line summary of the evaluations and the estimated skips
+   */
+  [[nodiscard]] std::string report() const;
+
+ private:
+  void createGatePipeline();
+  void createMarkPipeline();
+  [[nodiscard]] std::string reportLocked() const;
+
+  std::shared_ptr<FrameworkSession> m_session;
+  std::shared_ptr<GlobalTensor> m_timestamp;
+  std::string m_name;
+  FrameGateOptions m_options;
+
+  std::shared_ptr<GlobalTensor> m_condition;
+  std::shared_ptr<GlobalTensor> m_candidate;
+  std::shared_ptr<GlobalTensor> m_lastProcessed;
+  std::unique_ptr<ParametricPipeline> m_gate;
+  std::shared_ptr<Pipeline> m_mark;
+  std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>> m_markArguments;
+
+  mutable std::mutex m_mutex;
+  Stats m_stats;
+  std::optional<Clock::time_point> m_lastFrame;
+  bool m_frameProcessed = false;
+  XrSecureMrPipelineRunPICO m_lastMark = XR_NULL_HANDLE;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_FRAMEGATE_H_
@@ -0,0 +1,81 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gatedpipeline.h"
+
+#include <utility>
+
+namespace SecureMR {
+
+GatedPipeline::GatedPipeline(std::shared_ptr<Pipeline> pipeline,
+                             std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>> arguments,
+                             std::shared_ptr<GlobalTensor> condition, std::string name, GatedPipelineOptions options)
+    : m_pipeline(std::move(pipeline)),
+      m_arguments(std::move(arguments)),
+      m_condition(std::move(condition)),
+      m_name(std::move(name)),
+      m_options(options) {
+  CHECK_MSG(m_pipeline != nullptr, "GatedPipeline: null pipeline")
+}
+
+void GatedPipeline::noteUpdate(const XrSecureMrPipelineRunPICO run) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  ++m_stats.updates;
+  m_updated = true;
+  m_lastUpdate = run;
+}
+
+XrSecureMrPipelineRunPICO GatedPipeline::submit(XrSecureMrPipelineRunPICO waitFor) {
+  std::string text;
+  bool coalesced = false;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    ++m_stats.calls;
+    if (m_options.coalesceUnchanged && !m_updated) {
+      ++m_stats.coalesced;
+      coalesced = true;
+    } else {
+      ++m_stats.submitted;
+      m_updated = false;
+      if (waitFor == XR_NULL_HANDLE) waitFor = m_lastUpdate;
+      m_lastUpdate = XR_NULL_HANDLE;
+    }
+    if (m_options.reportEvery > 0 && m_stats.calls % m_options.reportEvery == 0) text = reportLocked();
+  }
+  if (!text.empty()) Log::Write(Log::Level::Info, text);
+  if (coalesced) return XR_NULL_HANDLE;
+  return m_pipeline->submit(m_arguments, waitFor, m_condition);
+}
+
+GatedPipeline::Stats GatedPipeline::stats() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_stats;
+}
+
+std::string GatedPipeline::report() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return reportLocked();
+}
+
+std::string GatedPipeline::reportLocked() const {
+  const double coalescedPercent =
+      m_stats.calls == 0 ? 0.0 : 100.0 * static_cast<double>(m_stats.coalesced) / static_cast<double>(m_stats.calls);
+  return Fmt("Gated pipeline \"%s\": %llu calls, %llu submitted%s, %llu coalesced (%.1f%%), %llu updates",
+             m_name.c_str(), static_cast<unsigned long long>(m_stats.calls),
+             static_cast<unsigned long long>(m_stats.submitted), m_condition != nullptr ? " under condition" : "",
+             static_cast<unsigned long long>(m_stats.coalesced), coalescedPercent,
+             static_cast<unsigned long long>(m_stats.updates));
+}
+
+}  // namespace SecureMR
@@ -0,0 +1,111 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_GATEDPIPELINE_H_
+#define SECUREMR_UTILS_GATEDPIPELINE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+struct GatedPipelineOptions {
+  /**
+   * Skip a submission when no update of the inputs was noted since the previous one, coalescing the consecutive
+   * frames without change into one run
+   */
+  bool coalesceUnchanged = true;
+  /**
+   * Log the report every this many calls to <code>submit</code>, 0 for no periodic report
+   */
+  uint64_t reportEvery = 0;
+};
+
+/**
+ * A pipeline submitted on a timer, e.g., a rendering pipeline, which only does useful work when its inputs show
+ * something and have changed.
+ * <br/>
+ * Each submission is conditioned on a flag global tensor, e.g., the detection flag written by the inference, so the
+ * runtime aborts the run when the flag is all zero and no operator, e.g., a glTF update, runs for an empty scene.
+ * With <code>coalesceUnchanged</code>, the producers of the inputs announce their submissions by
+ * <code>noteUpdate</code>, and a call to <code>submit</code> after none is skipped on the host, without a
+ * submission at all. The next submission waits for the run of the last update noted.
+ * <br/>
+ * <b>Note</b> the runs aborted by the condition are decided by the runtime, and are not visible to the host: the
+ * statistics count the submissions and the coalesced calls.
+ */
+class GatedPipeline {
+ public:
+  struct Stats {
+    uint64_t calls = 0;
+    uint64_t submitted = 0;
+    uint64_t coalesced = 0;
+    uint64_t updates = 0;
+  };
+
+  /**
+   * @param arguments The global tensors bound to the placeholders of the pipeline at every submission
+   * @param condition The flag global tensor, <code>nullptr</code> to only coalesce
+   * @param name Name of the pipeline in the reports
+   */
+  GatedPipeline(std::shared_ptr<Pipeline> pipeline,
+                std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>> arguments,
+                std::shared_ptr<GlobalTensor> condition, std::string name, GatedPipelineOptions options = {});
+
+  [[nodiscard]] const std::shared_ptr<Pipeline>& pipeline() const { return m_pipeline; }
+  [[nodiscard]] const std::shared_ptr<GlobalTensor>& condition() const { return m_condition; }
+
+  /**
+   * Announce a submission of a pipeline writing the inputs
+   * @param run The run of that submission, for the next submission to wait for
+   */
+  void noteUpdate(XrSecureMrPipelineRunPICO run = XR_NULL_HANDLE);
+
+  /**
+   * Submit the pipeline under the condition, unless coalesced
+   * @param waitFor If set, the run to wait for instead of the run of the last update noted
+   * @return The run of the submission, or <code>XR_NULL_HANDLE</code> if coalesced
+   */
+  XrSecureMrPipelineRunPICO submit(XrSecureMrPipelineRunPICO waitFor = XR_NULL_HANDLE);
+
+  [[nodiscard]] Stats stats() const;
+  /**
+   * One-line summary of the calls, submissions and coalesced calls
+   */
+  [[nodiscard]] std::string report() const;
+
+ private:
+  [[nodiscard]] std::string reportLocked() const;
+
+  std::shared_ptr<Pipeline> m_pipeline;
+  std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>> m_arguments;
+  std::shared_ptr<GlobalTensor> m_condition;
+  std::string m_name;
+  GatedPipelineOptions m_options;
+
+  mutable std::mutex m_mutex;
+  Stats m_stats;
+  bool m_updated = true;
+  XrSecureMrPipelineRunPICO m_lastUpdate = XR_NULL_HANDLE;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_GATEDPIPELINE_H_
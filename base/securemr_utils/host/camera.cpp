@@ -0,0 +1,282 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "camera.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "check.h"
+
+namespace SecureMR::Host {
+
+namespace {
+
+constexpr char RAW_SEQUENCE_MAGIC[8] = {'S', 'M', 'R', 'C', 'A', 'M', '0', '1'};
+constexpr size_t RAW_SEQUENCE_HEADER_SIZE = 32;
+constexpr size_t RAW_FRAME_METADATA_SIZE = sizeof(int32_t) * 4 + sizeof(float) * 9;
+
+void FillTimestamp(CameraFrame& frame, const uint64_t nanoseconds, const uint64_t index) {
+  frame.timestamp[0] = static_cast<int32_t>(nanoseconds >> 32);
+  frame.timestamp[1] = static_cast<int32_t>(nanoseconds & 0xffffffffu);
+  frame.timestamp[2] = static_cast<int32_t>(index);
+  frame.timestamp[3] = 0;
+}
+
+/**
+ * Hash-based texture, so that every block of the image is distinct, as block matching and detectors expect
+ */
+inline uint8_t Texture(const uint32_t x, const uint32_t y) {
+  uint32_t h = (x >> 2) * 73856093u ^ (y >> 2) * 19349663u;
+  h ^= h >> 13;
+  h *= 0x5bd1e995u;
+  return static_cast<uint8_t>(h >> 24);
+}
+
+}  // namespace
+
+ProceduralCameraSource::ProceduralCameraSource(const size_t width, const size_t height,
+                                               const std::chrono::nanoseconds frameInterval, const int disparity,
+                                               ThreadPool& pool)
+    : m_width(width), m_height(height), m_frameInterval(frameInterval), m_disparity(disparity), m_pool(pool) {
+  CHECK_MSG(width > 0 && height > 0, "ProceduralCameraSource: empty image size")
+}
+
+void ProceduralCameraSource::produce(const uint64_t index, CameraFrame& frame, uint8_t* leftBuffer,
+                                     uint8_t* rightBuffer) {
+  // The texture scrolls by 4 pixels per frame; the right eye sees column x + disparity of the left-eye texture
+  const auto scroll = static_cast<uint32_t>(index * 4);
+  const int shift = std::min(m_disparity, 0);
+  const size_t rowLength = m_width + static_cast<size_t>(std::abs(m_disparity));
+  m_pool.parallelFor(0, m_height, 16, [&](const size_t rowBegin, const size_t rowEnd) {
+    // Both eyes read the same texture row, at offsets 0 and disparity
+    std::vector<uint8_t> texture(rowLength);
+    for (size_t y = rowBegin; y < rowEnd; ++y) {
+      for (size_t k = 0; k < rowLength; ++k) {
+        const auto column = static_cast<uint32_t>(static_cast<int64_t>(k) + shift) + scroll;
+        texture[k] = Texture(column, static_cast<uint32_t>(y));
+      }
+      const uint8_t* leftTexture = texture.data() - shift;
+      const uint8_t* rightTexture = leftTexture + m_disparity;
+      uint8_t* left = leftBuffer + y * m_width * 3;
+      uint8_t* right = rightBuffer + y * m_width * 3;
+      for (size_t x = 0; x < m_width; ++x) {
+        const uint8_t l = leftTexture[x], r = rightTexture[x];
+        left[3 * x] = l, left[3 * x + 1] = l ^ 0x55, left[3 * x + 2] = 255 - l;
+        right[3 * x] = r, right[3 * x + 1] = r ^ 0x55, right[3 * x + 2] = 255 - r;
+      }
+    }
+  });
+
+  FillTimestamp(frame, static_cast<uint64_t>(m_frameInterval.count()) * index, index);
+  const float focal = static_cast<float>(m_width) / 2.0f;
+  const float matrix[9] = {focal, 0.0f, static_cast<float>(m_width) / 2.0f, 0.0f, focal,
+                           static_cast<float>(m_height) / 2.0f, 0.0f, 0.0f, 1.0f};
+  std::copy(matrix, matrix + 9, frame.cameraMatrix);
+}
+
+RawSequenceCameraSource::RawSequenceCameraSource(const std::filesystem::path& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  CHECK_MSG(fd >= 0, Fmt("RawSequenceCameraSource: cannot open \"%s\"", path.c_str()))
+  struct stat status {};
+  if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < RAW_SEQUENCE_HEADER_SIZE) {
+    close(fd);
+    THROW(Fmt("RawSequenceCameraSource: \"%s\" is not a raw sequence", path.c_str()))
+  }
+  m_mappingSize = static_cast<size_t>(status.st_size);
+  void* mapping = mmap(nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // the mapping keeps the file referenced
+  CHECK_MSG(mapping != MAP_FAILED, Fmt("RawSequenceCameraSource: cannot map \"%s\"", path.c_str()))
+  m_mapping = static_cast<const uint8_t*>(mapping);
+  madvise(mapping, m_mappingSize, MADV_SEQUENTIAL);
+
+  uint64_t header[3];
+  std::memcpy(header, m_mapping + sizeof(RAW_SEQUENCE_MAGIC), sizeof(header));
+  m_width = header[0];
+  m_height = header[1];
+  m_frameCount = header[2];
+  // The header is untrusted: bound the sizes by division so that a corrupt one cannot overflow the frame size
+  const bool sized = m_width > 0 && m_height > 0 &&
+                     m_width <= (std::numeric_limits<size_t>::max() - RAW_FRAME_METADATA_SIZE) / 6 / m_height;
+  const size_t frameSize = sized ? RAW_FRAME_METADATA_SIZE + m_width * m_height * 6 : 0;
+  if (std::memcmp(m_mapping, RAW_SEQUENCE_MAGIC, sizeof(RAW_SEQUENCE_MAGIC)) != 0 || !sized ||
+      m_frameCount > (m_mappingSize - RAW_SEQUENCE_HEADER_SIZE) / frameSize) {
+    munmap(mapping, m_mappingSize);
+    THROW(Fmt("RawSequenceCameraSource: \"%s\" is not a raw sequence or is truncated", path.c_str()))
+  }
+}
+
+RawSequenceCameraSource::~RawSequenceCameraSource() {
+  munmap(const_cast<uint8_t*>(m_mapping), m_mappingSize);
+}
+
+void RawSequenceCameraSource::Write(const std::filesystem::path& path, CameraSource& source,
+                                    const uint64_t frameCount) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  CHECK_MSG(file.is_open(), Fmt("RawSequenceCameraSource: cannot create \"%s\"", path.c_str()))
+  const uint64_t header[3] = {source.width(), source.height(), frameCount};
+  file.write(RAW_SEQUENCE_MAGIC, sizeof(RAW_SEQUENCE_MAGIC));
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  const size_t imageSize = source.width() * source.height() * 3;
+  std::vector<uint8_t> left(imageSize), right(imageSize);
+  for (uint64_t index = 0; index < frameCount; ++index) {
+    CameraFrame frame{.index = index, .width = source.width(), .height = source.height()};
+    frame.leftEye = left.data();
+    frame.rightEye = right.data();
+    source.produce(source.frameCount() > 0 ? index % source.frameCount() : index, frame, left.data(), right.data());
+    file.write(reinterpret_cast<const char*>(frame.timestamp), sizeof(frame.timestamp));
+    file.write(reinterpret_cast<const char*>(frame.cameraMatrix), sizeof(frame.cameraMatrix));
+    file.write(reinterpret_cast<const char*>(frame.leftEye), static_cast<std::streamsize>(imageSize));
+    file.write(reinterpret_cast<const char*>(frame.rightEye), static_cast<std::streamsize>(imageSize));
+  }
+  CHECK_MSG(file.good(), Fmt("RawSequenceCameraSource: failed to write \"%s\"", path.c_str()))
+}
+
+void RawSequenceCameraSource::produce(const uint64_t index, CameraFrame& frame, uint8_t* /*leftBuffer*/,
+                                      uint8_t* /*rightBuffer*/) {
+  CHECK_MSG(index < m_frameCount, "RawSequenceCameraSource: frame index out of range")
+  const size_t imageSize = m_width * m_height * 3;
+  const size_t frameSize = RAW_FRAME_METADATA_SIZE + 2 * imageSize;
+  const uint8_t* record = m_mapping + RAW_SEQUENCE_HEADER_SIZE + frameSize * index;
+
+  // Page the images in from the prefetch thread rather than on first access by the pipeline
+  const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto pageStart = reinterpret_cast<uintptr_t>(record) & ~(pageSize - 1);
+  madvise(reinterpret_cast<void*>(pageStart), reinterpret_cast<uintptr_t>(record) + frameSize - pageStart,
+          MADV_WILLNEED);
+
+  std::memcpy(frame.timestamp, record, sizeof(frame.timestamp));
+  std::memcpy(frame.cameraMatrix, record + sizeof(frame.timestamp), sizeof(frame.cameraMatrix));
+  frame.leftEye = record + RAW_FRAME_METADATA_SIZE;
+  frame.rightEye = frame.leftEye + imageSize;
+}
+
+CameraProvider::CameraProvider(std::unique_ptr<CameraSource> source, const CameraProviderConfig& config)
+    : m_source(std::move(source)), m_config(config) {
+  CHECK_MSG(m_source != nullptr, "CameraProvider: null camera source")
+  CHECK_MSG(m_config.frameRate >= 0.0, "CameraProvider: negative frame rate")
+  m_slots.resize(std::max<size_t>(m_config.prefetchDepth, 1));
+  // Sources handing out their own storage, e.g., a memory mapping, need no copy
+  const size_t imageSize = m_source->copiesFrames() ? m_source->width() * m_source->height() * 3 : 0;
+  for (auto& slot : m_slots) {
+    slot.leftBuffer.resize(imageSize);
+    slot.rightBuffer.resize(imageSize);
+  }
+  m_prefetchThread = std::thread([this]() { prefetchLoop(); });
+}
+
+CameraProvider::~CameraProvider() {
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_stopping = true;
+  }
+  m_slotFree.notify_all();
+  m_frameReady.notify_all();
+  if (m_prefetchThread.joinable()) m_prefetchThread.join();
+}
+
+void CameraProvider::prefetchLoop() {
+  const uint64_t sequenceLength = m_source->frameCount();
+  while (true) {
+    uint64_t index;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_slotFree.wait(lock, [this]() { return m_stopping || m_produced - m_consumed < m_slots.size(); });
+      if (m_stopping) return;
+      index = m_produced;
+      if (sequenceLength > 0 && index >= sequenceLength && !m_config.loop) {
+        m_ended = true;
+        m_frameReady.notify_all();
+        return;
+      }
+    }
+
+    // The slot is neither held by the consumer nor readable until m_produced moves past it
+    Slot& slot = m_slots[index % m_slots.size()];
+    slot.frame = CameraFrame{.index = index, .width = m_source->width(), .height = m_source->height()};
+    uint8_t* leftBuffer = slot.leftBuffer.empty() ? nullptr : slot.leftBuffer.data();
+    uint8_t* rightBuffer = slot.rightBuffer.empty() ? nullptr : slot.rightBuffer.data();
+    slot.frame.leftEye = leftBuffer;
+    slot.frame.rightEye = rightBuffer;
+    m_source->produce(sequenceLength > 0 ? index % sequenceLength : index, slot.frame, leftBuffer, rightBuffer);
+    if (sequenceLength > 0) offsetReplay(slot.frame, index, sequenceLength);
+    slot.frame.index = index;
+
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      ++m_produced;
+    }
+    m_frameReady.notify_all();
+  }
+}
+
+void CameraProvider::offsetReplay(CameraFrame& frame, const uint64_t index, const uint64_t sequenceLength) {
+  const uint64_t nanoseconds = (static_cast<uint64_t>(static_cast<uint32_t>(frame.timestamp[0])) << 32) |
+                               static_cast<uint32_t>(frame.timestamp[1]);
+  if (index < sequenceLength) {
+    if (index == 0) m_sequenceStart = nanoseconds;
+    if (index == sequenceLength - 1) m_sequenceEnd = nanoseconds;
+    return;
+  }
+
+  // A replay starts one mean frame interval after the previous one ended
+  const uint64_t covered = m_sequenceEnd > m_sequenceStart ? m_sequenceEnd - m_sequenceStart : 0;
+  const uint64_t interval = sequenceLength > 1 ? covered / (sequenceLength - 1) : 0;
+  const uint64_t duration = std::max<uint64_t>(covered + interval, 1);
+  FillTimestamp(frame, nanoseconds + index / sequenceLength * duration, index);
+}
+
+bool CameraProvider::acquire(CameraFrame& frame) {
+  using Clock = std::chrono::steady_clock;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_holding) {
+    ++m_consumed;
+    m_holding = false;
+    m_slotFree.notify_all();
+  }
+  if (m_stats.framesDelivered == 0) m_start = Clock::now();
+  const auto due =
+      m_config.frameRate > 0.0
+          ? m_start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(
+                          static_cast<double>(m_stats.framesDelivered) / m_config.frameRate))
+          : Clock::now();
+
+  const bool readyOnEntry = m_produced > m_consumed;
+  m_frameReady.wait(lock, [this]() { return m_produced > m_consumed || m_ended || m_stopping; });
+  if (m_produced <= m_consumed) return false;
+  if (!readyOnEntry && Clock::now() > due) ++m_stats.framesLate;
+
+  m_holding = true;
+  ++m_stats.framesDelivered;
+  frame = m_slots[m_consumed % m_slots.size()].frame;
+  lock.unlock();
+  std::this_thread::sleep_until(due);
+  return true;
+}
+
+CameraProviderStats CameraProvider::stats() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_stats;
+}
+
+}  // namespace SecureMR::Host
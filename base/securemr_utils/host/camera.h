@@ -0,0 +1,226 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_CAMERA_H_
+#define SECUREMR_UTILS_HOST_CAMERA_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * The results of one <code>Pipeline::cameraAccess</code>: both eyes as interleaved RGB uint8 images of the
+ * framework session's size, the 4-channel INT32 timestamp and the row-major 3x3 camera matrix.
+ * <br/>
+ * Host sources fill the timestamp as <code>{nanoseconds >> 32, nanoseconds & 0xffffffff, frame index, 0}</code>.
+ */
+struct CameraFrame {
+  uint64_t index = 0;
+  size_t width = 0;
+  size_t height = 0;
+  const uint8_t* leftEye = nullptr;
+  const uint8_t* rightEye = nullptr;
+  int32_t timestamp[4] = {};
+  float cameraMatrix[9] = {};
+};
+
+/**
+ * Produces the frames of a host camera by index, for <code>CameraProvider</code>
+ */
+class CameraSource {
+ public:
+  virtual ~CameraSource() = default;
+
+  [[nodiscard]] virtual size_t width() const = 0;
+  [[nodiscard]] virtual size_t height() const = 0;
+  /**
+   * @return Number of frames of a finite sequence, or 0 if the source is unbounded
+   */
+  [[nodiscard]] virtual uint64_t frameCount() const = 0;
+
+  /**
+   * Write frame <code>index</code> to <code>frame</code>, whose eye images point to buffers of
+   * <code>width() * height() * 3</code> bytes owned by the caller. Sources holding the images in memory may instead
+   * redirect <code>leftEye</code> and <code>rightEye</code> to their own storage, which must stay valid as long as the
+   * source does. Called from the prefetch thread.
+   * <br/>
+   * The buffers are null for sources which do not <code>copiesFrames()</code>.
+   */
+  virtual void produce(uint64_t index, CameraFrame& frame, uint8_t* leftBuffer, uint8_t* rightBuffer) = 0;
+
+  /**
+   * @return whether <code>produce</code> writes the images to the caller's buffers, so that the caller has to
+   * allocate them
+   */
+  [[nodiscard]] virtual bool copiesFrames() const { return true; }
+};
+
+/**
+ * An unbounded synthetic stereo camera: a moving texture, seen by the right eye with a constant disparity, and
+ * pinhole intrinsics with the focal length equal to half the width.
+ */
+class ProceduralCameraSource : public CameraSource {
+ public:
+  /**
+   * @param frameInterval Time between two timestamps
+   * @param disparity Horizontal shift of the right eye image, in pixels
+   */
+  ProceduralCameraSource(size_t width, size_t height,
+                         std::chrono::nanoseconds frameInterval = std::chrono::nanoseconds(33'333'333),
+                         int disparity = 16, ThreadPool& pool = ThreadPool::Default());
+
+  [[nodiscard]] size_t width() const override { return m_width; }
+  [[nodiscard]] size_t height() const override { return m_height; }
+  [[nodiscard]] uint64_t frameCount() const override { return 0; }
+
+  void produce(uint64_t index, CameraFrame& frame, uint8_t* leftBuffer, uint8_t* rightBuffer) override;
+
+ private:
+  size_t m_width;
+  size_t m_height;
+  std::chrono::nanoseconds m_frameInterval;
+  int m_disparity;
+  ThreadPool& m_pool;
+};
+
+/**
+ * A recorded stereo sequence read from a memory-mapped raw file, so that frames are paged in on demand and never
+ * copied: the frames handed out point into the mapping.
+ * <br/>
+ * Layout: a 32-byte header <code>{char[8] "SMRCAM01", uint64 width, uint64 height, uint64 frameCount}</code>,
+ * followed by per frame <code>{int32 timestamp[4], float cameraMatrix[9], uint8 left[h][w][3],
+ * uint8 right[h][w][3]}</code>, all little-endian.
+ */
+class RawSequenceCameraSource : public CameraSource {
+ public:
+  explicit RawSequenceCameraSource(const std::filesystem::path& path);
+  ~RawSequenceCameraSource() override;
+
+  RawSequenceCameraSource(const RawSequenceCameraSource&) = delete;
+  RawSequenceCameraSource& operator=(const RawSequenceCameraSource&) = delete;
+
+  /**
+   * Record <code>frameCount</code> frames of another source, e.g., of a <code>ProceduralCameraSource</code>
+   */
+  static void Write(const std::filesystem::path& path, CameraSource& source, uint64_t frameCount);
+
+  [[nodiscard]] size_t width() const override { return m_width; }
+  [[nodiscard]] size_t height() const override { return m_height; }
+  [[nodiscard]] uint64_t frameCount() const override { return m_frameCount; }
+  [[nodiscard]] bool copiesFrames() const override { return false; }
+
+  void produce(uint64_t index, CameraFrame& frame, uint8_t* leftBuffer, uint8_t* rightBuffer) override;
+
+ private:
+  const uint8_t* m_mapping = nullptr;
+  size_t m_mappingSize = 0;
+  size_t m_width = 0;
+  size_t m_height = 0;
+  uint64_t m_frameCount = 0;
+};
+
+struct CameraProviderConfig {
+  /**
+   * Frames per second delivered by <code>acquire</code>; 0 delivers them as fast as they are produced
+   */
+  double frameRate = 30.0;
+  /**
+   * Number of frames produced ahead of the consumer
+   */
+  size_t prefetchDepth = 3;
+  /**
+   * Restart a finite sequence from its first frame instead of ending. The timestamps of each replay are shifted
+   * past those of the previous one, so that consumers checking for new frames never see a timestamp twice.
+   */
+  bool loop = true;
+};
+
+struct CameraProviderStats {
+  uint64_t framesDelivered = 0;
+  /**
+   * Frames not ready by their due time, i.e., the source could not keep up with the frame rate
+   */
+  uint64_t framesLate = 0;
+};
+
+/**
+ * Streams the frames of a <code>CameraSource</code> to the host runtime, standing in for
+ * <code>Pipeline::cameraAccess</code>. A background thread fills a ring of <code>prefetchDepth</code> frames while
+ * the consumer paces itself at the configured frame rate.
+ */
+class CameraProvider {
+ public:
+  explicit CameraProvider(std::unique_ptr<CameraSource> source, const CameraProviderConfig& config = {});
+  ~CameraProvider();
+
+  CameraProvider(const CameraProvider&) = delete;
+  CameraProvider& operator=(const CameraProvider&) = delete;
+
+  /**
+   * Block until the next frame is prefetched and due. The frame stays valid until the next call.
+   * @return false once a non-looping sequence has ended
+   */
+  bool acquire(CameraFrame& frame);
+
+  [[nodiscard]] CameraProviderStats stats() const;
+
+  [[nodiscard]] const CameraSource& source() const { return *m_source; }
+
+ private:
+  struct Slot {
+    CameraFrame frame;
+    std::vector<uint8_t> leftBuffer;
+    std::vector<uint8_t> rightBuffer;
+  };
+
+  void prefetchLoop();
+
+  /**
+   * Shift the timestamp of a frame replayed by a looping sequence by the duration of the earlier replays
+   */
+  void offsetReplay(CameraFrame& frame, uint64_t index, uint64_t sequenceLength);
+
+  std::unique_ptr<CameraSource> m_source;
+  CameraProviderConfig m_config;
+  std::vector<Slot> m_slots;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_frameReady;
+  std::condition_variable m_slotFree;
+  uint64_t m_produced = 0;
+  uint64_t m_consumed = 0;
+  bool m_holding = false;
+  bool m_ended = false;
+  bool m_stopping = false;
+  CameraProviderStats m_stats;
+  std::chrono::steady_clock::time_point m_start;
+  // Timestamps of the first and the last frame of a finite sequence, recorded by the prefetch thread
+  uint64_t m_sequenceStart = 0;
+  uint64_t m_sequenceEnd = 0;
+  std::thread m_prefetchThread;
+};
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_CAMERA_H_
@@ -0,0 +1,543 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "expression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+
+#include "check.h"
+#include "simd.h"
+
+namespace SecureMR::Host {
+
+namespace {
+
+// Elements per register; a multiple of the vector width so that the arithmetic loops need no tail handling
+constexpr size_t BLOCK_SIZE = 256;
+constexpr size_t MAX_RANK = 8;
+
+struct Node {
+  enum class Kind { OPERAND, CONSTANT, ADD, SUBTRACT, MULTIPLY, DIVIDE, NEGATE };
+  Kind kind;
+  double value = 0.0;
+  size_t operand = 0;
+  size_t lhs = 0;
+  size_t rhs = 0;
+};
+
+/**
+ * Recursive-descent parser producing an expression tree, with constant sub-expressions folded on the fly
+ */
+class Parser {
+ public:
+  explicit Parser(const std::string& expression) : m_text(expression) {}
+
+  size_t parse() {
+    const size_t root = parseSum();
+    skipSpaces();
+    if (m_pos != m_text.size()) fail("unexpected character");
+    return root;
+  }
+
+  std::vector<Node> nodes;
+  size_t operandCount = 0;
+
+ private:
+  [[noreturn]] void fail(const char* what) const {
+    THROW(Fmt("Invalid arithmetic expression \"%s\": %s at position %zu", m_text.c_str(), what, m_pos))
+  }
+
+  void skipSpaces() {
+    while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+  }
+
+  bool consume(const char c) {
+    skipSpaces();
+    if (m_pos < m_text.size() && m_text[m_pos] == c) {
+      ++m_pos;
+      return true;
+    }
+    return false;
+  }
+
+  size_t add(const Node& node) {
+    nodes.push_back(node);
+    return nodes.size() - 1;
+  }
+
+  size_t makeBinary(const Node::Kind kind, const size_t lhs, const size_t rhs) {
+    if (nodes[lhs].kind == Node::Kind::CONSTANT && nodes[rhs].kind == Node::Kind::CONSTANT) {
+      const double a = nodes[lhs].value, b = nodes[rhs].value;
+      const double folded = kind == Node::Kind::ADD        ? a + b
+                            : kind == Node::Kind::SUBTRACT ? a - b
+                            : kind == Node::Kind::MULTIPLY ? a * b
+                                                           : a / b;
+      return add({.kind = Node::Kind::CONSTANT, .value = folded});
+    }
+    return add({.kind = kind, .lhs = lhs, .rhs = rhs});
+  }
+
+  size_t parseSum() {
+    size_t result = parseProduct();
+    while (true) {
+      if (consume('+')) {
+        result = makeBinary(Node::Kind::ADD, result, parseProduct());
+      } else if (consume('-')) {
+        result = makeBinary(Node::Kind::SUBTRACT, result, parseProduct());
+      } else {
+        return result;
+      }
+    }
+  }
+
+  size_t parseProduct() {
+    size_t result = parseFactor();
+    while (true) {
+      if (consume('*')) {
+        result = makeBinary(Node::Kind::MULTIPLY, result, parseFactor());
+      } else if (consume('/')) {
+        result = makeBinary(Node::Kind::DIVIDE, result, parseFactor());
+      } else {
+        return result;
+      }
+    }
+  }
+
+  size_t parseFactor() {
+    if (consume('-')) {
+      const size_t operand = parseFactor();
+      if (nodes[operand].kind == Node::Kind::CONSTANT) {
+        return add({.kind = Node::Kind::CONSTANT, .value = -nodes[operand].value});
+      }
+      return add({.kind = Node::Kind::NEGATE, .lhs = operand});
+    }
+    if (consume('+')) return parseFactor();
+    if (consume('(')) {
+      const size_t inner = parseSum();
+      if (!consume(')')) fail("missing ')'");
+      return inner;
+    }
+    if (consume('{')) {
+      skipSpaces();
+      size_t index = 0;
+      const size_t digitsBegin = m_pos;
+      while (m_pos < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[m_pos]))) {
+        index = index * 10 + static_cast<size_t>(m_text[m_pos++] - '0');
+      }
+      if (m_pos == digitsBegin) fail("operand index expected");
+      if (!consume('}')) fail("missing '}'");
+      operandCount = std::max(operandCount, index + 1);
+      return add({.kind = Node::Kind::OPERAND, .operand = index});
+    }
+    skipSpaces();
+    const char* begin = m_text.c_str() + m_pos;
+    char* end = nullptr;
+    const double value = std::strtod(begin, &end);
+    if (end == begin) fail("operand, number or '(' expected");
+    m_pos += static_cast<size_t>(end - begin);
+    return add({.kind = Node::Kind::CONSTANT, .value = value});
+  }
+
+  const std::string& m_text;
+  size_t m_pos = 0;
+};
+
+/**
+ * Emits bytecode for an expression tree. Each operand is loaded into a register of its own once per block and kept
+ * for the whole program; temporaries are recycled through a free list as soon as their value has been consumed.
+ */
+class CodeGenerator {
+ public:
+  explicit CodeGenerator(const std::vector<Node>& nodes) : m_nodes(nodes) {}
+
+  uint16_t emit(const size_t nodeIndex) {
+    const Node& node = m_nodes[nodeIndex];
+    switch (node.kind) {
+      case Node::Kind::OPERAND: {
+        const auto cached = m_operandRegisters.find(node.operand);
+        if (cached != m_operandRegisters.end()) return cached->second;
+        const uint16_t reg = allocate();
+        code.push_back({ExpressionProgram::OpCode::LOAD_OPERAND, reg, static_cast<uint16_t>(node.operand), 0});
+        m_operandRegisters.emplace(node.operand, reg);
+        return reg;
+      }
+      case Node::Kind::CONSTANT: {
+        const uint16_t reg = allocate();
+        code.push_back({ExpressionProgram::OpCode::LOAD_CONSTANT, reg, static_cast<uint16_t>(constants.size()), 0});
+        constants.push_back(node.value);
+        return reg;
+      }
+      case Node::Kind::NEGATE: {
+        const uint16_t src = emit(node.lhs);
+        const uint16_t dst = isTemporary(src) ? src : allocate();
+        code.push_back({ExpressionProgram::OpCode::NEGATE, dst, src, src});
+        return dst;
+      }
+      default: {
+        const uint16_t lhs = emit(node.lhs);
+        const uint16_t rhs = emit(node.rhs);
+        const uint16_t dst = isTemporary(lhs) ? lhs : isTemporary(rhs) ? rhs : allocate();
+        if (isTemporary(lhs) && lhs != dst) release(lhs);
+        if (isTemporary(rhs) && rhs != dst) release(rhs);
+        code.push_back({OpCodeOf(node.kind), dst, lhs, rhs});
+        return dst;
+      }
+    }
+  }
+
+  std::vector<ExpressionProgram::Instruction> code;
+  std::vector<double> constants;
+  size_t registerCount = 0;
+
+ private:
+  static ExpressionProgram::OpCode OpCodeOf(const Node::Kind kind) {
+    switch (kind) {
+      case Node::Kind::ADD:
+        return ExpressionProgram::OpCode::ADD;
+      case Node::Kind::SUBTRACT:
+        return ExpressionProgram::OpCode::SUBTRACT;
+      case Node::Kind::MULTIPLY:
+        return ExpressionProgram::OpCode::MULTIPLY;
+      default:
+        return ExpressionProgram::OpCode::DIVIDE;
+    }
+  }
+
+  bool isTemporary(const uint16_t reg) const {
+    return std::none_of(m_operandRegisters.begin(), m_operandRegisters.end(),
+                        [reg](const auto& entry) { return entry.second == reg; });
+  }
+
+  uint16_t allocate() {
+    if (!m_free.empty()) {
+      const uint16_t reg = m_free.back();
+      m_free.pop_back();
+      return reg;
+    }
+    CHECK_MSG(registerCount < std::numeric_limits<uint16_t>::max(), "Arithmetic expression too large")
+    return static_cast<uint16_t>(registerCount++);
+  }
+
+  void release(const uint16_t reg) { m_free.push_back(reg); }
+
+  const std::vector<Node>& m_nodes;
+  std::unordered_map<size_t, uint16_t> m_operandRegisters;
+  std::vector<uint16_t> m_free;
+};
+
+/**
+ * How an operand maps onto the flat index of the result
+ */
+struct OperandAccess {
+  enum class Mode { CONTIGUOUS, SCALAR, BROADCAST };
+  Mode mode = Mode::CONTIGUOUS;
+  const void* data = nullptr;
+  XrSecureMrTensorDataTypePICO dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO;
+  // BROADCAST only: per result axis, the operand's element stride (0 along broadcast axes)
+  size_t strides[MAX_RANK] = {};
+};
+
+OperandAccess MakeOperandAccess(const ConstTensorView& operand, const std::vector<size_t>& resultShape) {
+  OperandAccess access{.data = operand.data, .dataType = operand.dataType};
+  CHECK_MSG(operand.shape.size() <= resultShape.size(), "Arithmetic operand has more axes than the result")
+  const size_t offset = resultShape.size() - operand.shape.size();
+  size_t stride = 1;
+  for (size_t axis = resultShape.size(); axis-- > 0;) {
+    const size_t dim = axis < offset ? 1 : operand.shape[axis - offset];
+    CHECK_MSG(dim == resultShape[axis] || dim == 1, "Arithmetic operand cannot be broadcast to the result shape")
+    access.strides[axis] = dim == 1 ? 0 : stride;
+    stride *= dim;
+  }
+  const size_t elements = operand.elementCount();
+  size_t resultElements = 1;
+  for (const size_t dim : resultShape) resultElements *= dim;
+  access.mode = elements == 1                ? OperandAccess::Mode::SCALAR
+                : elements == resultElements ? OperandAccess::Mode::CONTIGUOUS
+                                             : OperandAccess::Mode::BROADCAST;
+  return access;
+}
+
+template <typename Compute, typename Visitor>
+void WithDataType(const XrSecureMrTensorDataTypePICO dataType, Visitor&& visitor) {
+  switch (dataType) {
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+      return visitor(uint8_t{});
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+      return visitor(int8_t{});
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+      return visitor(uint16_t{});
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
+      return visitor(int16_t{});
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+      return visitor(int32_t{});
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
+      return visitor(float{});
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO:
+      return visitor(double{});
+    default:
+      THROW("Arithmetic: unsupported tensor data type")
+  }
+}
+
+template <typename Compute>
+void LoadBlock(const OperandAccess& access, const std::vector<size_t>& shape, const size_t begin, const size_t count,
+               Compute* reg) {
+  WithDataType<Compute>(access.dataType, [&](auto tag) {
+    using T = decltype(tag);
+    const T* src = static_cast<const T*>(access.data);
+    switch (access.mode) {
+      case OperandAccess::Mode::CONTIGUOUS:
+        for (size_t i = 0; i < count; ++i) reg[i] = static_cast<Compute>(src[begin + i]);
+        break;
+      case OperandAccess::Mode::SCALAR:
+        std::fill(reg, reg + count, static_cast<Compute>(src[0]));
+        break;
+      case OperandAccess::Mode::BROADCAST: {
+        // Odometer over the result axes, starting from the block's first element
+        const size_t rank = shape.size();
+        size_t index[MAX_RANK];
+        size_t remainder = begin;
+        size_t offset = 0;
+        for (size_t axis = rank; axis-- > 0;) {
+          index[axis] = remainder % shape[axis];
+          remainder /= shape[axis];
+          offset += index[axis] * access.strides[axis];
+        }
+        for (size_t i = 0; i < count; ++i) {
+          reg[i] = static_cast<Compute>(src[offset]);
+          for (size_t axis = rank; axis-- > 0;) {
+            offset += access.strides[axis];
+            if (++index[axis] < shape[axis]) break;
+            offset -= index[axis] * access.strides[axis];
+            index[axis] = 0;
+          }
+        }
+        break;
+      }
+    }
+  });
+}
+
+template <typename Compute>
+void StoreBlock(const TensorView& result, const size_t begin, const size_t count, const Compute* reg) {
+  WithDataType<Compute>(result.dataType, [&](auto tag) {
+    using T = decltype(tag);
+    T* dst = static_cast<T*>(result.data) + begin;
+    if constexpr (std::is_floating_point_v<T>) {
+      for (size_t i = 0; i < count; ++i) dst[i] = static_cast<T>(reg[i]);
+    } else {
+      constexpr auto lowest = static_cast<Compute>(std::numeric_limits<T>::lowest());
+      constexpr auto highest = static_cast<Compute>(std::numeric_limits<T>::max());
+      for (size_t i = 0; i < count; ++i) {
+        const Compute value = std::isnan(reg[i]) ? Compute{0} : std::clamp(std::nearbyint(reg[i]), lowest, highest);
+        dst[i] = static_cast<T>(value);
+      }
+    }
+  });
+}
+
+template <typename Compute, typename VectorOp, typename ScalarOp>
+void ApplyBinary(Compute* dst, const Compute* lhs, const Compute* rhs, VectorOp&& vectorOp, ScalarOp&& scalarOp) {
+  if constexpr (std::is_same_v<Compute, float>) {
+    for (size_t i = 0; i < BLOCK_SIZE; i += 4) {
+      vectorOp(Float4::Load(lhs + i), Float4::Load(rhs + i)).store(dst + i);
+    }
+  } else {
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) dst[i] = scalarOp(lhs[i], rhs[i]);
+  }
+}
+
+template <typename Compute>
+void RunProgram(const std::vector<ExpressionProgram::Instruction>& code, const std::vector<double>& constants,
+                const std::vector<OperandAccess>& operands, const TensorView& result, const size_t registerCount,
+                const uint16_t resultRegister, const size_t begin, const size_t end) {
+  // Zero-initialized so that the lanes past a short last block hold defined values
+  std::vector<Compute> registers(registerCount * BLOCK_SIZE, Compute{0});
+  const auto reg = [&](const uint16_t index) { return registers.data() + index * BLOCK_SIZE; };
+
+  for (size_t blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE) {
+    const size_t count = std::min(BLOCK_SIZE, end - blockBegin);
+    for (const auto& instruction : code) {
+      Compute* dst = reg(instruction.dst);
+      switch (instruction.op) {
+        case ExpressionProgram::OpCode::LOAD_OPERAND:
+          LoadBlock(operands[instruction.lhs], result.shape, blockBegin, count, dst);
+          break;
+        case ExpressionProgram::OpCode::LOAD_CONSTANT:
+          std::fill(dst, dst + BLOCK_SIZE, static_cast<Compute>(constants[instruction.lhs]));
+          break;
+        case ExpressionProgram::OpCode::ADD:
+          ApplyBinary(
+              dst, reg(instruction.lhs), reg(instruction.rhs), [](auto a, auto b) { return a + b; },
+              [](auto a, auto b) { return a + b; });
+          break;
+        case ExpressionProgram::OpCode::SUBTRACT:
+          ApplyBinary(
+              dst, reg(instruction.lhs), reg(instruction.rhs), [](auto a, auto b) { return a - b; },
+              [](auto a, auto b) { return a - b; });
+          break;
+        case ExpressionProgram::OpCode::MULTIPLY:
+          ApplyBinary(
+              dst, reg(instruction.lhs), reg(instruction.rhs), [](auto a, auto b) { return a * b; },
+              [](auto a, auto b) { return a * b; });
+          break;
+        case ExpressionProgram::OpCode::DIVIDE:
+          ApplyBinary(
+              dst, reg(instruction.lhs), reg(instruction.rhs), [](auto a, auto b) { return a / b; },
+              [](auto a, auto b) { return a / b; });
+          break;
+        case ExpressionProgram::OpCode::NEGATE:
+          ApplyBinary(
+              dst, reg(instruction.lhs), reg(instruction.lhs),
+              [](auto a, auto) { return Float4::Splat(0.0f) - a; }, [](auto a, auto) { return -a; });
+          break;
+      }
+    }
+    StoreBlock(result, blockBegin, count, reg(resultRegister));
+  }
+}
+
+bool NeedsDoublePrecision(const XrSecureMrTensorDataTypePICO dataType) {
+  return dataType == XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO || dataType == XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO;
+}
+
+/**
+ * The straightforward interpreter the bytecode is benchmarked against: every node materializes its full result
+ */
+std::vector<float> TreeWalk(const std::vector<Node>& nodes, const size_t index,
+                            const std::vector<std::vector<float>>& operands, const size_t count) {
+  const Node& node = nodes[index];
+  switch (node.kind) {
+    case Node::Kind::OPERAND:
+      return operands[node.operand];
+    case Node::Kind::CONSTANT:
+      return std::vector<float>(count, static_cast<float>(node.value));
+    case Node::Kind::NEGATE: {
+      auto value = TreeWalk(nodes, node.lhs, operands, count);
+      for (auto& each : value) each = -each;
+      return value;
+    }
+    default: {
+      const auto lhs = TreeWalk(nodes, node.lhs, operands, count);
+      const auto rhs = TreeWalk(nodes, node.rhs, operands, count);
+      std::vector<float> value(count);
+      for (size_t i = 0; i < count; ++i) {
+        switch (node.kind) {
+          case Node::Kind::ADD:
+            value[i] = lhs[i] + rhs[i];
+            break;
+          case Node::Kind::SUBTRACT:
+            value[i] = lhs[i] - rhs[i];
+            break;
+          case Node::Kind::MULTIPLY:
+            value[i] = lhs[i] * rhs[i];
+            break;
+          default:
+            value[i] = lhs[i] / rhs[i];
+            break;
+        }
+      }
+      return value;
+    }
+  }
+}
+
+}  // namespace
+
+ExpressionProgram ExpressionProgram::Compile(const std::string& expression) {
+  Parser parser(expression);
+  const size_t root = parser.parse();
+  CodeGenerator generator(parser.nodes);
+  ExpressionProgram program;
+  program.m_resultRegister = generator.emit(root);
+  program.m_code = std::move(generator.code);
+  program.m_constants = std::move(generator.constants);
+  program.m_operandCount = parser.operandCount;
+  program.m_registerCount = generator.registerCount;
+  return program;
+}
+
+void ExpressionProgram::evaluate(const std::vector<ConstTensorView>& operands, const TensorView& result,
+                                 ThreadPool& pool) const {
+  CHECK_MSG(operands.size() >= m_operandCount, "Arithmetic: fewer operands than the expression refers to")
+  CHECK_MSG(result.shape.size() <= MAX_RANK, "Arithmetic: result has too many axes")
+
+  std::vector<OperandAccess> accesses;
+  accesses.reserve(operands.size());
+  bool useDouble = NeedsDoublePrecision(result.dataType);
+  for (const auto& operand : operands) {
+    accesses.push_back(MakeOperandAccess(operand, result.shape));
+    useDouble = useDouble || NeedsDoublePrecision(operand.dataType);
+  }
+
+  const size_t total = result.elementCount();
+  pool.parallelFor(0, total, 16 * BLOCK_SIZE, [&](const size_t begin, const size_t end) {
+    if (useDouble) {
+      RunProgram<double>(m_code, m_constants, accesses, result, m_registerCount, m_resultRegister, begin, end);
+    } else {
+      RunProgram<float>(m_code, m_constants, accesses, result, m_registerCount, m_resultRegister, begin, end);
+    }
+  });
+}
+
+ExpressionBenchmarkResult BenchmarkExpression(const std::string& expression, const std::vector<size_t>& shape,
+                                              const size_t iterations) {
+  using Clock = std::chrono::steady_clock;
+  const size_t runs = std::max<size_t>(iterations, 1);
+  Parser parser(expression);
+  const size_t root = parser.parse();
+  const ExpressionProgram program = ExpressionProgram::Compile(expression);
+
+  size_t count = 1;
+  for (const size_t dim : shape) count *= dim;
+  std::mt19937 rng(0xa817);
+  std::uniform_real_distribution<float> distribution(1.0f, 255.0f);
+  std::vector<std::vector<float>> operandData(program.operandCount(), std::vector<float>(count));
+  std::vector<ConstTensorView> operands;
+  for (auto& data : operandData) {
+    for (auto& value : data) value = distribution(rng);
+    operands.push_back({.data = data.data(), .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO, .shape = shape});
+  }
+  std::vector<float> output(count);
+  const TensorView result{.data = output.data(), .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO, .shape = shape};
+
+  const auto bytecodeStart = Clock::now();
+  for (size_t run = 0; run < runs; ++run) program.evaluate(operands, result);
+  const auto bytecodeEnd = Clock::now();
+  std::vector<float> reference;
+  for (size_t run = 0; run < runs; ++run) reference = TreeWalk(parser.nodes, root, operandData, count);
+  const auto treeWalkerEnd = Clock::now();
+
+  ExpressionBenchmarkResult benchmark;
+  benchmark.bytecodeMsPerRun = std::chrono::duration<double, std::milli>(bytecodeEnd - bytecodeStart).count() / runs;
+  benchmark.treeWalkerMsPerRun =
+      std::chrono::duration<double, std::milli>(treeWalkerEnd - bytecodeEnd).count() / runs;
+  benchmark.speedup =
+      benchmark.bytecodeMsPerRun > 0.0 ? benchmark.treeWalkerMsPerRun / benchmark.bytecodeMsPerRun : 0.0;
+  for (size_t i = 0; i < count; ++i) {
+    benchmark.maxAbsDifference =
+        std::max(benchmark.maxAbsDifference, static_cast<double>(std::abs(output[i] - reference[i])));
+  }
+  return benchmark;
+}
+
+}  // namespace SecureMR::Host
@@ -0,0 +1,96 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_EXPRESSION_H_
+#define SECUREMR_UTILS_HOST_EXPRESSION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tensorview.h"
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * Host implementation of <code>Pipeline::arithmetic</code>.
+ * <br/>
+ * The expression, e.g., <code>({0} / 256.0 + {1}) * 256.0</code>, is compiled once into a register-based bytecode.
+ * Evaluation walks the result in blocks of a few hundred elements: each instruction processes a whole block with the
+ * 4-lane vectors of <code>simd.h</code>, and the registers are block-sized scratch buffers owned by the worker, so no
+ * full-size temporary is ever allocated regardless of the expression's depth.
+ * <br/>
+ * Operands are broadcast against the result shape numpy-style (trailing axes aligned, size-1 axes repeated), and may
+ * be of any SecureMR data type. Evaluation is in float32, or in float64 when any operand or the result is int32 or
+ * float64; integer results are rounded to nearest and saturated.
+ */
+class ExpressionProgram {
+ public:
+  /**
+   * Compile an expression with <code>+ - * /</code>, unary minus, parentheses, numeric literals and
+   * <code>{IDX}</code> operand references. Throws on a syntax error.
+   */
+  static ExpressionProgram Compile(const std::string& expression);
+
+  /**
+   * Number of operands the expression refers to, i.e., the largest <code>IDX</code> plus one
+   */
+  [[nodiscard]] size_t operandCount() const { return m_operandCount; }
+  [[nodiscard]] size_t registerCount() const { return m_registerCount; }
+  [[nodiscard]] size_t instructionCount() const { return m_code.size(); }
+
+  void evaluate(const std::vector<ConstTensorView>& operands, const TensorView& result,
+                ThreadPool& pool = ThreadPool::Default()) const;
+
+  enum class OpCode : uint8_t { LOAD_OPERAND, LOAD_CONSTANT, ADD, SUBTRACT, MULTIPLY, DIVIDE, NEGATE };
+
+  /**
+   * <code>registers[dst] = registers[lhs] OP registers[rhs]</code>; for the loads, <code>lhs</code> is the
+   * operand or constant index instead
+   */
+  struct Instruction {
+    OpCode op;
+    uint16_t dst;
+    uint16_t lhs;
+    uint16_t rhs;
+  };
+
+ private:
+  std::vector<Instruction> m_code;
+  std::vector<double> m_constants;
+  size_t m_operandCount = 0;
+  size_t m_registerCount = 0;
+  uint16_t m_resultRegister = 0;
+};
+
+struct ExpressionBenchmarkResult {
+  double bytecodeMsPerRun = 0.0;
+  double treeWalkerMsPerRun = 0.0;
+  double speedup = 0.0;
+  double maxAbsDifference = 0.0;
+};
+
+/**
+ * Compare <code>ExpressionProgram</code> against a tree-walking interpreter that materializes every sub-expression,
+ * with float32 operands of the given shape, e.g., <code>BenchmarkExpression("({0} / 256.0 + {1}) * 256.0",
+ * {8400, 2}, 100)</code> or with shape <code>{640, 640, 3}</code>.
+ */
+ExpressionBenchmarkResult BenchmarkExpression(const std::string& expression, const std::vector<size_t>& shape,
+                                              size_t iterations);
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_EXPRESSION_H_
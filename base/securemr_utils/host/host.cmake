@@ -0,0 +1,12 @@
+# Host-side reference kernels of the SecureMR operators, shared by the samples and the host kernel tests
+set(SECUREMR_HOST_KERNEL_SRCS
+    ${CMAKE_CURRENT_LIST_DIR}/camera.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/expression.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/model.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/preprocess.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/smallmat.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/sort.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/stereo.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/threadpool.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/warp.cpp
+)
@@ -0,0 +1,502 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "model.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include "check.h"
+
+namespace SecureMR::Host {
+
+namespace {
+
+constexpr char REPLAY_MAGIC[8] = {'S', 'M', 'R', 'R', 'P', 'L', 'Y', '1'};
+
+float LoadElement(const void* data, const XrSecureMrTensorDataTypePICO dataType, const size_t index) {
+  switch (dataType) {
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+      return static_cast<const uint8_t*>(data)[index];
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+      return static_cast<const int8_t*>(data)[index];
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+      return static_cast<const uint16_t*>(data)[index];
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
+      return static_cast<const int16_t*>(data)[index];
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+      return static_cast<float>(static_cast<const int32_t*>(data)[index]);
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
+      return static_cast<const float*>(data)[index];
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO:
+      return static_cast<float>(static_cast<const double*>(data)[index]);
+    default:
+      THROW("Model backend: unsupported tensor data type")
+  }
+}
+
+template <typename T>
+T SaturateRound(const float value) {
+  const float rounded = std::round(value);
+  if (rounded <= static_cast<float>(std::numeric_limits<T>::lowest())) return std::numeric_limits<T>::lowest();
+  if (rounded >= static_cast<float>(std::numeric_limits<T>::max())) return std::numeric_limits<T>::max();
+  return static_cast<T>(rounded);
+}
+
+void StoreElement(void* data, const XrSecureMrTensorDataTypePICO dataType, const size_t index, const float value) {
+  switch (dataType) {
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+      static_cast<uint8_t*>(data)[index] = SaturateRound<uint8_t>(value);
+      break;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+      static_cast<int8_t*>(data)[index] = SaturateRound<int8_t>(value);
+      break;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+      static_cast<uint16_t*>(data)[index] = SaturateRound<uint16_t>(value);
+      break;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
+      static_cast<int16_t*>(data)[index] = SaturateRound<int16_t>(value);
+      break;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+      static_cast<int32_t*>(data)[index] = SaturateRound<int32_t>(value);
+      break;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
+      static_cast<float*>(data)[index] = value;
+      break;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO:
+      static_cast<double*>(data)[index] = value;
+      break;
+    default:
+      THROW("Model backend: unsupported tensor data type")
+  }
+}
+
+size_t ShapeSize(const std::vector<size_t>& shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<>());
+}
+
+}  // namespace
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Reference interpreter                                                                                            */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+struct ReferenceModelBackend::Network {
+  enum class LayerType { CONV2D, MAX_POOL2D, DENSE, RELU, SOFTMAX, FLATTEN, REDUCE_MAX, ARGMAX };
+
+  struct Layer {
+    LayerType type = LayerType::RELU;
+    std::string input;
+    std::string output;
+    size_t outChannels = 0;  // filters or units
+    size_t kernelH = 1;
+    size_t kernelW = 1;
+    size_t stride = 1;
+    size_t padTop = 0;
+    size_t padLeft = 0;
+    bool relu = false;
+    std::vector<float> weights;
+    std::vector<float> bias;
+  };
+
+  struct Buffer {
+    std::vector<size_t> shape;
+    std::vector<float> values;
+  };
+
+  std::vector<std::string> inputNames;
+  std::vector<Layer> layers;
+  std::unordered_map<std::string, Buffer> buffers;
+
+  Buffer& buffer(const std::string& name) {
+    const auto it = buffers.find(name);
+    CHECK_MSG(it != buffers.end(), Fmt("Reference model: tensor \"%s\" is not defined", name.c_str()))
+    return it->second;
+  }
+
+  /**
+   * Parse one layer and infer the shape of its output, so that weights are validated and buffers allocated once
+   */
+  void addLayer(const nlohmann::json& spec) {
+    Layer layer;
+    const std::string type = spec.at("type").get<std::string>();
+    layer.input = spec.at("input").get<std::string>();
+    layer.output = spec.at("output").get<std::string>();
+    layer.relu = spec.value("activation", std::string{}) == "relu";
+    std::vector<size_t> inShape = buffer(layer.input).shape;
+    std::vector<size_t> outShape;
+
+    if (type == "conv2d" || type == "max_pool2d") {
+      if (inShape.size() == 2) inShape.push_back(1);
+      CHECK_MSG(inShape.size() == 3, Fmt("Reference model: %s expects an HWC input", type.c_str()))
+      const bool conv = type == "conv2d";
+      layer.type = conv ? LayerType::CONV2D : LayerType::MAX_POOL2D;
+      if (conv) {
+        const auto kernel = spec.at("kernel").get<std::vector<size_t>>();
+        CHECK_MSG(kernel.size() == 2, "Reference model: conv2d kernel must be [height, width]")
+        layer.kernelH = kernel[0];
+        layer.kernelW = kernel[1];
+        layer.outChannels = spec.at("filters").get<size_t>();
+      } else {
+        layer.kernelH = layer.kernelW = spec.at("size").get<size_t>();
+        layer.outChannels = inShape[2];
+      }
+      layer.stride = spec.value("stride", conv ? size_t{1} : layer.kernelH);
+      CHECK_MSG(layer.stride > 0 && layer.kernelH > 0 && layer.kernelW > 0, "Reference model: empty window")
+      const bool same = spec.value("padding", std::string{"valid"}) == "same";
+      size_t outH, outW;
+      if (same) {
+        outH = (inShape[0] + layer.stride - 1) / layer.stride;
+        outW = (inShape[1] + layer.stride - 1) / layer.stride;
+        const size_t padH = std::max<size_t>((outH - 1) * layer.stride + layer.kernelH, inShape[0]) - inShape[0];
+        const size_t padW = std::max<size_t>((outW - 1) * layer.stride + layer.kernelW, inShape[1]) - inShape[1];
+        layer.padTop = padH / 2;
+        layer.padLeft = padW / 2;
+      } else {
+        CHECK_MSG(inShape[0] >= layer.kernelH && inShape[1] >= layer.kernelW,
+                  Fmt("Reference model: window of \"%s\" larger than its input", layer.output.c_str()))
+        outH = (inShape[0] - layer.kernelH) / layer.stride + 1;
+        outW = (inShape[1] - layer.kernelW) / layer.stride + 1;
+      }
+      outShape = {outH, outW, layer.outChannels};
+      if (conv) {
+        layer.weights = spec.at("weights").get<std::vector<float>>();
+        CHECK_MSG(layer.weights.size() == layer.outChannels * layer.kernelH * layer.kernelW * inShape[2],
+                  Fmt("Reference model: conv2d \"%s\" has %zu weights", layer.output.c_str(), layer.weights.size()))
+      }
+    } else if (type == "dense") {
+      layer.type = LayerType::DENSE;
+      layer.outChannels = spec.at("units").get<size_t>();
+      layer.weights = spec.at("weights").get<std::vector<float>>();
+      CHECK_MSG(layer.weights.size() == layer.outChannels * ShapeSize(inShape),
+                Fmt("Reference model: dense \"%s\" has %zu weights", layer.output.c_str(), layer.weights.size()))
+      outShape = {layer.outChannels};
+    } else if (type == "relu" || type == "softmax" || type == "flatten") {
+      layer.type = type == "relu" ? LayerType::RELU : (type == "softmax" ? LayerType::SOFTMAX : LayerType::FLATTEN);
+      outShape = type == "flatten" ? std::vector<size_t>{ShapeSize(inShape)} : inShape;
+    } else if (type == "reduce_max" || type == "argmax") {
+      layer.type = type == "argmax" ? LayerType::ARGMAX : LayerType::REDUCE_MAX;
+      outShape.assign(inShape.begin(), inShape.end() - 1);
+      if (outShape.empty()) outShape.push_back(1);
+    } else {
+      THROW(Fmt("Reference model: unsupported layer type \"%s\"", type.c_str()))
+    }
+
+    if (layer.type == LayerType::CONV2D || layer.type == LayerType::DENSE) {
+      layer.bias = spec.contains("bias") ? spec.at("bias").get<std::vector<float>>()
+                                         : std::vector<float>(layer.outChannels, 0.0f);
+      CHECK_MSG(layer.bias.size() == layer.outChannels,
+                Fmt("Reference model: \"%s\" has %zu biases", layer.output.c_str(), layer.bias.size()))
+    }
+    CHECK_MSG(buffers.count(layer.output) == 0,
+              Fmt("Reference model: tensor \"%s\" is defined twice", layer.output.c_str()))
+    buffers[layer.output] = Buffer{.shape = outShape, .values = std::vector<float>(ShapeSize(outShape))};
+    layers.push_back(std::move(layer));
+  }
+
+  static void Conv2d(const Layer& layer, const Buffer& in, Buffer& out, ThreadPool& pool) {
+    const size_t inH = in.shape[0], inW = in.shape.size() > 1 ? in.shape[1] : 1;
+    const size_t inC = in.shape.size() > 2 ? in.shape[2] : 1;
+    const size_t outH = out.shape[0], outW = out.shape[1], outC = out.shape[2];
+    const bool pooling = layer.type == LayerType::MAX_POOL2D;
+
+    pool.parallelFor(0, outH, 1, [&](const size_t rowBegin, const size_t rowEnd) {
+      for (size_t oy = rowBegin; oy < rowEnd; ++oy) {
+        for (size_t ox = 0; ox < outW; ++ox) {
+          float* dst = out.values.data() + (oy * outW + ox) * outC;
+          for (size_t f = 0; f < outC; ++f) {
+            float acc = pooling ? -std::numeric_limits<float>::infinity() : layer.bias[f];
+            for (size_t ky = 0; ky < layer.kernelH; ++ky) {
+              const auto iy = static_cast<ptrdiff_t>(oy * layer.stride + ky) - static_cast<ptrdiff_t>(layer.padTop);
+              if (iy < 0 || iy >= static_cast<ptrdiff_t>(inH)) continue;
+              for (size_t kx = 0; kx < layer.kernelW; ++kx) {
+                const auto ix =
+                    static_cast<ptrdiff_t>(ox * layer.stride + kx) - static_cast<ptrdiff_t>(layer.padLeft);
+                if (ix < 0 || ix >= static_cast<ptrdiff_t>(inW)) continue;
+                const float* src = in.values.data() + (static_cast<size_t>(iy) * inW + static_cast<size_t>(ix)) * inC;
+                if (pooling) {
+                  acc = std::max(acc, src[f]);
+                  continue;
+                }
+                const float* w = layer.weights.data() + ((f * layer.kernelH + ky) * layer.kernelW + kx) * inC;
+                for (size_t c = 0; c < inC; ++c) acc += w[c] * src[c];
+              }
+            }
+            dst[f] = layer.relu ? std::max(acc, 0.0f) : acc;
+          }
+        }
+      }
+    });
+  }
+
+  static void Dense(const Layer& layer, const Buffer& in, Buffer& out) {
+    const size_t inputs = in.values.size();
+    for (size_t u = 0; u < layer.outChannels; ++u) {
+      const float* w = layer.weights.data() + u * inputs;
+      float acc = layer.bias[u];
+      for (size_t i = 0; i < inputs; ++i) acc += w[i] * in.values[i];
+      out.values[u] = layer.relu ? std::max(acc, 0.0f) : acc;
+    }
+  }
+
+  /**
+   * Softmax, reduce_max and argmax along the last axis
+   */
+  static void LastAxis(const LayerType type, const Buffer& in, Buffer& out) {
+    const size_t length = in.shape.back();
+    const size_t rows = in.values.size() / std::max<size_t>(length, 1);
+    for (size_t r = 0; r < rows; ++r) {
+      const float* src = in.values.data() + r * length;
+      const auto largest = std::max_element(src, src + length);
+      if (type == LayerType::REDUCE_MAX) {
+        out.values[r] = *largest;
+      } else if (type == LayerType::ARGMAX) {
+        out.values[r] = static_cast<float>(largest - src);
+      } else {
+        float* dst = out.values.data() + r * length;
+        float sum = 0.0f;
+        for (size_t i = 0; i < length; ++i) sum += dst[i] = std::exp(src[i] - *largest);
+        for (size_t i = 0; i < length; ++i) dst[i] /= sum;
+      }
+    }
+  }
+
+  void execute(ThreadPool& pool) {
+    for (const Layer& layer : layers) {
+      const Buffer& in = buffers.at(layer.input);
+      Buffer& out = buffers.at(layer.output);
+      switch (layer.type) {
+        case LayerType::CONV2D:
+        case LayerType::MAX_POOL2D:
+          Conv2d(layer, in, out, pool);
+          break;
+        case LayerType::DENSE:
+          Dense(layer, in, out);
+          break;
+        case LayerType::RELU:
+          for (size_t i = 0; i < in.values.size(); ++i) out.values[i] = std::max(in.values[i], 0.0f);
+          break;
+        case LayerType::FLATTEN:
+          std::copy(in.values.begin(), in.values.end(), out.values.begin());
+          break;
+        case LayerType::SOFTMAX:
+        case LayerType::REDUCE_MAX:
+        case LayerType::ARGMAX:
+          LastAxis(layer.type, in, out);
+          break;
+      }
+    }
+  }
+};
+
+bool ReferenceModelBackend::IsReferencePackage(const char* package, const size_t packageSize) {
+  const std::string_view text(package, packageSize);
+  const size_t start = text.find_first_not_of(" \t\r\n");
+  if (start == std::string_view::npos || text[start] != '{') return false;
+  // The format tag is expected near the top; weights may make the rest of the document large
+  return text.substr(0, 4096).find(FORMAT) != std::string_view::npos;
+}
+
+ReferenceModelBackend::ReferenceModelBackend(const char* package, const size_t packageSize, ThreadPool& pool)
+    : m_network(std::make_unique<Network>()), m_pool(pool) {
+  const auto spec = nlohmann::json::parse(package, package + packageSize, nullptr, false);
+  CHECK_MSG(!spec.is_discarded() && spec.is_object(), "Reference model: package is not a JSON document")
+  CHECK_MSG(spec.value("format", std::string{}) == FORMAT, "Reference model: unknown package format")
+  try {
+    for (const auto& input : spec.at("inputs")) {
+      const auto name = input.at("name").get<std::string>();
+      const auto shape = input.at("shape").get<std::vector<size_t>>();
+      m_network->inputNames.push_back(name);
+      m_network->buffers[name] = Network::Buffer{.shape = shape, .values = std::vector<float>(ShapeSize(shape))};
+    }
+    for (const auto& layer : spec.at("layers")) m_network->addLayer(layer);
+  } catch (const nlohmann::json::exception& e) {
+    THROW(Fmt("Reference model: malformed package, %s", e.what()))
+  }
+}
+
+ReferenceModelBackend::~ReferenceModelBackend() = default;
+
+void ReferenceModelBackend::run(const std::unordered_map<std::string, ConstTensorView>& inputs,
+                                const std::unordered_map<std::string, TensorView>& outputs) {
+  for (const auto& name : m_network->inputNames) {
+    const auto it = inputs.find(name);
+    CHECK_MSG(it != inputs.end(), Fmt("Reference model: missing input \"%s\"", name.c_str()))
+    auto& values = m_network->buffer(name).values;
+    CHECK_MSG(it->second.elementCount() == values.size(),
+              Fmt("Reference model: input \"%s\" has %zu elements, expected %zu", name.c_str(),
+                  it->second.elementCount(), values.size()))
+    if (it->second.dataType == XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO) {
+      std::memcpy(values.data(), it->second.data, values.size() * sizeof(float));
+    } else {
+      for (size_t i = 0; i < values.size(); ++i) values[i] = LoadElement(it->second.data, it->second.dataType, i);
+    }
+  }
+
+  m_network->execute(m_pool);
+
+  for (const auto& [name, view] : outputs) {
+    const auto& values = m_network->buffer(name).values;
+    CHECK_MSG(view.elementCount() == values.size(),
+              Fmt("Reference model: output \"%s\" has %zu elements, expected %zu", name.c_str(), view.elementCount(),
+                  values.size()))
+    for (size_t i = 0; i < values.size(); ++i) StoreElement(view.data, view.dataType, i, values[i]);
+  }
+}
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Replay                                                                                                           */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+std::unique_ptr<ReplayModelBackend> ReplayModelBackend::Load(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  CHECK_MSG(file.is_open(), Fmt("Replay model: cannot open \"%s\"", path.string().c_str()))
+  const auto read = [&](void* dst, const size_t size) {
+    file.read(static_cast<char*>(dst), static_cast<std::streamsize>(size));
+    CHECK_MSG(file.good(), Fmt("Replay model: \"%s\" is truncated", path.string().c_str()))
+  };
+
+  char magic[sizeof(REPLAY_MAGIC)];
+  read(magic, sizeof(magic));
+  CHECK_MSG(std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) == 0,
+            Fmt("Replay model: \"%s\" is not a recording", path.string().c_str()))
+  uint32_t outputCount = 0;
+  uint64_t frameCount = 0;
+  read(&outputCount, sizeof(outputCount));
+  read(&frameCount, sizeof(frameCount));
+
+  auto backend = std::make_unique<ReplayModelBackend>();
+  backend->m_frameCount = frameCount;
+  for (uint32_t o = 0; o < outputCount; ++o) {
+    uint32_t nameLength = 0;
+    read(&nameLength, sizeof(nameLength));
+    std::string name(nameLength, '\0');
+    read(name.data(), nameLength);
+    auto& frames = backend->m_frames[name];
+    frames.resize(frameCount);
+    for (auto& frame : frames) {
+      uint64_t size = 0;
+      read(&size, sizeof(size));
+      frame.resize(size);
+      read(frame.data(), size);
+    }
+  }
+  return backend;
+}
+
+void ReplayModelBackend::record(const std::unordered_map<std::string, ConstTensorView>& outputs) {
+  if (m_frameCount > 0) {
+    CHECK_MSG(outputs.size() == m_frames.size(), "Replay model: every frame must record the same outputs")
+  }
+  for (const auto& [name, view] : outputs) {
+    auto& frames = m_frames[name];
+    CHECK_MSG(frames.size() == m_frameCount, "Replay model: every frame must record the same outputs")
+    const auto* bytes = static_cast<const uint8_t*>(view.data);
+    frames.emplace_back(bytes, bytes + view.elementCount() * DataTypeSize(view.dataType));
+  }
+  ++m_frameCount;
+}
+
+void ReplayModelBackend::save(const std::filesystem::path& path) const {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  CHECK_MSG(file.is_open(), Fmt("Replay model: cannot create \"%s\"", path.string().c_str()))
+  const auto write = [&](const void* src, const size_t size) {
+    file.write(static_cast<const char*>(src), static_cast<std::streamsize>(size));
+  };
+  const auto outputCount = static_cast<uint32_t>(m_frames.size());
+  const auto frameCount = static_cast<uint64_t>(m_frameCount);
+  write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+  write(&outputCount, sizeof(outputCount));
+  write(&frameCount, sizeof(frameCount));
+  for (const auto& [name, frames] : m_frames) {
+    const auto nameLength = static_cast<uint32_t>(name.size());
+    write(&nameLength, sizeof(nameLength));
+    write(name.data(), name.size());
+    for (const auto& frame : frames) {
+      const auto size = static_cast<uint64_t>(frame.size());
+      write(&size, sizeof(size));
+      write(frame.data(), frame.size());
+    }
+  }
+  CHECK_MSG(file.good(), Fmt("Replay model: failed to write \"%s\"", path.string().c_str()))
+}
+
+void ReplayModelBackend::run(const std::unordered_map<std::string, ConstTensorView>& /*inputs*/,
+                             const std::unordered_map<std::string, TensorView>& outputs) {
+  CHECK_MSG(m_frameCount > 0, "Replay model: the recording is empty")
+  for (const auto& [name, view] : outputs) {
+    const auto it = m_frames.find(name);
+    CHECK_MSG(it != m_frames.end(), Fmt("Replay model: output \"%s\" was not recorded", name.c_str()))
+    const auto& frame = it->second[m_nextFrame];
+    CHECK_MSG(frame.size() == view.elementCount() * DataTypeSize(view.dataType),
+              Fmt("Replay model: recorded output \"%s\" does not match the size of its tensor", name.c_str()))
+    std::memcpy(view.data, frame.data(), frame.size());
+  }
+  m_nextFrame = (m_nextFrame + 1) % m_frameCount;
+}
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* Registry                                                                                                         */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+ModelBackendRegistry& ModelBackendRegistry::Default() {
+  static ModelBackendRegistry registry;
+  return registry;
+}
+
+void ModelBackendRegistry::registerFactory(const std::string& modelName, ModelBackendFactory factory) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_factories[modelName] = std::move(factory);
+}
+
+std::unique_ptr<ModelBackend> ModelBackendRegistry::create(const char* package, const size_t packageSize,
+                                                           const std::string& modelName) const {
+  ModelBackendFactory factory;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_factories.find(modelName);
+    if (it != m_factories.end()) factory = it->second;
+  }
+  if (factory) return factory(package, packageSize, modelName);
+  if (ReferenceModelBackend::IsReferencePackage(package, packageSize)) {
+    return std::make_unique<ReferenceModelBackend>(package, packageSize);
+  }
+  THROW(Fmt("No host model backend for model \"%s\"", modelName.c_str()))
+}
+
+ModelBenchmarkResult BenchmarkModelBackend(ModelBackend& backend,
+                                           const std::unordered_map<std::string, ConstTensorView>& inputs,
+                                           const std::unordered_map<std::string, TensorView>& outputs,
+                                           const size_t iterations) {
+  using Clock = std::chrono::steady_clock;
+  const size_t runs = std::max<size_t>(iterations, 1);
+  backend.run(inputs, outputs);  // warm-up: first-run allocations are not part of the steady state
+  const auto start = Clock::now();
+  for (size_t run = 0; run < runs; ++run) backend.run(inputs, outputs);
+  const auto end = Clock::now();
+
+  ModelBenchmarkResult result;
+  result.msPerRun = std::chrono::duration<double, std::milli>(end - start).count() / runs;
+  result.runsPerSecond = result.msPerRun > 0.0 ? 1e3 / result.msPerRun : 0.0;
+  return result;
+}
+
+}  // namespace SecureMR::Host
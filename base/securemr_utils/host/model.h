@@ -0,0 +1,166 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_MODEL_H_
+#define SECUREMR_UTILS_HOST_MODEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorview.h"
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * Executes the model of a <code>Pipeline::runAlgorithm</code> operator on the host.
+ * <br/>
+ * Inputs and outputs are keyed by the model's own operand names, i.e., the keys of <code>algOps</code> and
+ * <code>algResults</code> after the aliasing has been applied. Output views are allocated by the caller with the
+ * attributes of the pipeline tensors they are bound to; the backend converts its results to their data type.
+ */
+class ModelBackend {
+ public:
+  virtual ~ModelBackend() = default;
+
+  virtual void run(const std::unordered_map<std::string, ConstTensorView>& inputs,
+                   const std::unordered_map<std::string, TensorView>& outputs) = 0;
+};
+
+/**
+ * Creates the backend of one <code>runAlgorithm</code> operator from its model package, as passed in
+ * <code>algPackageBuf</code>, and its model name
+ */
+using ModelBackendFactory =
+    std::function<std::unique_ptr<ModelBackend>(const char* package, size_t packageSize, const std::string& modelName)>;
+
+/**
+ * The model backends available to the host runtime, by model name.
+ * <br/>
+ * A model name without a registered factory falls back to the reference interpreter when its package is a reference
+ * network (see <code>ReferenceModelBackend</code>). QNN context binaries cannot be executed on the host: register a
+ * replay backend for such models, e.g., <code>"yolo"</code> or the pose sample's models.
+ */
+class ModelBackendRegistry {
+ public:
+  static ModelBackendRegistry& Default();
+
+  void registerFactory(const std::string& modelName, ModelBackendFactory factory);
+
+  /**
+   * @throw std::logic_error if no backend can execute the package
+   */
+  std::unique_ptr<ModelBackend> create(const char* package, size_t packageSize, const std::string& modelName) const;
+
+ private:
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, ModelBackendFactory> m_factories;
+};
+
+/**
+ * Built-in interpreter for small float32 convolutional/dense networks, e.g., the mnistwild classifier.
+ * <br/>
+ * The package is a JSON document describing a graph of layers over named HWC tensors:
+ * <pre>
+ * {"format": "securemr-reference-net",
+ *  "inputs": [{"name": "input_1", "shape": [28, 28, 1]}],
+ *  "layers": [
+ *    {"type": "conv2d", "input": "input_1", "output": "c1", "filters": 8, "kernel": [3, 3], "stride": 1,
+ *     "padding": "same", "activation": "relu", "weights": [...], "bias": [...]},
+ *    {"type": "max_pool2d", "input": "c1", "output": "p1", "size": 2, "stride": 2},
+ *    {"type": "dense", "input": "p1", "output": "logits", "units": 10, "weights": [...], "bias": [...]},
+ *    {"type": "softmax", "input": "logits", "output": "prob"},
+ *    {"type": "reduce_max", "input": "prob", "output": "_538"},
+ *    {"type": "argmax", "input": "prob", "output": "_539"}]}
+ * </pre>
+ * Convolution weights are laid out <code>[filters][kernelH][kernelW][inChannels]</code> and dense weights
+ * <code>[units][inputs]</code>; a dense layer flattens its input. Further layer types: <code>relu</code>,
+ * <code>flatten</code>. Intermediate buffers are kept across runs, and convolutions are split by output row across
+ * the pool.
+ */
+class ReferenceModelBackend : public ModelBackend {
+ public:
+  static constexpr const char* FORMAT = "securemr-reference-net";
+
+  /**
+   * @return Whether the package is a reference network, without parsing it fully
+   */
+  static bool IsReferencePackage(const char* package, size_t packageSize);
+
+  ReferenceModelBackend(const char* package, size_t packageSize, ThreadPool& pool = ThreadPool::Default());
+  ~ReferenceModelBackend() override;
+
+  void run(const std::unordered_map<std::string, ConstTensorView>& inputs,
+           const std::unordered_map<std::string, TensorView>& outputs) override;
+
+ private:
+  struct Network;
+  std::unique_ptr<Network> m_network;
+  ThreadPool& m_pool;
+};
+
+/**
+ * Deterministic stand-in for models that cannot run on the host: each run writes the next recorded frame of every
+ * output, cycling through the recording. Frames are raw bytes in the data type of the bound output tensors.
+ */
+class ReplayModelBackend : public ModelBackend {
+ public:
+  ReplayModelBackend() = default;
+
+  /**
+   * Load a recording written by <code>save</code>
+   */
+  static std::unique_ptr<ReplayModelBackend> Load(const std::filesystem::path& path);
+
+  /**
+   * Append one frame, e.g., the outputs of a run on the device
+   */
+  void record(const std::unordered_map<std::string, ConstTensorView>& outputs);
+
+  void save(const std::filesystem::path& path) const;
+
+  [[nodiscard]] size_t frameCount() const { return m_frameCount; }
+
+  void run(const std::unordered_map<std::string, ConstTensorView>& inputs,
+           const std::unordered_map<std::string, TensorView>& outputs) override;
+
+ private:
+  std::unordered_map<std::string, std::vector<std::vector<uint8_t>>> m_frames;
+  size_t m_frameCount = 0;
+  size_t m_nextFrame = 0;
+};
+
+struct ModelBenchmarkResult {
+  double msPerRun = 0.0;
+  double runsPerSecond = 0.0;
+};
+
+/**
+ * Time <code>iterations</code> runs of a backend, e.g., to measure pipeline throughput without the QNN SDK
+ */
+ModelBenchmarkResult BenchmarkModelBackend(ModelBackend& backend,
+                                           const std::unordered_map<std::string, ConstTensorView>& inputs,
+                                           const std::unordered_map<std::string, TensorView>& outputs,
+                                           size_t iterations);
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_MODEL_H_
@@ -0,0 +1,153 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "preprocess.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+#include "check.h"
+#include "simd.h"
+
+namespace SecureMR::Host {
+
+namespace {
+
+constexpr int ALPHA = -1;  // marker in ConversionPlan::source for a constant opaque alpha channel
+
+// Fixed-point RGB to gray weights of OpenCV (cv::COLOR_RGB2GRAY and friends)
+constexpr int32_t GRAY_SHIFT = 14;
+constexpr int32_t GRAY_R = 4899, GRAY_G = 9617, GRAY_B = 1868;
+
+struct ConversionPlan {
+  size_t srcChannels = 0;
+  size_t dstChannels = 0;
+  bool gray = false;
+  /**
+   * Color conversion: the source channel of each destination channel. Gray: the source channels of R, G and B.
+   */
+  int source[4] = {0, 1, 2, 3};
+};
+
+bool MakeConversionPlan(const size_t srcChannels, const int flag, ConversionPlan& plan) {
+  plan.srcChannels = srcChannels;
+  const auto reorder = [&](const size_t from, const size_t to, std::initializer_list<int> source) {
+    if (srcChannels != from) return false;
+    plan.dstChannels = to;
+    std::copy(source.begin(), source.end(), plan.source);
+    return true;
+  };
+  const auto toGray = [&](const size_t from, std::initializer_list<int> rgb) {
+    if (srcChannels != from) return false;
+    plan.dstChannels = 1;
+    plan.gray = true;
+    std::copy(rgb.begin(), rgb.end(), plan.source);
+    return true;
+  };
+
+  switch (flag) {
+    case -1:
+      if (srcChannels < 1 || srcChannels > 4) return false;
+      plan.dstChannels = srcChannels;
+      return true;
+    case 0:  // BGR2BGRA, RGB2RGBA
+      return reorder(3, 4, {0, 1, 2, ALPHA});
+    case 1:  // BGRA2BGR, RGBA2RGB
+      return reorder(4, 3, {0, 1, 2});
+    case 2:  // BGR2RGBA, RGB2BGRA
+      return reorder(3, 4, {2, 1, 0, ALPHA});
+    case 3:  // RGBA2BGR, BGRA2RGB
+      return reorder(4, 3, {2, 1, 0});
+    case 4:  // BGR2RGB, RGB2BGR
+      return reorder(3, 3, {2, 1, 0});
+    case 5:  // BGRA2RGBA, RGBA2BGRA
+      return reorder(4, 4, {2, 1, 0, 3});
+    case 6:  // BGR2GRAY
+      return toGray(3, {2, 1, 0});
+    case 7:  // RGB2GRAY
+      return toGray(3, {0, 1, 2});
+    case 10:  // BGRA2GRAY
+      return toGray(4, {2, 1, 0});
+    case 11:  // RGBA2GRAY
+      return toGray(4, {0, 1, 2});
+    default:
+      return false;
+  }
+}
+
+/**
+ * The (color-converted) uint8 value of output channel <code>c</code> of one pixel
+ */
+inline int32_t ConvertedValue(const ConversionPlan& plan, const uint8_t* pixel, const size_t c) {
+  if (plan.gray) {
+    return (pixel[plan.source[0]] * GRAY_R + pixel[plan.source[1]] * GRAY_G + pixel[plan.source[2]] * GRAY_B +
+            (1 << (GRAY_SHIFT - 1))) >>
+           GRAY_SHIFT;
+  }
+  return plan.source[c] == ALPHA ? 255 : pixel[plan.source[c]];
+}
+
+void PreprocessRows(const uint8_t* src, const size_t width, const size_t height, const ConversionPlan& plan,
+                    const PreprocessParams& params, float* dst, const size_t rowBegin, const size_t rowEnd) {
+  const size_t planeSize = width * height;
+  alignas(16) int32_t converted[4];
+  alignas(16) float normalized[4];
+
+  for (size_t y = rowBegin; y < rowEnd; ++y) {
+    const uint8_t* srcRow = src + y * width * plan.srcChannels;
+    for (size_t x = 0; x < width; x += 4) {
+      const size_t lanes = std::min<size_t>(4, width - x);
+      for (size_t c = 0; c < plan.dstChannels; ++c) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+          converted[lane] = lane < lanes ? ConvertedValue(plan, srcRow + (x + lane) * plan.srcChannels, c) : 0;
+        }
+        const Float4 value =
+            (Float4::FromInt(Int4::Load(converted)) - Float4::Splat(params.mean[c])) / Float4::Splat(params.stddev[c]);
+        if (params.planarOutput) {
+          float* out = dst + c * planeSize + y * width + x;
+          if (lanes == 4) {
+            value.store(out);
+            continue;
+          }
+          value.store(normalized);
+          std::copy(normalized, normalized + lanes, out);
+        } else {
+          value.store(normalized);
+          float* out = dst + (y * width + x) * plan.dstChannels + c;
+          for (size_t lane = 0; lane < lanes; ++lane) out[lane * plan.dstChannels] = normalized[lane];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+size_t PreprocessOutputChannels(const size_t srcChannels, const PreprocessParams& params) {
+  ConversionPlan plan;
+  return MakeConversionPlan(srcChannels, params.cvtColorFlag, plan) ? plan.dstChannels : 0;
+}
+
+void PreprocessImage(const uint8_t* src, const size_t width, const size_t height, const size_t srcChannels,
+                     const PreprocessParams& params, float* dst, ThreadPool& pool) {
+  ConversionPlan plan;
+  CHECK_MSG(MakeConversionPlan(srcChannels, params.cvtColorFlag, plan),
+            "PreprocessImage: unsupported color conversion for the given channel count")
+  const size_t grain = std::max<size_t>(1, 16384 / std::max<size_t>(width, 1));
+  pool.parallelFor(0, height, grain, [&](const size_t begin, const size_t end) {
+    PreprocessRows(src, width, height, plan, params, dst, begin, end);
+  });
+}
+
+}  // namespace SecureMR::Host
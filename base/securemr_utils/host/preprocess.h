@@ -0,0 +1,67 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_PREPROCESS_H_
+#define SECUREMR_UTILS_HOST_PREPROCESS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * Parameters of <code>PreprocessImage</code>, i.e., of a
+ * <code>cvtColor -> typeConvert/assignment -> arithmetic("({0} - mean) / stddev") -> convertHWC_CHW</code> chain.
+ */
+struct PreprocessParams {
+  /**
+   * OpenCV color conversion code as passed to <code>Pipeline::cvtColor</code>, or -1 to keep the channels as they
+   * are. Supported: reordering and adding/dropping alpha among RGB/BGR/RGBA/BGRA (codes 0 to 5), and conversion to
+   * gray (codes 6, 7, 10, 11).
+   */
+  int cvtColorFlag = -1;
+  /**
+   * Per output channel: <code>value = (float(pixel) - mean[c]) / stddev[c]</code>, e.g., a mean of 0 and a standard
+   * deviation of 255 for <code>{0} / 255.0</code>
+   */
+  std::array<float, 4> mean{0.0f, 0.0f, 0.0f, 0.0f};
+  std::array<float, 4> stddev{1.0f, 1.0f, 1.0f, 1.0f};
+  /**
+   * Write a CHW (planar) tensor instead of an HWC (interleaved) one
+   */
+  bool planarOutput = false;
+};
+
+/**
+ * Number of output channels produced from <code>srcChannels</code> input channels by
+ * <code>params.cvtColorFlag</code>, or 0 if the combination is not supported
+ */
+size_t PreprocessOutputChannels(size_t srcChannels, const PreprocessParams& params);
+
+/**
+ * Read an interleaved uint8 image once and write the color-converted, normalized float32 tensor in the requested
+ * layout. Gray conversion uses the same fixed-point weights and rounding as OpenCV, and the normalization the same
+ * float32 subtraction and division as the arithmetic operator, so the result is identical to running the chain.
+ * @param dst <code>height x width x C</code> floats for HWC output, <code>C x height x width</code> for CHW output,
+ *            where <code>C = PreprocessOutputChannels(srcChannels, params)</code>
+ */
+void PreprocessImage(const uint8_t* src, size_t width, size_t height, size_t srcChannels,
+                     const PreprocessParams& params, float* dst, ThreadPool& pool = ThreadPool::Default());
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_PREPROCESS_H_
@@ -0,0 +1,267 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_SIMD_H_
+#define SECUREMR_UTILS_HOST_SIMD_H_
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SECUREMR_HOST_SIMD_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SECUREMR_HOST_SIMD_SSE2 1
+#endif
+
+namespace SecureMR::Host {
+
+/**
+ * A minimal 4-lane vector abstraction shared by the host kernels. It maps to NEON on the arm64 devices the samples
+ * are built for, to SSE2 on desktop hosts, and falls back to plain arrays elsewhere, so that every kernel has exactly
+ * one implementation regardless of the instruction set.
+ */
+struct Mask4;
+struct Int4;
+
+struct Float4 {
+#if defined(SECUREMR_HOST_SIMD_NEON)
+  float32x4_t v;
+#elif defined(SECUREMR_HOST_SIMD_SSE2)
+  __m128 v;
+#else
+  float v[4];
+#endif
+
+  static Float4 Load(const float* src);
+  static Float4 Splat(float value);
+  static Float4 FromInt(const Int4& value);
+  void store(float* dst) const;
+};
+
+struct Int4 {
+#if defined(SECUREMR_HOST_SIMD_NEON)
+  int32x4_t v;
+#elif defined(SECUREMR_HOST_SIMD_SSE2)
+  __m128i v;
+#else
+  int32_t v[4];
+#endif
+
+  static Int4 Load(const int32_t* src);
+  static Int4 Splat(int32_t value);
+  /**
+   * Round-to-nearest conversion, matching <code>cv::saturate_cast</code> for in-range values
+   */
+  static Int4 FromFloatRound(const Float4& value);
+  /**
+   * Truncating conversion, i.e., <code>static_cast&lt;int&gt;</code> per lane
+   */
+  static Int4 FromFloatTrunc(const Float4& value);
+  void store(int32_t* dst) const;
+};
+
+struct Mask4 {
+#if defined(SECUREMR_HOST_SIMD_NEON)
+  uint32x4_t v;
+#elif defined(SECUREMR_HOST_SIMD_SSE2)
+  __m128 v;
+#else
+  bool v[4];
+#endif
+};
+
+#if defined(SECUREMR_HOST_SIMD_NEON)
+
+inline Float4 Float4::Load(const float* src) { return {vld1q_f32(src)}; }
+inline Float4 Float4::Splat(const float value) { return {vdupq_n_f32(value)}; }
+inline Float4 Float4::FromInt(const Int4& value) { return {vcvtq_f32_s32(value.v)}; }
+inline void Float4::store(float* dst) const { vst1q_f32(dst, v); }
+
+inline Int4 Int4::Load(const int32_t* src) { return {vld1q_s32(src)}; }
+inline Int4 Int4::Splat(const int32_t value) { return {vdupq_n_s32(value)}; }
+inline Int4 Int4::FromFloatRound(const Float4& value) { return {vcvtnq_s32_f32(value.v)}; }
+inline Int4 Int4::FromFloatTrunc(const Float4& value) { return {vcvtq_s32_f32(value.v)}; }
+inline void Int4::store(int32_t* dst) const { vst1q_s32(dst, v); }
+
+inline Float4 operator+(const Float4& a, const Float4& b) { return {vaddq_f32(a.v, b.v)}; }
+inline Float4 operator-(const Float4& a, const Float4& b) { return {vsubq_f32(a.v, b.v)}; }
+inline Float4 operator*(const Float4& a, const Float4& b) { return {vmulq_f32(a.v, b.v)}; }
+inline Float4 operator/(const Float4& a, const Float4& b) { return {vdivq_f32(a.v, b.v)}; }
+inline Float4 Min(const Float4& a, const Float4& b) { return {vminq_f32(a.v, b.v)}; }
+inline Float4 Max(const Float4& a, const Float4& b) { return {vmaxq_f32(a.v, b.v)}; }
+inline Float4 MulAdd(const Float4& acc, const Float4& a, const Float4& b) { return {vfmaq_f32(acc.v, a.v, b.v)}; }
+inline Float4 Floor(const Float4& a) { return {vrndmq_f32(a.v)}; }
+inline Mask4 Greater(const Float4& a, const Float4& b) { return {vcgtq_f32(a.v, b.v)}; }
+inline Mask4 GreaterEqual(const Float4& a, const Float4& b) { return {vcgeq_f32(a.v, b.v)}; }
+inline Mask4 Equal(const Float4& a, const Float4& b) { return {vceqq_f32(a.v, b.v)}; }
+inline Mask4 Less(const Int4& a, const Int4& b) { return {vcltq_s32(a.v, b.v)}; }
+inline Mask4 operator&(const Mask4& a, const Mask4& b) { return {vandq_u32(a.v, b.v)}; }
+inline Mask4 operator|(const Mask4& a, const Mask4& b) { return {vorrq_u32(a.v, b.v)}; }
+inline Float4 Select(const Mask4& m, const Float4& a, const Float4& b) { return {vbslq_f32(m.v, a.v, b.v)}; }
+inline Int4 Select(const Mask4& m, const Int4& a, const Int4& b) { return {vbslq_s32(m.v, a.v, b.v)}; }
+inline Int4 operator+(const Int4& a, const Int4& b) { return {vaddq_s32(a.v, b.v)}; }
+inline Int4 operator-(const Int4& a, const Int4& b) { return {vsubq_s32(a.v, b.v)}; }
+inline Int4 operator*(const Int4& a, const Int4& b) { return {vmulq_s32(a.v, b.v)}; }
+inline Int4 Min(const Int4& a, const Int4& b) { return {vminq_s32(a.v, b.v)}; }
+inline Int4 Max(const Int4& a, const Int4& b) { return {vmaxq_s32(a.v, b.v)}; }
+
+#elif defined(SECUREMR_HOST_SIMD_SSE2)
+
+inline Float4 Float4::Load(const float* src) { return {_mm_loadu_ps(src)}; }
+inline Float4 Float4::Splat(const float value) { return {_mm_set1_ps(value)}; }
+inline Float4 Float4::FromInt(const Int4& value) { return {_mm_cvtepi32_ps(value.v)}; }
+inline void Float4::store(float* dst) const { _mm_storeu_ps(dst, v); }
+
+inline Int4 Int4::Load(const int32_t* src) { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))}; }
+inline Int4 Int4::Splat(const int32_t value) { return {_mm_set1_epi32(value)}; }
+inline Int4 Int4::FromFloatRound(const Float4& value) { return {_mm_cvtps_epi32(value.v)}; }
+inline Int4 Int4::FromFloatTrunc(const Float4& value) { return {_mm_cvttps_epi32(value.v)}; }
+inline void Int4::store(int32_t* dst) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v); }
+
+inline Float4 operator+(const Float4& a, const Float4& b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float4 operator-(const Float4& a, const Float4& b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float4 operator*(const Float4& a, const Float4& b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float4 operator/(const Float4& a, const Float4& b) { return {_mm_div_ps(a.v, b.v)}; }
+inline Float4 Min(const Float4& a, const Float4& b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Float4 Max(const Float4& a, const Float4& b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Float4 MulAdd(const Float4& acc, const Float4& a, const Float4& b) {
+  return {_mm_add_ps(acc.v, _mm_mul_ps(a.v, b.v))};
+}
+inline Float4 Floor(const Float4& a) {
+  // SSE2 has no floor: truncate, then step down where truncation rounded up (negative non-integers)
+  const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+  const __m128 roundedUp = _mm_cmpgt_ps(truncated, a.v);
+  return {_mm_sub_ps(truncated, _mm_and_ps(roundedUp, _mm_set1_ps(1.0f)))};
+}
+inline Mask4 Greater(const Float4& a, const Float4& b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline Mask4 GreaterEqual(const Float4& a, const Float4& b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+inline Mask4 Equal(const Float4& a, const Float4& b) { return {_mm_cmpeq_ps(a.v, b.v)}; }
+inline Mask4 Less(const Int4& a, const Int4& b) { return {_mm_castsi128_ps(_mm_cmplt_epi32(a.v, b.v))}; }
+inline Mask4 operator&(const Mask4& a, const Mask4& b) { return {_mm_and_ps(a.v, b.v)}; }
+inline Mask4 operator|(const Mask4& a, const Mask4& b) { return {_mm_or_ps(a.v, b.v)}; }
+inline Float4 Select(const Mask4& m, const Float4& a, const Float4& b) {
+  return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))};
+}
+inline Int4 Select(const Mask4& m, const Int4& a, const Int4& b) {
+  const __m128i mask = _mm_castps_si128(m.v);
+  return {_mm_or_si128(_mm_and_si128(mask, a.v), _mm_andnot_si128(mask, b.v))};
+}
+inline Int4 operator+(const Int4& a, const Int4& b) { return {_mm_add_epi32(a.v, b.v)}; }
+inline Int4 operator-(const Int4& a, const Int4& b) { return {_mm_sub_epi32(a.v, b.v)}; }
+inline Int4 operator*(const Int4& a, const Int4& b) {
+  // SSE2 lacks _mm_mullo_epi32; multiply even and odd lanes separately and interleave the low halves
+  const __m128i even = _mm_mul_epu32(a.v, b.v);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a.v, 4), _mm_srli_si128(b.v, 4));
+  return {_mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                             _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)))};
+}
+inline Int4 Min(const Int4& a, const Int4& b) {
+  const __m128i gt = _mm_cmpgt_epi32(a.v, b.v);
+  return {_mm_or_si128(_mm_and_si128(gt, b.v), _mm_andnot_si128(gt, a.v))};
+}
+inline Int4 Max(const Int4& a, const Int4& b) {
+  const __m128i gt = _mm_cmpgt_epi32(a.v, b.v);
+  return {_mm_or_si128(_mm_and_si128(gt, a.v), _mm_andnot_si128(gt, b.v))};
+}
+
+#else
+
+#define SECUREMR_HOST_SIMD_LANEWISE(EXPR) \
+  for (int lane = 0; lane < 4; ++lane) {  \
+    EXPR;                                 \
+  }
+
+inline Float4 Float4::Load(const float* src) {
+  Float4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = src[lane])
+  return r;
+}
+inline Float4 Float4::Splat(const float value) { return {{value, value, value, value}}; }
+inline Float4 Float4::FromInt(const Int4& value) {
+  Float4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = static_cast<float>(value.v[lane]))
+  return r;
+}
+inline void Float4::store(float* dst) const { SECUREMR_HOST_SIMD_LANEWISE(dst[lane] = v[lane]) }
+
+inline Int4 Int4::Load(const int32_t* src) {
+  Int4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = src[lane])
+  return r;
+}
+inline Int4 Int4::Splat(const int32_t value) { return {{value, value, value, value}}; }
+inline Int4 Int4::FromFloatRound(const Float4& value) {
+  Int4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = static_cast<int32_t>(std::lrint(value.v[lane])))
+  return r;
+}
+inline Int4 Int4::FromFloatTrunc(const Float4& value) {
+  Int4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = static_cast<int32_t>(value.v[lane]))
+  return r;
+}
+inline void Int4::store(int32_t* dst) const { SECUREMR_HOST_SIMD_LANEWISE(dst[lane] = v[lane]) }
+
+#define SECUREMR_HOST_SIMD_BINARY(RET, NAME, TYPE, EXPR) \
+  inline RET NAME(const TYPE& a, const TYPE& b) {        \
+    RET r;                                               \
+    SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = (EXPR))      \
+    return r;                                            \
+  }
+
+SECUREMR_HOST_SIMD_BINARY(Float4, operator+, Float4, a.v[lane] + b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Float4, operator-, Float4, a.v[lane] - b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Float4, operator*, Float4, a.v[lane] * b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Float4, operator/, Float4, a.v[lane] / b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Float4, Min, Float4, a.v[lane] < b.v[lane] ? a.v[lane] : b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Float4, Max, Float4, a.v[lane] > b.v[lane] ? a.v[lane] : b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Mask4, Greater, Float4, a.v[lane] > b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Mask4, GreaterEqual, Float4, a.v[lane] >= b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Mask4, Equal, Float4, a.v[lane] == b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Mask4, Less, Int4, a.v[lane] < b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Mask4, operator&, Mask4, a.v[lane] && b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Mask4, operator|, Mask4, a.v[lane] || b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Int4, operator+, Int4, a.v[lane] + b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Int4, operator-, Int4, a.v[lane] - b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Int4, operator*, Int4, a.v[lane] * b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Int4, Min, Int4, a.v[lane] < b.v[lane] ? a.v[lane] : b.v[lane])
+SECUREMR_HOST_SIMD_BINARY(Int4, Max, Int4, a.v[lane] > b.v[lane] ? a.v[lane] : b.v[lane])
+
+inline Float4 MulAdd(const Float4& acc, const Float4& a, const Float4& b) { return acc + a * b; }
+inline Float4 Floor(const Float4& a) {
+  Float4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = std::floor(a.v[lane]))
+  return r;
+}
+inline Float4 Select(const Mask4& m, const Float4& a, const Float4& b) {
+  Float4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = m.v[lane] ? a.v[lane] : b.v[lane])
+  return r;
+}
+inline Int4 Select(const Mask4& m, const Int4& a, const Int4& b) {
+  Int4 r;
+  SECUREMR_HOST_SIMD_LANEWISE(r.v[lane] = m.v[lane] ? a.v[lane] : b.v[lane])
+  return r;
+}
+
+#undef SECUREMR_HOST_SIMD_BINARY
+#undef SECUREMR_HOST_SIMD_LANEWISE
+
+#endif
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_SIMD_H_
@@ -0,0 +1,603 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "smallmat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace SecureMR::Host {
+
+namespace {
+
+// Below this many items a batch runs on the calling thread: a 4x4 kernel takes tens of nanoseconds
+constexpr size_t BATCH_GRAIN = 256;
+constexpr int JACOBI_MAX_SWEEPS = 30;
+
+template <int N>
+double Determinant(const double* m) {
+  if constexpr (N == 2) {
+    return m[0] * m[3] - m[1] * m[2];
+  } else if constexpr (N == 3) {
+    return m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6]) +
+           m[2] * (m[3] * m[7] - m[4] * m[6]);
+  } else {
+    static_assert(N == 4, "closed-form determinant only for N <= 4");
+    const double s0 = m[0] * m[5] - m[4] * m[1], s1 = m[0] * m[6] - m[4] * m[2], s2 = m[0] * m[7] - m[4] * m[3];
+    const double s3 = m[1] * m[6] - m[5] * m[2], s4 = m[1] * m[7] - m[5] * m[3], s5 = m[2] * m[7] - m[6] * m[3];
+    const double c5 = m[10] * m[15] - m[14] * m[11], c4 = m[9] * m[15] - m[13] * m[11];
+    const double c3 = m[9] * m[14] - m[13] * m[10], c2 = m[8] * m[15] - m[12] * m[11];
+    const double c1 = m[8] * m[14] - m[12] * m[10], c0 = m[8] * m[13] - m[12] * m[9];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  }
+}
+
+template <int N>
+bool InvertDouble(const double* m, double* inv) {
+  if constexpr (N == 2) {
+    const double det = Determinant<2>(m);
+    if (std::abs(det) < 1e-300) return false;
+    inv[0] = m[3] / det, inv[1] = -m[1] / det, inv[2] = -m[2] / det, inv[3] = m[0] / det;
+  } else if constexpr (N == 3) {
+    const double det = Determinant<3>(m);
+    if (std::abs(det) < 1e-300) return false;
+    inv[0] = (m[4] * m[8] - m[5] * m[7]) / det, inv[1] = (m[2] * m[7] - m[1] * m[8]) / det;
+    inv[2] = (m[1] * m[5] - m[2] * m[4]) / det, inv[3] = (m[5] * m[6] - m[3] * m[8]) / det;
+    inv[4] = (m[0] * m[8] - m[2] * m[6]) / det, inv[5] = (m[2] * m[3] - m[0] * m[5]) / det;
+    inv[6] = (m[3] * m[7] - m[4] * m[6]) / det, inv[7] = (m[1] * m[6] - m[0] * m[7]) / det;
+    inv[8] = (m[0] * m[4] - m[1] * m[3]) / det;
+  } else {
+    static_assert(N == 4, "closed-form inverse only for N <= 4");
+    // 2x2 sub-determinants of the upper (s) and lower (c) row pairs
+    const double s0 = m[0] * m[5] - m[4] * m[1], s1 = m[0] * m[6] - m[4] * m[2], s2 = m[0] * m[7] - m[4] * m[3];
+    const double s3 = m[1] * m[6] - m[5] * m[2], s4 = m[1] * m[7] - m[5] * m[3], s5 = m[2] * m[7] - m[6] * m[3];
+    const double c5 = m[10] * m[15] - m[14] * m[11], c4 = m[9] * m[15] - m[13] * m[11];
+    const double c3 = m[9] * m[14] - m[13] * m[10], c2 = m[8] * m[15] - m[12] * m[11];
+    const double c1 = m[8] * m[14] - m[12] * m[10], c0 = m[8] * m[13] - m[12] * m[9];
+    const double det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (std::abs(det) < 1e-300) return false;
+    const double d = 1.0 / det;
+    inv[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * d;
+    inv[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * d;
+    inv[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * d;
+    inv[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * d;
+    inv[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * d;
+    inv[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * d;
+    inv[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * d;
+    inv[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * d;
+    inv[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * d;
+    inv[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * d;
+    inv[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * d;
+    inv[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * d;
+    inv[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * d;
+    inv[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * d;
+    inv[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * d;
+    inv[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * d;
+  }
+  return true;
+}
+
+/**
+ * One-sided (Hestenes) Jacobi SVD of a square N x N matrix: columns of <code>u</code> are rotated pairwise until
+ * they are orthogonal, accumulating the rotations in <code>v</code>. Also serves the 9x9 and 12x12 normal matrices
+ * of the PnP DLT, where only the right singular vectors are needed.
+ */
+template <int N>
+void JacobiSvd(const double* src, double* w, double* u, double* v) {
+  std::copy(src, src + N * N, u);
+  for (int i = 0; i < N * N; ++i) v[i] = (i % (N + 1) == 0) ? 1.0 : 0.0;
+
+  for (int sweep = 0; sweep < JACOBI_MAX_SWEEPS; ++sweep) {
+    bool rotated = false;
+    for (int p = 0; p < N - 1; ++p) {
+      for (int q = p + 1; q < N; ++q) {
+        double alpha = 0.0, beta = 0.0, gamma = 0.0;
+        for (int i = 0; i < N; ++i) {
+          alpha += u[i * N + p] * u[i * N + p];
+          beta += u[i * N + q] * u[i * N + q];
+          gamma += u[i * N + p] * u[i * N + q];
+        }
+        if (std::abs(gamma) <= 1e-15 * std::sqrt(alpha * beta)) continue;
+        rotated = true;
+        const double zeta = (beta - alpha) / (2.0 * gamma);
+        const double t = std::copysign(1.0, zeta) / (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+        const double c = 1.0 / std::sqrt(1.0 + t * t);
+        const double s = c * t;
+        for (int i = 0; i < N; ++i) {
+          const double up = u[i * N + p], uq = u[i * N + q];
+          u[i * N + p] = c * up - s * uq;
+          u[i * N + q] = s * up + c * uq;
+          const double vp = v[i * N + p], vq = v[i * N + q];
+          v[i * N + p] = c * vp - s * vq;
+          v[i * N + q] = s * vp + c * vq;
+        }
+      }
+    }
+    if (!rotated) break;
+  }
+
+  for (int j = 0; j < N; ++j) {
+    double norm = 0.0;
+    for (int i = 0; i < N; ++i) norm += u[i * N + j] * u[i * N + j];
+    w[j] = std::sqrt(norm);
+  }
+  // Descending singular values, permuting the columns of u and v alike
+  for (int j = 0; j < N - 1; ++j) {
+    const int largest = static_cast<int>(std::max_element(w + j, w + N) - w);
+    if (largest == j) continue;
+    std::swap(w[j], w[largest]);
+    for (int i = 0; i < N; ++i) {
+      std::swap(u[i * N + j], u[i * N + largest]);
+      std::swap(v[i * N + j], v[i * N + largest]);
+    }
+  }
+  // Normalize u; complete the columns of a rank-deficient input to an orthonormal basis
+  const double tiny = 1e-12 * std::max(w[0], 1e-300);
+  for (int j = 0; j < N; ++j) {
+    if (w[j] > tiny) {
+      for (int i = 0; i < N; ++i) u[i * N + j] /= w[j];
+      continue;
+    }
+    for (int candidate = 0; candidate < N; ++candidate) {
+      double column[N] = {};
+      column[candidate] = 1.0;
+      for (int k = 0; k < j; ++k) {
+        double dot = 0.0;
+        for (int i = 0; i < N; ++i) dot += column[i] * u[i * N + k];
+        for (int i = 0; i < N; ++i) column[i] -= dot * u[i * N + k];
+      }
+      double norm = 0.0;
+      for (int i = 0; i < N; ++i) norm += column[i] * column[i];
+      if (norm > 1e-6) {
+        for (int i = 0; i < N; ++i) u[i * N + j] = column[i] / std::sqrt(norm);
+        break;
+      }
+    }
+  }
+}
+
+template <int N>
+void Multiply(const float* a, const float* b, float* result) {
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      float sum = 0.0f;
+      for (int k = 0; k < N; ++k) sum += a[i * N + k] * b[k * N + j];
+      result[i * N + j] = sum;
+    }
+  }
+}
+
+void RodriguesDouble(const double r[3], double rotation[9]) {
+  const double theta = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+  if (theta < 1e-12) {
+    // First-order expansion: I + [r]x
+    const double m[9] = {1.0, -r[2], r[1], r[2], 1.0, -r[0], -r[1], r[0], 1.0};
+    std::copy(m, m + 9, rotation);
+    return;
+  }
+  const double kx = r[0] / theta, ky = r[1] / theta, kz = r[2] / theta;
+  const double c = std::cos(theta), s = std::sin(theta), t = 1.0 - c;
+  const double m[9] = {c + t * kx * kx,      t * kx * ky - s * kz, t * kx * kz + s * ky,
+                       t * kx * ky + s * kz, c + t * ky * ky,      t * ky * kz - s * kx,
+                       t * kx * kz - s * ky, t * ky * kz + s * kx, c + t * kz * kz};
+  std::copy(m, m + 9, rotation);
+}
+
+void MatrixToRodrigues(const double rotation[9], double r[3]) {
+  const double* m = rotation;
+  const double cosTheta = std::clamp((m[0] + m[4] + m[8] - 1.0) / 2.0, -1.0, 1.0);
+  const double theta = std::acos(cosTheta);
+  const double skew[3] = {m[7] - m[5], m[2] - m[6], m[3] - m[1]};
+  if (theta < 1e-9) {
+    for (int i = 0; i < 3; ++i) r[i] = 0.5 * skew[i];
+    return;
+  }
+  if (M_PI - theta < 1e-6) {
+    // Near a half turn the skew part vanishes: take the axis from the diagonal of (R + I) / 2
+    double axis[3];
+    for (int i = 0; i < 3; ++i) axis[i] = std::sqrt(std::max(0.0, (m[i * 4] + 1.0) / 2.0));
+    const int major = static_cast<int>(std::max_element(axis, axis + 3) - axis);
+    for (int i = 0; i < 3; ++i) {
+      if (i != major && m[major * 3 + i] < 0.0) axis[i] = -axis[i];
+    }
+    for (int i = 0; i < 3; ++i) r[i] = axis[i] * theta;
+    return;
+  }
+  const double factor = theta / (2.0 * std::sin(theta));
+  for (int i = 0; i < 3; ++i) r[i] = factor * skew[i];
+}
+
+/**
+ * Nearest rotation to a 3x3 matrix, <code>U * V^T</code> of its SVD
+ */
+void Orthonormalize(const double* m, double* rotation) {
+  double w[3], u[9], v[9];
+  JacobiSvd<3>(m, w, u, v);
+  if (Determinant<3>(u) * Determinant<3>(v) < 0.0) {
+    for (int i = 0; i < 3; ++i) u[i * 3 + 2] = -u[i * 3 + 2];
+  }
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      rotation[i * 3 + j] = u[i * 3] * v[j * 3] + u[i * 3 + 1] * v[j * 3 + 1] + u[i * 3 + 2] * v[j * 3 + 2];
+    }
+  }
+}
+
+/**
+ * Gaussian elimination with partial pivoting for the 6x6 Levenberg-Marquardt steps
+ */
+bool Solve6(double a[36], double b[6]) {
+  for (int col = 0; col < 6; ++col) {
+    int pivot = col;
+    for (int row = col + 1; row < 6; ++row) {
+      if (std::abs(a[row * 6 + col]) > std::abs(a[pivot * 6 + col])) pivot = row;
+    }
+    if (std::abs(a[pivot * 6 + col]) < 1e-300) return false;
+    if (pivot != col) {
+      for (int k = 0; k < 6; ++k) std::swap(a[col * 6 + k], a[pivot * 6 + k]);
+      std::swap(b[col], b[pivot]);
+    }
+    for (int row = col + 1; row < 6; ++row) {
+      const double factor = a[row * 6 + col] / a[col * 6 + col];
+      for (int k = col; k < 6; ++k) a[row * 6 + k] -= factor * a[col * 6 + k];
+      b[row] -= factor * b[col];
+    }
+  }
+  for (int row = 5; row >= 0; --row) {
+    for (int k = row + 1; k < 6; ++k) b[row] -= a[row * 6 + k] * b[k];
+    b[row] /= a[row * 6 + row];
+  }
+  return true;
+}
+
+struct PnPProblem {
+  std::vector<double> object;      // 3 per point
+  std::vector<double> normalized;  // 2 per point, image points with the intrinsics removed
+
+  /**
+   * Residuals of the pose (rvec, t) in normalized image coordinates; returns the squared error
+   */
+  double residuals(const double pose[6], double* out) const {
+    double rotation[9];
+    RodriguesDouble(pose, rotation);
+    double error = 0.0;
+    const size_t count = normalized.size() / 2;
+    for (size_t i = 0; i < count; ++i) {
+      const double* x = object.data() + 3 * i;
+      double camera[3];
+      for (int r = 0; r < 3; ++r) {
+        camera[r] = rotation[r * 3] * x[0] + rotation[r * 3 + 1] * x[1] + rotation[r * 3 + 2] * x[2] + pose[3 + r];
+      }
+      const double z = std::max(camera[2], 1e-9);
+      out[2 * i] = camera[0] / z - normalized[2 * i];
+      out[2 * i + 1] = camera[1] / z - normalized[2 * i + 1];
+      error += out[2 * i] * out[2 * i] + out[2 * i + 1] * out[2 * i + 1];
+    }
+    return error;
+  }
+};
+
+/**
+ * Initial pose by DLT: a homography for (near-)planar objects or fewer than 6 points, a full projection matrix
+ * otherwise
+ */
+bool InitialPose(const PnPProblem& problem, double rotation[9], double t[3]) {
+  const size_t count = problem.normalized.size() / 2;
+  double centroid[3] = {};
+  for (size_t i = 0; i < count; ++i) {
+    for (int k = 0; k < 3; ++k) centroid[k] += problem.object[3 * i + k] / static_cast<double>(count);
+  }
+  double covariance[9] = {};
+  for (size_t i = 0; i < count; ++i) {
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) {
+        covariance[r * 3 + c] +=
+            (problem.object[3 * i + r] - centroid[r]) * (problem.object[3 * i + c] - centroid[c]);
+      }
+    }
+  }
+  double spread[3], axes[9], unused[9];
+  JacobiSvd<3>(covariance, spread, unused, axes);
+  if (spread[1] <= 1e-12 * std::max(spread[0], 1e-300)) return false;  // collinear
+  const bool planar = count < 6 || spread[2] <= 1e-6 * spread[0];
+
+  double cameraRotation[9];
+  if (planar) {
+    // Plane frame: rows are the two in-plane axes and the normal, made right-handed
+    double plane[9];
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) plane[r * 3 + c] = axes[c * 3 + r];
+    }
+    if (Determinant<3>(plane) < 0.0) {
+      for (int c = 0; c < 3; ++c) plane[6 + c] = -plane[6 + c];
+    }
+    double normal[81] = {};
+    for (size_t i = 0; i < count; ++i) {
+      double q[2];
+      for (int r = 0; r < 2; ++r) {
+        q[r] = 0.0;
+        for (int c = 0; c < 3; ++c) q[r] += plane[r * 3 + c] * (problem.object[3 * i + c] - centroid[c]);
+      }
+      const double x = problem.normalized[2 * i], y = problem.normalized[2 * i + 1];
+      const double rows[2][9] = {{q[0], q[1], 1.0, 0.0, 0.0, 0.0, -x * q[0], -x * q[1], -x},
+                                 {0.0, 0.0, 0.0, q[0], q[1], 1.0, -y * q[0], -y * q[1], -y}};
+      for (const auto& row : rows) {
+        for (int r = 0; r < 9; ++r) {
+          for (int c = 0; c < 9; ++c) normal[r * 9 + c] += row[r] * row[c];
+        }
+      }
+    }
+    double w[9], u[81], v[81];
+    JacobiSvd<9>(normal, w, u, v);
+    double h[9];
+    for (int k = 0; k < 9; ++k) h[k] = v[k * 9 + 8];
+    const double norm1 = std::sqrt(h[0] * h[0] + h[3] * h[3] + h[6] * h[6]);
+    const double norm2 = std::sqrt(h[1] * h[1] + h[4] * h[4] + h[7] * h[7]);
+    if (norm1 + norm2 < 1e-300) return false;
+    double lambda = 2.0 / (norm1 + norm2);
+    if (h[8] * lambda < 0.0) lambda = -lambda;  // the centroid must lie in front of the camera
+    const double r1[3] = {h[0] * lambda, h[3] * lambda, h[6] * lambda};
+    const double r2[3] = {h[1] * lambda, h[4] * lambda, h[7] * lambda};
+    const double r3[3] = {r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0]};
+    const double approximate[9] = {r1[0], r2[0], r3[0], r1[1], r2[1], r3[1], r1[2], r2[2], r3[2]};
+    double planeRotation[9];
+    Orthonormalize(approximate, planeRotation);
+    for (int k = 0; k < 3; ++k) t[k] = h[2 + 3 * k] * lambda;
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) {
+        cameraRotation[r * 3 + c] = planeRotation[r * 3] * plane[c] + planeRotation[r * 3 + 1] * plane[3 + c] +
+                                    planeRotation[r * 3 + 2] * plane[6 + c];
+      }
+    }
+  } else {
+    double normal[144] = {};
+    for (size_t i = 0; i < count; ++i) {
+      const double X = problem.object[3 * i] - centroid[0];
+      const double Y = problem.object[3 * i + 1] - centroid[1];
+      const double Z = problem.object[3 * i + 2] - centroid[2];
+      const double x = problem.normalized[2 * i], y = problem.normalized[2 * i + 1];
+      const double rows[2][12] = {{X, Y, Z, 1.0, 0.0, 0.0, 0.0, 0.0, -x * X, -x * Y, -x * Z, -x},
+                                  {0.0, 0.0, 0.0, 0.0, X, Y, Z, 1.0, -y * X, -y * Y, -y * Z, -y}};
+      for (const auto& row : rows) {
+        for (int r = 0; r < 12; ++r) {
+          for (int c = 0; c < 12; ++c) normal[r * 12 + c] += row[r] * row[c];
+        }
+      }
+    }
+    double w[12], u[144], v[144];
+    JacobiSvd<12>(normal, w, u, v);
+    double p[12];
+    for (int k = 0; k < 12; ++k) p[k] = v[k * 12 + 11];
+    if (p[11] < 0.0) {
+      for (double& each : p) each = -each;
+    }
+    const double m[9] = {p[0], p[1], p[2], p[4], p[5], p[6], p[8], p[9], p[10]};
+    double singular[3], mu[9], mv[9];
+    JacobiSvd<3>(m, singular, mu, mv);
+    const double scale = (singular[0] + singular[1] + singular[2]) / 3.0;
+    if (scale < 1e-300) return false;
+    Orthonormalize(m, cameraRotation);
+    for (int k = 0; k < 3; ++k) t[k] = p[4 * k + 3] / scale;
+  }
+
+  // Both estimates are relative to the centroid: X_cam = R (X - c) + t
+  std::copy(cameraRotation, cameraRotation + 9, rotation);
+  for (int r = 0; r < 3; ++r) {
+    t[r] -= rotation[r * 3] * centroid[0] + rotation[r * 3 + 1] * centroid[1] + rotation[r * 3 + 2] * centroid[2];
+  }
+  return true;
+}
+
+void RefinePose(const PnPProblem& problem, double pose[6]) {
+  const size_t residualCount = problem.normalized.size();
+  std::vector<double> residual(residualCount), shifted(residualCount), jacobian(residualCount * 6);
+  double error = problem.residuals(pose, residual.data());
+  double damping = 1e-3;
+
+  for (int iteration = 0; iteration < 30 && error > 1e-24; ++iteration) {
+    for (int k = 0; k < 6; ++k) {
+      double probe[6];
+      std::copy(pose, pose + 6, probe);
+      const double step = 1e-7 * std::max(1.0, std::abs(pose[k]));
+      probe[k] += step;
+      problem.residuals(probe, shifted.data());
+      for (size_t i = 0; i < residualCount; ++i) jacobian[i * 6 + k] = (shifted[i] - residual[i]) / step;
+    }
+    double jtj[36] = {}, jtr[6] = {};
+    for (size_t i = 0; i < residualCount; ++i) {
+      for (int r = 0; r < 6; ++r) {
+        jtr[r] += jacobian[i * 6 + r] * residual[i];
+        for (int c = 0; c < 6; ++c) jtj[r * 6 + c] += jacobian[i * 6 + r] * jacobian[i * 6 + c];
+      }
+    }
+
+    bool improved = false;
+    while (!improved && damping < 1e12) {
+      double a[36], delta[6];
+      std::copy(jtj, jtj + 36, a);
+      for (int k = 0; k < 6; ++k) {
+        a[k * 7] += damping * std::max(jtj[k * 7], 1e-12);
+        delta[k] = -jtr[k];
+      }
+      if (!Solve6(a, delta)) {
+        damping *= 10.0;
+        continue;
+      }
+      double candidate[6];
+      for (int k = 0; k < 6; ++k) candidate[k] = pose[k] + delta[k];
+      const double candidateError = problem.residuals(candidate, shifted.data());
+      if (candidateError < error) {
+        std::copy(candidate, candidate + 6, pose);
+        residual.swap(shifted);
+        const double decrease = error - candidateError;
+        error = candidateError;
+        damping = std::max(damping / 10.0, 1e-12);
+        improved = true;
+        if (decrease < 1e-14 * error) return;
+      } else {
+        damping *= 10.0;
+      }
+    }
+    if (!improved) return;
+  }
+}
+
+}  // namespace
+
+template <int N>
+bool Invert(const float* src, float* dst) {
+  double m[N * N], inv[N * N];
+  std::copy(src, src + N * N, m);
+  if (!InvertDouble<N>(m, inv)) {
+    std::fill(dst, dst + N * N, 0.0f);
+    return false;
+  }
+  std::copy(inv, inv + N * N, dst);
+  return true;
+}
+
+template <int N>
+size_t InvertBatch(const float* src, float* dst, const size_t count, ThreadPool& pool) {
+  std::atomic<size_t> singular{0};
+  pool.parallelFor(0, count, BATCH_GRAIN, [&](const size_t begin, const size_t end) {
+    size_t local = 0;
+    for (size_t i = begin; i < end; ++i) local += Invert<N>(src + i * N * N, dst + i * N * N) ? 0 : 1;
+    singular += local;
+  });
+  return singular;
+}
+
+template <int N>
+void Svd(const float* src, float* w, float* u, float* vt) {
+  double m[N * N], wd[N], ud[N * N], vd[N * N];
+  std::copy(src, src + N * N, m);
+  JacobiSvd<N>(m, wd, ud, vd);
+  std::copy(wd, wd + N, w);
+  if (u != nullptr) std::copy(ud, ud + N * N, u);
+  if (vt != nullptr) {
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) vt[i * N + j] = static_cast<float>(vd[j * N + i]);
+    }
+  }
+}
+
+template <int N>
+void SvdBatch(const float* src, float* w, float* u, float* vt, const size_t count, ThreadPool& pool) {
+  pool.parallelFor(0, count, BATCH_GRAIN / 4, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      Svd<N>(src + i * N * N, w + i * N, u == nullptr ? nullptr : u + i * N * N,
+             vt == nullptr ? nullptr : vt + i * N * N);
+    }
+  });
+}
+
+template <int N>
+void MultiplyBatch(const float* a, const size_t aCount, const float* b, const size_t bCount, float* result,
+                   ThreadPool& pool) {
+  const size_t count = std::max(aCount, bCount);
+  const size_t aStride = aCount == 1 ? 0 : N * N;
+  const size_t bStride = bCount == 1 ? 0 : N * N;
+  pool.parallelFor(0, count, BATCH_GRAIN, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin; i < end; ++i) Multiply<N>(a + i * aStride, b + i * bStride, result + i * N * N);
+  });
+}
+
+void RodriguesToMatrix(const float rvec[3], float rotation[9]) {
+  const double r[3] = {rvec[0], rvec[1], rvec[2]};
+  double m[9];
+  RodriguesDouble(r, m);
+  std::copy(m, m + 9, rotation);
+}
+
+void Transform(const float rvec[3], const float tvec[3], const float* scale, float result[16]) {
+  float rotation[9];
+  RodriguesToMatrix(rvec, rotation);
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 3; ++c) result[r * 4 + c] = rotation[r * 3 + c] * (scale == nullptr ? 1.0f : scale[c]);
+    result[r * 4 + 3] = tvec[r];
+  }
+  result[12] = result[13] = result[14] = 0.0f;
+  result[15] = 1.0f;
+}
+
+void TransformBatch(const float* rvecs, const size_t rvecCount, const float* tvecs, const size_t tvecCount,
+                    const float* scales, const size_t scaleCount, float* results, const size_t count,
+                    ThreadPool& pool) {
+  const size_t rStride = rvecCount == 1 ? 0 : 3;
+  const size_t tStride = tvecCount == 1 ? 0 : 3;
+  const size_t sStride = scaleCount == 1 ? 0 : 3;
+  pool.parallelFor(0, count, BATCH_GRAIN, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      Transform(rvecs + i * rStride, tvecs + i * tStride, scales == nullptr ? nullptr : scales + i * sStride,
+                results + i * 16);
+    }
+  });
+}
+
+bool SolvePnP(const float* objectPoints, const float* imagePoints, const size_t pointCount,
+              const float cameraMatrix[9], float rvec[3], float tvec[3]) {
+  if (pointCount < 4) return false;
+  const double fx = cameraMatrix[0], cx = cameraMatrix[2], fy = cameraMatrix[4], cy = cameraMatrix[5];
+  PnPProblem problem;
+  problem.object.assign(objectPoints, objectPoints + 3 * pointCount);
+  problem.normalized.resize(2 * pointCount);
+  for (size_t i = 0; i < pointCount; ++i) {
+    problem.normalized[2 * i] = (imagePoints[2 * i] - cx) / fx;
+    problem.normalized[2 * i + 1] = (imagePoints[2 * i + 1] - cy) / fy;
+  }
+
+  double rotation[9], pose[6];
+  if (!InitialPose(problem, rotation, pose + 3)) return false;
+  MatrixToRodrigues(rotation, pose);
+  RefinePose(problem, pose);
+  for (int k = 0; k < 3; ++k) {
+    rvec[k] = static_cast<float>(pose[k]);
+    tvec[k] = static_cast<float>(pose[3 + k]);
+  }
+  return true;
+}
+
+size_t SolvePnPBatch(const float* objectPoints, const float* imagePoints, const size_t pointCount,
+                     const float cameraMatrix[9], float* rvecs, float* tvecs, const size_t count, ThreadPool& pool) {
+  std::atomic<size_t> failed{0};
+  pool.parallelFor(0, count, 4, [&](const size_t begin, const size_t end) {
+    size_t local = 0;
+    for (size_t i = begin; i < end; ++i) {
+      local += SolvePnP(objectPoints + i * pointCount * 3, imagePoints + i * pointCount * 2, pointCount,
+                        cameraMatrix, rvecs + i * 3, tvecs + i * 3)
+                   ? 0
+                   : 1;
+    }
+    failed += local;
+  });
+  return failed;
+}
+
+#define SECUREMR_HOST_INSTANTIATE_SMALLMAT(N)                                                      \
+  template bool Invert<N>(const float*, float*);                                                   \
+  template size_t InvertBatch<N>(const float*, float*, size_t, ThreadPool&);                       \
+  template void Svd<N>(const float*, float*, float*, float*);                                      \
+  template void SvdBatch<N>(const float*, float*, float*, float*, size_t, ThreadPool&);            \
+  template void MultiplyBatch<N>(const float*, size_t, const float*, size_t, float*, ThreadPool&);
+
+SECUREMR_HOST_INSTANTIATE_SMALLMAT(2)
+SECUREMR_HOST_INSTANTIATE_SMALLMAT(3)
+SECUREMR_HOST_INSTANTIATE_SMALLMAT(4)
+
+#undef SECUREMR_HOST_INSTANTIATE_SMALLMAT
+
+}  // namespace SecureMR::Host
@@ -0,0 +1,104 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_SMALLMAT_H_
+#define SECUREMR_UTILS_HOST_SMALLMAT_H_
+
+#include <cstddef>
+
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * Host kernels for the small fixed-size matrix operators: <code>Pipeline::inversion</code>,
+ * <code>Pipeline::singularValueDecomposition</code>, <code>Pipeline::transform</code>,
+ * <code>Pipeline::solvePnP</code>, and the 4x4 products that follow <code>Pipeline::camSpace2XrLocal</code>.
+ * <br/>
+ * Matrices are row-major floats. The size is a template parameter, so all loops have compile-time bounds and are
+ * fully unrolled; <code>N = 2, 3, 4</code> are instantiated. Every kernel has a batched form taking a contiguous
+ * stack of <code>count</code> matrices, so that a per-node loop of operators, e.g., the 13 skeleton-node transforms
+ * of the pose sample, becomes a single call. Batches are split across the pool once they are large enough to pay off.
+ */
+
+/**
+ * Closed-form (adjugate) inverse
+ * @return false if the matrix is singular, in which case <code>dst</code> is zero-filled
+ */
+template <int N>
+bool Invert(const float* src, float* dst);
+
+/**
+ * @return The number of singular matrices in the batch
+ */
+template <int N>
+size_t InvertBatch(const float* src, float* dst, size_t count, ThreadPool& pool = ThreadPool::Default());
+
+/**
+ * One-sided Jacobi SVD, <code>src = u * diag(w) * vt</code>, with <code>w</code> sorted in descending order as
+ * OpenCV does. <code>u</code> and <code>vt</code> may be <code>nullptr</code>.
+ */
+template <int N>
+void Svd(const float* src, float* w, float* u, float* vt);
+
+template <int N>
+void SvdBatch(const float* src, float* w, float* u, float* vt, size_t count, ThreadPool& pool = ThreadPool::Default());
+
+/**
+ * Stack of matrix products <code>result[i] = a[i] * b[i]</code>; a stack of size 1 on either side is broadcast
+ */
+template <int N>
+void MultiplyBatch(const float* a, size_t aCount, const float* b, size_t bCount, float* result,
+                   ThreadPool& pool = ThreadPool::Default());
+
+/**
+ * Rotation matrix (3x3) of a Rodrigues rotation vector
+ */
+void RodriguesToMatrix(const float rvec[3], float rotation[9]);
+
+/**
+ * The 4x4 matrix <code>[R * diag(scale) | t; 0 0 0 1]</code>, with <code>R</code> from the Rodrigues vector.
+ * <code>scale</code> may be <code>nullptr</code> for a unit scale, same as <code>Pipeline::transform</code>.
+ */
+void Transform(const float rvec[3], const float tvec[3], const float* scale, float result[16]);
+
+/**
+ * Batched <code>Transform</code> over <code>count</code> results. Each input stack holds either
+ * <code>count</code> vectors or a single one which is shared, e.g., one rotation for all skeleton nodes.
+ * <code>scales</code> may be <code>nullptr</code>.
+ */
+void TransformBatch(const float* rvecs, size_t rvecCount, const float* tvecs, size_t tvecCount, const float* scales,
+                    size_t scaleCount, float* results, size_t count, ThreadPool& pool = ThreadPool::Default());
+
+/**
+ * Pose of an object from N >= 4 3D-2D correspondences, same convention as <code>cv::solvePnP</code>: a DLT estimate
+ * (homography-based for planar objects) refined by Levenberg-Marquardt on the reprojection error.
+ * @param objectPoints N (x, y, z) points
+ * @param imagePoints N (u, v) pixels
+ * @return false if the points are degenerate or fewer than 4
+ */
+bool SolvePnP(const float* objectPoints, const float* imagePoints, size_t pointCount, const float cameraMatrix[9],
+              float rvec[3], float tvec[3]);
+
+/**
+ * <code>count</code> independent problems of <code>pointCount</code> points each, sharing the camera matrix
+ * @return The number of problems that failed
+ */
+size_t SolvePnPBatch(const float* objectPoints, const float* imagePoints, size_t pointCount,
+                     const float cameraMatrix[9], float* rvecs, float* tvecs, size_t count,
+                     ThreadPool& pool = ThreadPool::Default());
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_SMALLMAT_H_
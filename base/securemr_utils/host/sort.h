@@ -0,0 +1,86 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_SORT_H_
+#define SECUREMR_UTILS_HOST_SORT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * Host implementations of <code>Pipeline::sortVec</code>, <code>Pipeline::sortMatByRow</code> and
+ * <code>Pipeline::sortMatByColumn</code>.
+ * <br/>
+ * All kernels sort in descending order, same as the SecureMR operators, and break ties by the smaller source index,
+ * so the result is deterministic. Either output pointer may be <code>nullptr</code> if that result is not consumed.
+ * <br/>
+ * <code>topK</code> enables the partial fast path: only the leading <code>topK</code> entries of each sorted
+ * row/column are produced, and the outputs are laid out with <code>topK</code> entries per row/column. This is the
+ * common case of a graph that sorts and then only takes <code>[{0, N}, {0, 1}]</code>, as the yolo sample does with
+ * its 8400x80 score matrix. <code>topK = 0</code> (or any value not smaller than the sorted length) means a full
+ * sort.
+ */
+
+/**
+ * Sort a vector of length <code>n</code>
+ * @param result_sorted <code>min(topK, n)</code> values, or <code>n</code> if <code>topK = 0</code>
+ * @param result_indices indices in <code>src</code> of each value in <code>result_sorted</code>
+ */
+template <typename T>
+void SortVec(const T* src, size_t n, T* result_sorted, int32_t* result_indices, size_t topK = 0);
+
+/**
+ * Sort a row-major <code>rows x cols</code> matrix row by row, parallelized across rows. Float rows no longer than
+ * 16 are sorted four at a time by a SIMD sorting network.
+ * @param result_sorted row-major <code>rows x min(topK, cols)</code> matrix
+ * @param result_indicesPerRow the column indices in <code>src</code> of each value, same layout as
+ *    <code>result_sorted</code>
+ */
+template <typename T>
+void SortMatByRow(const T* src, size_t rows, size_t cols, T* result_sorted, int32_t* result_indicesPerRow,
+                  size_t topK = 0, ThreadPool& pool = ThreadPool::Default());
+
+/**
+ * Sort a row-major <code>rows x cols</code> matrix column by column, parallelized across columns.
+ * @param result_sorted row-major <code>min(topK, rows) x cols</code> matrix
+ * @param result_indicesPerColumn the row indices in <code>src</code> of each value, same layout as
+ *    <code>result_sorted</code>
+ */
+template <typename T>
+void SortMatByColumn(const T* src, size_t rows, size_t cols, T* result_sorted, int32_t* result_indicesPerColumn,
+                     size_t topK = 0, ThreadPool& pool = ThreadPool::Default());
+
+struct SortBenchmarkResult {
+  double kernelMsPerRun = 0.0;
+  double referenceMsPerRun = 0.0;
+  double speedup = 0.0;
+  /**
+   * Whether the kernel produced exactly the same values and indices as the reference
+   */
+  bool matchesReference = false;
+};
+
+/**
+ * Compare <code>SortMatByRow</code> on random float data against a single-threaded <code>std::sort</code> of each
+ * row, e.g., <code>BenchmarkSortRows(8400, 80, 20, 1)</code> for the yolo score matrix.
+ */
+SortBenchmarkResult BenchmarkSortRows(size_t rows, size_t cols, size_t iterations, size_t topK = 0);
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_SORT_H_
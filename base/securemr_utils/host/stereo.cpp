@@ -0,0 +1,252 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stereo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "simd.h"
+
+namespace SecureMR::Host {
+
+namespace {
+
+constexpr int32_t INVALID_COST = std::numeric_limits<int32_t>::max();
+
+inline int32_t Gray(const StereoImage& image, const int x, const int y) {
+  const uint8_t* pixel = image.data + (static_cast<size_t>(y) * image.width + static_cast<size_t>(x)) * image.channels;
+  if (image.channels == 1) return pixel[0];
+  return (pixel[0] * 77 + pixel[1] * 150 + pixel[2] * 29) >> 8;
+}
+
+int DisparityCount(const StereoMatchConfig& config) { return (std::max(config.maxDisparity, 0) + 1 + 3) & ~3; }
+
+/**
+ * Per-worker buffers, so that matching a point allocates nothing once they have grown to size
+ */
+struct MatchScratch {
+  std::vector<int32_t> leftBlock;
+  std::vector<int32_t> rightStrips;
+  std::vector<int32_t> costs;
+};
+
+/**
+ * Sub-pixel disparity of the block around (u, v), or a negative value if there is none
+ */
+float MatchPoint(const StereoImage& left, const StereoImage& right, const StereoMatchConfig& config, const int u,
+                 const int v, MatchScratch& scratch, int* integerDisparity = nullptr) {
+  const int r = config.blockRadius;
+  const int width = static_cast<int>(left.width);
+  const int height = static_cast<int>(left.height);
+  if (u - r < 0 || v - r < 0 || u + r >= width || v + r >= height) return -1.0f;
+
+  const int side = 2 * r + 1;
+  const int disparities = DisparityCount(config);
+  const int lastValid = std::min(disparities - 1, u - r);  // the right block must stay inside the image
+  // Strip k of row dy holds the right-eye gray value at column u + r - k, so that for a fixed left column the
+  // candidates of four consecutive disparities are contiguous
+  const int stripLength = disparities + 2 * r;
+  scratch.leftBlock.resize(static_cast<size_t>(side * side));
+  scratch.rightStrips.resize(static_cast<size_t>(side * stripLength));
+  scratch.costs.resize(static_cast<size_t>(disparities));
+
+  for (int dy = 0; dy < side; ++dy) {
+    const int y = v - r + dy;
+    for (int dx = 0; dx < side; ++dx) scratch.leftBlock[dy * side + dx] = Gray(left, u - r + dx, y);
+    int32_t* strip = scratch.rightStrips.data() + dy * stripLength;
+    for (int k = 0; k < stripLength; ++k) {
+      const int x = u + r - k;
+      strip[k] = x >= 0 ? Gray(right, x, y) : 0;
+    }
+  }
+
+  for (int d = 0; d < disparities; d += 4) {
+    Int4 cost = Int4::Splat(0);
+    for (int dy = 0; dy < side; ++dy) {
+      const int32_t* strip = scratch.rightStrips.data() + dy * stripLength;
+      for (int dx = 0; dx < side; ++dx) {
+        const Int4 l = Int4::Splat(scratch.leftBlock[dy * side + dx]);
+        const Int4 candidates = Int4::Load(strip + (side - 1 - dx) + d);
+        cost = cost + Max(l - candidates, candidates - l);
+      }
+    }
+    cost.store(scratch.costs.data() + d);
+  }
+
+  int best = -1;
+  int32_t bestCost = INVALID_COST;
+  for (int d = 0; d <= lastValid; ++d) {
+    if (scratch.costs[d] < bestCost) {
+      bestCost = scratch.costs[d];
+      best = d;
+    }
+  }
+  if (integerDisparity != nullptr) *integerDisparity = best;
+  if (best <= 0) return -1.0f;
+
+  float refined = static_cast<float>(best);
+  if (best < lastValid) {
+    const auto previous = static_cast<float>(scratch.costs[best - 1]);
+    const auto next = static_cast<float>(scratch.costs[best + 1]);
+    const float denominator = previous - 2.0f * static_cast<float>(bestCost) + next;
+    if (denominator > 0.0f) refined += 0.5f * (previous - next) / denominator;
+  }
+  return refined;
+}
+
+/**
+ * Full-frame disparity map with the same SAD cost and tie-breaking, using one box-filtered difference image per
+ * disparity. Only used as the reference of the benchmark.
+ */
+std::vector<int> DenseDisparity(const StereoImage& left, const StereoImage& right, const StereoMatchConfig& config) {
+  const int width = static_cast<int>(left.width);
+  const int height = static_cast<int>(left.height);
+  const int r = config.blockRadius;
+  std::vector<int32_t> leftGray(left.width * left.height), rightGray(right.width * right.height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      leftGray[y * width + x] = Gray(left, x, y);
+      rightGray[y * width + x] = Gray(right, x, y);
+    }
+  }
+
+  std::vector<int> disparity(left.width * left.height, -1);
+  std::vector<int32_t> bestCost(left.width * left.height, INVALID_COST);
+  std::vector<int64_t> integral(static_cast<size_t>((width + 1) * (height + 1)), 0);
+  for (int d = 0; d < DisparityCount(config); ++d) {
+    for (int y = 0; y < height; ++y) {
+      int64_t rowSum = 0;
+      for (int x = 0; x < width; ++x) {
+        rowSum += x >= d ? std::abs(leftGray[y * width + x] - rightGray[y * width + x - d]) : 0;
+        integral[(y + 1) * (width + 1) + x + 1] = integral[y * (width + 1) + x + 1] + rowSum;
+      }
+    }
+    for (int y = r; y + r < height; ++y) {
+      for (int x = std::max(r, d + r); x + r < width; ++x) {
+        const auto at = [&](const int ix, const int iy) { return integral[iy * (width + 1) + ix]; };
+        const auto cost = static_cast<int32_t>(at(x + r + 1, y + r + 1) - at(x - r, y + r + 1) -
+                                               at(x + r + 1, y - r) + at(x - r, y - r));
+        if (cost < bestCost[y * width + x]) {
+          bestCost[y * width + x] = cost;
+          disparity[y * width + x] = d;
+        }
+      }
+    }
+  }
+  return disparity;
+}
+
+}  // namespace
+
+void Uv2Cam(const int32_t* uv, const size_t pointCount, const float cameraMatrix[9], const StereoImage& left,
+            const StereoImage& right, const StereoMatchConfig& config, float* result_xyz, ThreadPool& pool) {
+  CHECK_MSG(left.width == right.width && left.height == right.height, "Uv2Cam: stereo images differ in size")
+  CHECK_MSG(left.channels >= 1 && left.channels <= 4 && left.channels != 2 && right.channels == left.channels,
+            "Uv2Cam: stereo images must have 1, 3 or 4 channels")
+  CHECK_MSG(config.blockRadius >= 0, "Uv2Cam: negative block radius")
+  const float fx = cameraMatrix[0], cx = cameraMatrix[2];
+  const float fy = cameraMatrix[4], cy = cameraMatrix[5];
+
+  pool.parallelFor(0, pointCount, 4, [&](const size_t begin, const size_t end) {
+    MatchScratch scratch;
+    for (size_t i = begin; i < end; ++i) {
+      const int u = uv[2 * i];
+      const int v = uv[2 * i + 1];
+      float* xyz = result_xyz + 3 * i;
+      const float disparity = MatchPoint(left, right, config, u, v, scratch);
+      if (disparity <= 0.0f) {
+        xyz[0] = xyz[1] = xyz[2] = 0.0f;
+        continue;
+      }
+      const float z = fx * config.baseline / disparity;
+      xyz[0] = (static_cast<float>(u) - cx) * z / fx;
+      xyz[1] = (static_cast<float>(v) - cy) * z / fy;
+      xyz[2] = z;
+    }
+  });
+}
+
+Uv2CamBenchmarkResult BenchmarkUv2Cam(const size_t width, const size_t height, const size_t pointCount,
+                                      const size_t iterations, const StereoMatchConfig& config) {
+  using Clock = std::chrono::steady_clock;
+  const size_t runs = std::max<size_t>(iterations, 1);
+  const int disparities = DisparityCount(config);
+  const int r = config.blockRadius;
+  CHECK_MSG(static_cast<int>(width) > disparities + 2 * r && static_cast<int>(height) > 2 * r,
+            "BenchmarkUv2Cam: image too small for the disparity range")
+
+  // A random texture on a plane slanted along y: row y has the integer disparity groundTruth(y)
+  std::mt19937 rng(0x57e7e0);
+  std::uniform_int_distribution<int> texture(0, 255);
+  const auto groundTruth = [&](const size_t y) {
+    return 4 + static_cast<int>((disparities - 12) * static_cast<double>(y) / static_cast<double>(height));
+  };
+  std::vector<uint8_t> leftData(width * height * 3), rightData(width * height * 3);
+  for (auto& value : leftData) value = static_cast<uint8_t>(texture(rng));
+  for (size_t y = 0; y < height; ++y) {
+    const auto d = static_cast<size_t>(groundTruth(y));
+    for (size_t x = 0; x < width; ++x) {
+      for (size_t c = 0; c < 3; ++c) {
+        rightData[(y * width + x) * 3 + c] =
+            x + d < width ? leftData[(y * width + x + d) * 3 + c] : static_cast<uint8_t>(texture(rng));
+      }
+    }
+  }
+  const StereoImage left{.data = leftData.data(), .width = width, .height = height, .channels = 3};
+  const StereoImage right{.data = rightData.data(), .width = width, .height = height, .channels = 3};
+
+  std::uniform_int_distribution<int> columns(disparities + r, static_cast<int>(width) - r - 1);
+  std::uniform_int_distribution<int> rows(r, static_cast<int>(height) - r - 1);
+  std::vector<int32_t> uv(pointCount * 2);
+  for (size_t i = 0; i < pointCount; ++i) {
+    uv[2 * i] = columns(rng);
+    uv[2 * i + 1] = rows(rng);
+  }
+  const float cameraMatrix[9] = {width / 2.0f, 0.0f, width / 2.0f, 0.0f, width / 2.0f, height / 2.0f, 0.0f, 0.0f, 1.0f};
+  std::vector<float> xyz(pointCount * 3);
+
+  const auto sparseStart = Clock::now();
+  for (size_t run = 0; run < runs; ++run) {
+    Uv2Cam(uv.data(), pointCount, cameraMatrix, left, right, config, xyz.data());
+  }
+  const auto sparseEnd = Clock::now();
+  const std::vector<int> dense = DenseDisparity(left, right, config);
+  const auto denseEnd = Clock::now();
+
+  Uv2CamBenchmarkResult result;
+  result.sparseMsPerRun = std::chrono::duration<double, std::milli>(sparseEnd - sparseStart).count() / runs;
+  result.sparseUsPerPoint = pointCount > 0 ? result.sparseMsPerRun * 1e3 / pointCount : 0.0;
+  result.denseMsPerRun = std::chrono::duration<double, std::milli>(denseEnd - sparseEnd).count();
+
+  MatchScratch scratch;
+  size_t agreeing = 0;
+  double errorSum = 0.0;
+  for (size_t i = 0; i < pointCount; ++i) {
+    int integerDisparity = -1;
+    const float disparity = MatchPoint(left, right, config, uv[2 * i], uv[2 * i + 1], scratch, &integerDisparity);
+    agreeing += integerDisparity == dense[uv[2 * i + 1] * width + uv[2 * i]] ? 1 : 0;
+    errorSum += std::abs(disparity - static_cast<float>(groundTruth(uv[2 * i + 1])));
+  }
+  result.agreementWithDense = pointCount > 0 ? static_cast<double>(agreeing) / pointCount : 0.0;
+  result.meanDisparityError = pointCount > 0 ? errorSum / pointCount : 0.0;
+  return result;
+}
+
+}  // namespace SecureMR::Host
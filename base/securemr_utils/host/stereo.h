@@ -0,0 +1,92 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_STEREO_H_
+#define SECUREMR_UTILS_HOST_STEREO_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * An interleaved uint8 image with 1, 3 or 4 channels, as produced by <code>Pipeline::cameraAccess</code>
+ */
+struct StereoImage {
+  const uint8_t* data = nullptr;
+  size_t width = 0;
+  size_t height = 0;
+  size_t channels = 3;
+};
+
+struct StereoMatchConfig {
+  /**
+   * Distance between the left-eye and right-eye cameras, in meters; the unit of the result follows this one
+   */
+  float baseline = 0.064f;
+  /**
+   * Largest disparity searched, in pixels. The search covers [0, maxDisparity], extended at the top so that its
+   * length is a multiple of 4.
+   */
+  int maxDisparity = 96;
+  /**
+   * Half size of the square SAD block, i.e., the block is <code>(2r + 1) x (2r + 1)</code>
+   */
+  int blockRadius = 3;
+};
+
+/**
+ * Host implementation of <code>Pipeline::uv2Cam</code> for a rectified stereo pair.
+ * <br/>
+ * Instead of computing a dense disparity map, the disparity is only searched for the block around each queried
+ * point: the right-eye scanline strip that can match it is converted to gray once, and the SAD costs of four
+ * disparities are accumulated per vector operation. The integer minimum is refined to sub-pixel precision with a
+ * parabola fit, and the point is back-projected with the pinhole camera matrix. Points are distributed across the
+ * pool.
+ *
+ * @param uv N points as (column, row) pairs, i.e., the layout of a 1D 2-channel int32 tensor
+ * @param cameraMatrix row-major 3x3 pinhole intrinsics <code>{fx, 0, cx, 0, fy, cy, 0, 0, 1}</code> of the left eye
+ * @param result_xyz N (x, y, z) points in left-eye camera space. Points too close to the border for a full block,
+ *                   or without a positive disparity, are set to (0, 0, 0).
+ */
+void Uv2Cam(const int32_t* uv, size_t pointCount, const float cameraMatrix[9], const StereoImage& left,
+            const StereoImage& right, const StereoMatchConfig& config, float* result_xyz,
+            ThreadPool& pool = ThreadPool::Default());
+
+struct Uv2CamBenchmarkResult {
+  double sparseMsPerRun = 0.0;
+  double sparseUsPerPoint = 0.0;
+  double denseMsPerRun = 0.0;
+  /**
+   * Fraction of points whose integer disparity equals the one of the dense reference
+   */
+  double agreementWithDense = 0.0;
+  /**
+   * Mean absolute error of the sub-pixel disparity against the synthetic ground truth, in pixels
+   */
+  double meanDisparityError = 0.0;
+};
+
+/**
+ * Compare <code>Uv2Cam</code> against a dense full-frame block matcher with the same cost, on a synthetic stereo pair
+ * of a textured slanted plane, e.g., <code>BenchmarkUv2Cam(640, 640, 32, 20)</code>.
+ */
+Uv2CamBenchmarkResult BenchmarkUv2Cam(size_t width, size_t height, size_t pointCount, size_t iterations,
+                                      const StereoMatchConfig& config = {});
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_STEREO_H_
@@ -0,0 +1,68 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_TENSORVIEW_H_
+#define SECUREMR_UTILS_HOST_TENSORVIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "openxr/openxr.h"
+
+namespace SecureMR::Host {
+
+/**
+ * A non-owning view of a dense, row-major tensor in host memory, for the kernels that accept any data type.
+ * <br/>
+ * <code>shape</code> lists the dimensions followed by the channels, i.e., a tensor with
+ * <code>TensorAttribute{.dimensions = {640, 640}, .channels = 3}</code> has <code>shape = {640, 640, 3}</code>.
+ */
+template <typename Pointer>
+struct BasicTensorView {
+  Pointer data = nullptr;
+  XrSecureMrTensorDataTypePICO dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO;
+  std::vector<size_t> shape;
+
+  [[nodiscard]] size_t elementCount() const {
+    return std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<>());
+  }
+};
+
+using TensorView = BasicTensorView<void*>;
+using ConstTensorView = BasicTensorView<const void*>;
+
+inline size_t DataTypeSize(const XrSecureMrTensorDataTypePICO dataType) {
+  switch (dataType) {
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+      return 1;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
+      return 2;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
+      return 4;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_TENSORVIEW_H_
@@ -0,0 +1,127 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "threadpool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace SecureMR::Host {
+
+namespace {
+
+// The pool whose chunk the current thread is executing, if any
+thread_local const ThreadPool* runningPool = nullptr;
+
+}  // namespace
+
+ThreadPool::ThreadPool(const size_t workerCount) {
+  m_workers.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    m_workers.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_stopping = true;
+  }
+  m_jobReady.notify_all();
+  for (auto& worker : m_workers) {
+    if (worker.joinable()) worker.join();
+  }
+}
+
+ThreadPool& ThreadPool::Default() {
+  static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+void ThreadPool::parallelFor(const size_t begin, const size_t end, const size_t grain,
+                             const std::function<void(size_t, size_t)>& body) {
+  if (begin >= end) return;
+  const size_t total = end - begin;
+  // Aim at a few chunks per thread for load balancing, but never below the requested grain
+  const size_t chunks = concurrency() * 4;
+  const size_t chunk = std::max<size_t>(std::max<size_t>(grain, 1), (total + chunks - 1) / chunks);
+  // A nested call from a chunk would wait for the job its own chunk belongs to
+  if (m_workers.empty() || total <= chunk || runningPool == this) {
+    body(begin, end);
+    return;
+  }
+
+  // One job at a time: concurrent callers (e.g. pipelines run from several threads) queue up here
+  std::lock_guard<std::mutex> submitGuard(m_submitMutex);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_job = Job{.body = &body,
+              .begin = begin,
+              .end = end,
+              .chunk = chunk,
+              .nextChunk = 0,
+              .chunkCount = (total + chunk - 1) / chunk,
+              .finishedChunks = 0,
+              .error = nullptr};
+  ++m_generation;
+  m_jobReady.notify_all();
+  drain(lock);
+  m_jobDone.wait(lock, [this]() { return m_job.finishedChunks == m_job.chunkCount; });
+  m_job.body = nullptr;
+  if (const auto error = std::exchange(m_job.error, nullptr)) {
+    lock.unlock();
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::drain(std::unique_lock<std::mutex>& lock) {
+  while (m_job.body != nullptr && m_job.nextChunk < m_job.chunkCount) {
+    const size_t index = m_job.nextChunk++;
+    const size_t chunkBegin = m_job.begin + index * m_job.chunk;
+    const size_t chunkEnd = std::min(m_job.end, chunkBegin + m_job.chunk);
+    const auto* body = m_job.body;
+    lock.unlock();
+    std::exception_ptr error;
+    // Restore the pool of an enclosing chunk, so that its nested parallelFor calls still run inline
+    const ThreadPool* const outerPool = std::exchange(runningPool, this);
+    try {
+      (*body)(chunkBegin, chunkEnd);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    runningPool = outerPool;
+    lock.lock();
+    if (error != nullptr) {
+      if (m_job.error == nullptr) m_job.error = error;
+      // Drop the chunks not claimed yet, as done
+      m_job.finishedChunks += m_job.chunkCount - m_job.nextChunk;
+      m_job.nextChunk = m_job.chunkCount;
+    }
+    if (++m_job.finishedChunks == m_job.chunkCount) {
+      m_jobDone.notify_all();
+    }
+  }
+}
+
+void ThreadPool::workerLoop() {
+  size_t seenGeneration = 0;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_jobReady.wait(lock, [&]() { return m_stopping || m_generation != seenGeneration; });
+    if (m_stopping) return;
+    seenGeneration = m_generation;
+    drain(lock);
+  }
+}
+
+}  // namespace SecureMR::Host
@@ -0,0 +1,92 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_THREADPOOL_H_
+#define SECUREMR_UTILS_HOST_THREADPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SecureMR::Host {
+
+/**
+ * A fixed-size worker pool used by the host kernels to split work across cores.
+ * <br/>
+ * The pool only offers a blocking <code>parallelFor</code>: the calling thread takes part in the work and returns
+ * once every chunk is done, so kernels keep the same synchronous semantics as a single-threaded implementation.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param workerCount Number of background workers. The calling thread of <code>parallelFor</code> also executes
+   *                    chunks, hence <code>workerCount = N - 1</code> fully occupies N cores.
+   */
+  explicit ThreadPool(size_t workerCount);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * The process-wide pool, sized to the number of hardware threads
+   */
+  static ThreadPool& Default();
+
+  [[nodiscard]] size_t concurrency() const { return m_workers.size() + 1; }
+
+  /**
+   * Run <code>body(chunkBegin, chunkEnd)</code> over [begin, end), split into chunks of at least
+   * <code>grain</code> items. Returns after all chunks have been executed.
+   * <br/>
+   * If a chunk throws, the chunks not started yet are dropped and the first exception is rethrown to the caller
+   * once the running ones are done. A <code>parallelFor</code> nested in a chunk runs inline on its thread.
+   */
+  void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+ private:
+  struct Job {
+    const std::function<void(size_t, size_t)>* body = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+    size_t chunk = 1;
+    size_t nextChunk = 0;
+    size_t chunkCount = 0;
+    size_t finishedChunks = 0;
+    std::exception_ptr error;
+  };
+
+  void workerLoop();
+  /**
+   * Claim and execute chunks of the current job until none are left. Must be called with <code>lock</code> held.
+   */
+  void drain(std::unique_lock<std::mutex>& lock);
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_jobReady;
+  std::condition_variable m_jobDone;
+  std::mutex m_submitMutex;
+  Job m_job;
+  size_t m_generation = 0;
+  bool m_stopping = false;
+};
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_THREADPOOL_H_
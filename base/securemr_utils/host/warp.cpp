@@ -0,0 +1,190 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "warp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "check.h"
+#include "simd.h"
+
+namespace SecureMR::Host {
+
+namespace {
+
+constexpr size_t TILE_WIDTH = 64;
+constexpr size_t TILE_HEIGHT = 16;
+constexpr size_t MAX_CHANNELS = 4;
+
+struct WarpGeometry {
+  // destination-to-source mapping: sx = m[0] * x + m[1] * y + m[2], sy = m[3] * x + m[4] * y + m[5]
+  double m[6];
+  size_t srcWidth, srcHeight, channels, dstWidth, dstHeight;
+};
+
+template <typename T>
+void WarpTile(const WarpGeometry& g, const T* src, T* dst, const size_t x0, const size_t x1, const size_t y0,
+              const size_t y1) {
+  const size_t channels = g.channels;
+  const auto srcWidth = static_cast<int32_t>(g.srcWidth);
+  const auto srcHeight = static_cast<int32_t>(g.srcHeight);
+  const float laneSteps[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+  const Float4 laneIndex = Float4::Load(laneSteps);
+  const Float4 stepX = Float4::Splat(static_cast<float>(g.m[0]));
+  const Float4 stepY = Float4::Splat(static_cast<float>(g.m[3]));
+
+  alignas(16) int32_t ix[4], iy[4];
+  alignas(16) float taps[4][MAX_CHANNELS][4];  // [tap][channel][lane], taps ordered 00, 01, 10, 11
+  alignas(16) float laneResult[4];
+  alignas(16) int32_t laneResultInt[4];
+
+  for (size_t y = y0; y < y1; ++y) {
+    // Per-row affine increments: the row start is evaluated once, every further pixel only adds the column step
+    const double rowSx = g.m[0] * static_cast<double>(x0) + g.m[1] * static_cast<double>(y) + g.m[2];
+    const double rowSy = g.m[3] * static_cast<double>(x0) + g.m[4] * static_cast<double>(y) + g.m[5];
+    T* dstRow = dst + (y * g.dstWidth) * channels;
+
+    for (size_t x = x0; x < x1; x += 4) {
+      const auto offset = static_cast<float>(x - x0);
+      const Float4 sx =
+          MulAdd(Float4::Splat(static_cast<float>(rowSx)), Float4::Splat(offset) + laneIndex, stepX);
+      const Float4 sy =
+          MulAdd(Float4::Splat(static_cast<float>(rowSy)), Float4::Splat(offset) + laneIndex, stepY);
+      const Float4 fx = Floor(sx);
+      const Float4 fy = Floor(sy);
+      const Float4 wx = sx - fx;
+      const Float4 wy = sy - fy;
+      Int4::FromFloatTrunc(fx).store(ix);
+      Int4::FromFloatTrunc(fy).store(iy);
+
+      const size_t lanes = std::min<size_t>(4, x1 - x);
+      bool interior = true;
+      for (size_t lane = 0; lane < lanes; ++lane) {
+        interior = interior && ix[lane] >= 0 && iy[lane] >= 0 && ix[lane] + 1 < srcWidth && iy[lane] + 1 < srcHeight;
+      }
+
+      for (size_t lane = 0; lane < 4; ++lane) {
+        for (size_t tap = 0; tap < 4; ++tap) {
+          const int32_t tx = ix[lane] + static_cast<int32_t>(tap & 1);
+          const int32_t ty = iy[lane] + static_cast<int32_t>(tap >> 1);
+          const bool inside =
+              lane < lanes && (interior || (tx >= 0 && ty >= 0 && tx < srcWidth && ty < srcHeight));
+          const T* pixel = inside ? src + (static_cast<size_t>(ty) * g.srcWidth + static_cast<size_t>(tx)) * channels
+                                  : nullptr;
+          for (size_t c = 0; c < channels; ++c) {
+            taps[tap][c][lane] = pixel != nullptr ? static_cast<float>(pixel[c]) : 0.0f;
+          }
+        }
+      }
+
+      for (size_t c = 0; c < channels; ++c) {
+        const Float4 p00 = Float4::Load(taps[0][c]);
+        const Float4 p01 = Float4::Load(taps[1][c]);
+        const Float4 p10 = Float4::Load(taps[2][c]);
+        const Float4 p11 = Float4::Load(taps[3][c]);
+        const Float4 top = MulAdd(p00, p01 - p00, wx);
+        const Float4 bottom = MulAdd(p10, p11 - p10, wx);
+        const Float4 value = MulAdd(top, bottom - top, wy);
+        T* out = dstRow + x * channels + c;
+        if constexpr (std::is_same_v<T, uint8_t>) {
+          Int4::FromFloatRound(Min(Max(value, Float4::Splat(0.0f)), Float4::Splat(255.0f))).store(laneResultInt);
+          for (size_t lane = 0; lane < lanes; ++lane) out[lane * channels] = static_cast<uint8_t>(laneResultInt[lane]);
+        } else {
+          value.store(laneResult);
+          for (size_t lane = 0; lane < lanes; ++lane) out[lane * channels] = laneResult[lane];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void ApplyAffine(const float affine[6], const T* src, const size_t srcWidth, const size_t srcHeight,
+                 const size_t channels, T* dst, const size_t dstWidth, const size_t dstHeight, ThreadPool& pool) {
+  CHECK_MSG(channels == 1 || channels == 3 || channels == 4, "ApplyAffine supports 1, 3 or 4 channels only")
+  const double a = affine[0], b = affine[1], c = affine[2], d = affine[3], e = affine[4], f = affine[5];
+  const double det = a * e - b * d;
+  CHECK_MSG(std::abs(det) > 1e-12, "ApplyAffine requires an invertible affine matrix")
+
+  const WarpGeometry geometry{.m = {e / det, -b / det, (b * f - c * e) / det, -d / det, a / det, (c * d - a * f) / det},
+                              .srcWidth = srcWidth,
+                              .srcHeight = srcHeight,
+                              .channels = channels,
+                              .dstWidth = dstWidth,
+                              .dstHeight = dstHeight};
+
+  const size_t tilesX = (dstWidth + TILE_WIDTH - 1) / TILE_WIDTH;
+  const size_t tilesY = (dstHeight + TILE_HEIGHT - 1) / TILE_HEIGHT;
+  pool.parallelFor(0, tilesX * tilesY, 1, [&](const size_t begin, const size_t end) {
+    for (size_t tile = begin; tile < end; ++tile) {
+      const size_t tx = tile % tilesX;
+      const size_t ty = tile / tilesX;
+      WarpTile(geometry, src, dst, tx * TILE_WIDTH, std::min(dstWidth, (tx + 1) * TILE_WIDTH), ty * TILE_HEIGHT,
+               std::min(dstHeight, (ty + 1) * TILE_HEIGHT));
+    }
+  });
+}
+
+template void ApplyAffine<uint8_t>(const float[6], const uint8_t*, size_t, size_t, size_t, uint8_t*, size_t, size_t,
+                                   ThreadPool&);
+template void ApplyAffine<float>(const float[6], const float*, size_t, size_t, size_t, float*, size_t, size_t,
+                                 ThreadPool&);
+
+namespace {
+
+template <typename T>
+double TimeApplyAffine(const size_t srcWidth, const size_t srcHeight, const size_t dstWidth, const size_t dstHeight,
+                       const size_t channels, const size_t runs) {
+  std::vector<T> src(srcWidth * srcHeight * channels);
+  for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<T>((i * 2654435761u) >> 24);
+  std::vector<T> dst(dstWidth * dstHeight * channels);
+
+  // Crop the central half of the source into the destination, rotated by 10 degrees
+  const double angle = 10.0 * 3.14159265358979323846 / 180.0;
+  const double scale = 2.0 * static_cast<double>(dstWidth) / static_cast<double>(srcWidth);
+  const double cosA = std::cos(angle) * scale, sinA = std::sin(angle) * scale;
+  const double cx = srcWidth / 2.0, cy = srcHeight / 2.0;
+  const float affine[6] = {static_cast<float>(cosA), static_cast<float>(-sinA),
+                           static_cast<float>(dstWidth / 2.0 - cosA * cx + sinA * cy), static_cast<float>(sinA),
+                           static_cast<float>(cosA), static_cast<float>(dstHeight / 2.0 - sinA * cx - cosA * cy)};
+
+  ApplyAffine(affine, src.data(), srcWidth, srcHeight, channels, dst.data(), dstWidth, dstHeight);  // warm-up
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t run = 0; run < runs; ++run) {
+    ApplyAffine(affine, src.data(), srcWidth, srcHeight, channels, dst.data(), dstWidth, dstHeight);
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+}  // namespace
+
+WarpBenchmarkResult BenchmarkApplyAffine(const size_t srcWidth, const size_t srcHeight, const size_t dstWidth,
+                                         const size_t dstHeight, const size_t channels, const bool useFloat32,
+                                         const size_t iterations) {
+  const size_t runs = std::max<size_t>(iterations, 1);
+  WarpBenchmarkResult result;
+  result.msPerRun = useFloat32 ? TimeApplyAffine<float>(srcWidth, srcHeight, dstWidth, dstHeight, channels, runs)
+                               : TimeApplyAffine<uint8_t>(srcWidth, srcHeight, dstWidth, dstHeight, channels, runs);
+  result.megapixelsPerSecond =
+      result.msPerRun > 0.0 ? static_cast<double>(dstWidth * dstHeight) / 1e6 / (result.msPerRun / 1e3) : 0.0;
+  return result;
+}
+
+}  // namespace SecureMR::Host
@@ -0,0 +1,59 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_HOST_WARP_H_
+#define SECUREMR_UTILS_HOST_WARP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "threadpool.h"
+
+namespace SecureMR::Host {
+
+/**
+ * Host implementation of <code>Pipeline::applyAffine</code>: bilinear warp of an interleaved (HWC) image with a
+ * constant zero border.
+ * <br/>
+ * The destination is cut into tiles which are distributed across the pool. Within a tile, the source position of
+ * each row start is computed once and then advanced by the constant per-column increment of the affine matrix, and
+ * four destination pixels are interpolated at a time with the 4-lane vectors of <code>simd.h</code>.
+ *
+ * @param affine the 2x3 row-major affine matrix mapping <b>source</b> to <b>destination</b> coordinates, i.e., the
+ *               same matrix <code>Pipeline::getAffine</code> produces; it is inverted internally.
+ * @param channels 1, 3 or 4
+ */
+template <typename T>
+void ApplyAffine(const float affine[6], const T* src, size_t srcWidth, size_t srcHeight, size_t channels, T* dst,
+                 size_t dstWidth, size_t dstHeight, ThreadPool& pool = ThreadPool::Default());
+
+struct WarpBenchmarkResult {
+  double msPerRun = 0.0;
+  /**
+   * Destination megapixels produced per second, the figure to budget camera/crop resolutions against
+   */
+  double megapixelsPerSecond = 0.0;
+};
+
+/**
+ * Time <code>ApplyAffine</code> on a synthetic image with a rotate-and-scale transform, e.g.,
+ * <code>BenchmarkApplyAffine(3248, 2464, 224, 224, 3, false, 100)</code> for the mnistwild crop.
+ * @param useFloat32 benchmark the float32 kernel instead of the uint8 one
+ */
+WarpBenchmarkResult BenchmarkApplyAffine(size_t srcWidth, size_t srcHeight, size_t dstWidth, size_t dstHeight,
+                                         size_t channels, bool useFloat32, size_t iterations);
+
+}  // namespace SecureMR::Host
+
+#endif  // SECUREMR_UTILS_HOST_WARP_H_
@@ -0,0 +1,96 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "parametric.h"
+
+#include <chrono>
+#include <utility>
+
+namespace SecureMR {
+
+ParametricPipeline::ParametricPipeline(std::shared_ptr<FrameworkSession> session)
+    : m_session(std::move(session)), m_pipeline(std::make_shared<Pipeline>(m_session)) {}
+
+std::shared_ptr<PipelineTensor> ParametricPipeline::addParameter(const std::string& name,
+                                                                 const TensorAttribute& attribute,
+                                                                 const std::vector<int8_t>& initialData) {
+  CHECK_MSG(m_parameters.count(name) == 0, Fmt("ParametricPipeline: parameter \"%s\" already declared", name.c_str()))
+  auto global = std::make_shared<GlobalTensor>(m_session, attribute);
+  if (!initialData.empty()) global->setData(initialData);
+  auto placeholder = PipelineTensor::PipelinePlaceholderLike(m_pipeline, global);
+  m_session->bandwidth().label(*global, name);
+  m_arguments.emplace(placeholder, global);
+  m_parameters.emplace(name, std::move(global));
+  return placeholder;
+}
+
+ParametricPipeline& ParametricPipeline::bind(const std::shared_ptr<PipelineTensor>& placeholder,
+                                             const std::shared_ptr<GlobalTensor>& global) {
+  CHECK_MSG(placeholder != nullptr && global != nullptr, "ParametricPipeline::bind(...) null tensor")
+  m_arguments[placeholder] = global;
+  return *this;
+}
+
+const std::shared_ptr<GlobalTensor>& ParametricPipeline::parameter(const std::string& name) const {
+  const auto it = m_parameters.find(name);
+  CHECK_MSG(it != m_parameters.end(), Fmt("ParametricPipeline: no parameter \"%s\"", name.c_str()))
+  return it->second;
+}
+
+XrSecureMrPipelineRunPICO ParametricPipeline::submit(const XrSecureMrPipelineRunPICO waitFor,
+                                                     const std::shared_ptr<GlobalTensor>& condition) {
+  return m_pipeline->submit(m_arguments, waitFor, condition);
+}
+
+EventSubmitBenchmarkResult BenchmarkEventSubmit(const std::shared_ptr<FrameworkSession>& session,
+                                                const TensorAttribute& parameterAttribute,
+                                                const std::vector<int8_t>& parameterData,
+                                                const EventPipelineBuilder& build, const size_t events) {
+  using Clock = std::chrono::steady_clock;
+  EventSubmitBenchmarkResult result{.events = events};
+  if (events == 0) return result;
+  const auto microsPerEvent = [events](const Clock::duration elapsed) {
+    return std::chrono::duration<double, std::micro>(elapsed).count() / static_cast<double>(events);
+  };
+
+  Clock::duration rebuilt{};
+  for (size_t event = 0; event < events; ++event) {
+    const auto start = Clock::now();
+    auto pipeline = std::make_shared<Pipeline>(session);
+    auto data = parameterData;
+    auto parameter = std::make_shared<PipelineTensor>(pipeline, parameterAttribute, data.data(), data.size());
+    pipeline->submit(build(pipeline, parameter), XR_NULL_HANDLE, nullptr);
+    // Destroying the one-off pipeline and its tensor is part of the cost of the event
+    parameter.reset();
+    pipeline.reset();
+    rebuilt += Clock::now() - start;
+  }
+  result.rebuiltMicrosPerEvent = microsPerEvent(rebuilt);
+
+  ParametricPipeline parametric(session);
+  const auto parameter = parametric.addParameter("benchmark parameter", parameterAttribute, parameterData);
+  for (const auto& [placeholder, global] : build(parametric.pipeline(), parameter)) {
+    parametric.bind(placeholder, global);
+  }
+  Clock::duration resubmitted{};
+  for (size_t event = 0; event < events; ++event) {
+    const auto start = Clock::now();
+    parametric.set("benchmark parameter", parameterData).submit();
+    resubmitted += Clock::now() - start;
+  }
+  result.parametricMicrosPerEvent = microsPerEvent(resubmitted);
+  return result;
+}
+
+}  // namespace SecureMR
@@ -0,0 +1,130 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_PARAMETRIC_H_
+#define SECUREMR_UTILS_PARAMETRIC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+/**
+ * A pipeline built once, with its parameters as placeholders, and resubmitted whenever an event changes them,
+ * instead of building a new pipeline with fresh tensors and operators for each event.
+ * <br/>
+ * Each parameter is a small global tensor bound to a placeholder of the pipeline at every submission, so an event
+ * only costs writing the new values into the global tensor and one submission. Global tensors the pipeline reads or
+ * writes besides its parameters, e.g., a glTF, are bound once by <code>bind</code>.
+ * <br/>
+ * <b>Note</b> a parameter written while a previous submission still runs may be read by it, as for any global tensor
+ * written outside a pipeline.
+ */
+class ParametricPipeline {
+ public:
+  explicit ParametricPipeline(std::shared_ptr<FrameworkSession> session);
+
+  /**
+   * The pipeline, to add operators reading the parameters to
+   */
+  [[nodiscard]] const std::shared_ptr<Pipeline>& pipeline() const { return m_pipeline; }
+
+  /**
+   * Declare a parameter
+   * @param initialData If not empty, the initial value of the parameter, in bytes
+   * @return The placeholder of the parameter, for the operators of the pipeline
+   */
+  std::shared_ptr<PipelineTensor> addParameter(const std::string& name, const TensorAttribute& attribute,
+                                               const std::vector<int8_t>& initialData = {});
+
+  /**
+   * Bind a placeholder of the pipeline to a global tensor at every submission
+   */
+  ParametricPipeline& bind(const std::shared_ptr<PipelineTensor>& placeholder,
+                           const std::shared_ptr<GlobalTensor>& global);
+
+  /**
+   * The global tensor of a parameter
+   */
+  [[nodiscard]] const std::shared_ptr<GlobalTensor>& parameter(const std::string& name) const;
+
+  /**
+   * Write new values of a parameter, as by <code>GlobalTensor::setData</code>
+   */
+  template <typename T>
+  ParametricPipeline& set(const std::string& name, const T* data, size_t count) {
+    parameter(name)->setData(data, count);
+    return *this;
+  }
+  template <typename Values>
+  ParametricPipeline& set(const std::string& name, const Values& values) {
+    parameter(name)->setData(values);
+    return *this;
+  }
+
+  /**
+   * Submit the pipeline with the current values of the parameters
+   */
+  XrSecureMrPipelineRunPICO submit(XrSecureMrPipelineRunPICO waitFor = XR_NULL_HANDLE,
+                                   const std::shared_ptr<GlobalTensor>& condition = nullptr);
+
+ private:
+  std::shared_ptr<FrameworkSession> m_session;
+  std::shared_ptr<Pipeline> m_pipeline;
+  std::unordered_map<std::string, std::shared_ptr<GlobalTensor>> m_parameters;
+  std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>> m_arguments;
+};
+
+/**
+ * Adds the operators of an event pipeline reading the <code>parameter</code> tensor, and returns the placeholders to
+ * bind at submission. The parameter is a local tensor or a placeholder, depending on how the pipeline is built.
+ */
+using EventPipelineBuilder = std::function<std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>(
+    const std::shared_ptr<Pipeline>& pipeline, const std::shared_ptr<PipelineTensor>& parameter)>;
+
+struct EventSubmitBenchmarkResult {
+  size_t events = 0;
+  /**
+   * Mean latency from an event to the return of its submission, building a pipeline for each event
+   */
+  double rebuiltMicrosPerEvent = 0.0;
+  /**
+   * Mean latency from an event to the return of its submission, resubmitting a <code>ParametricPipeline</code>
+   */
+  double parametricMicrosPerEvent = 0.0;
+};
+
+/**
+ * Time the event-to-submit latency of an event pipeline, built for each of <code>events</code> events with the
+ * parameter as a local tensor, then built once as a <code>ParametricPipeline</code>. Both submit every event, with
+ * the same parameter values, so the benchmark can run on a live session without visible effects if the values are
+ * the current ones.
+ */
+EventSubmitBenchmarkResult BenchmarkEventSubmit(const std::shared_ptr<FrameworkSession>& session,
+                                                const TensorAttribute& parameterAttribute,
+                                                const std::vector<int8_t>& parameterData,
+                                                const EventPipelineBuilder& build, size_t events);
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_PARAMETRIC_H_
@@ -0,0 +1,560 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "partition.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#include "oxr_utils/common.h"
+#include "pipeline.h"
+#include "tensor.h"
+#include "tensormemory.h"
+
+namespace SecureMR {
+
+namespace {
+
+struct OperatorInfo {
+  const Json* spec = nullptr;
+  std::vector<std::string> reads;
+  std::vector<std::string> writes;
+  double cost = 1.0;
+  float rateHz = 0.0f;
+};
+
+/**
+ * Relative cost of an operator by type, when the spec gives none: model inference dominates, then the operators
+ * touching whole images
+ */
+double DefaultCost(const std::string& type) {
+  static const std::unordered_map<std::string, double> COSTS{
+      {"run_algorithm", 100.0}, {"camera_access", 10.0}, {"apply_affine", 8.0}, {"cvt_color", 4.0},
+      {"convert_hwc_chw", 4.0}, {"type_convert", 2.0},   {"assignment", 2.0},   {"arithmetic", 2.0}};
+  const auto it = COSTS.find(type);
+  return it == COSTS.end() ? 1.0 : it->second;
+}
+
+size_t TensorBytes(const Json& tensorSpec) {
+  TensorAttribute attribute{};
+  if (tensorSpec.value("is_gltf", false) || !JsonToTensorAttribute(tensorSpec, attribute)) return 0;
+  return TensorByteSize(attribute);
+}
+
+const char* RoleName(const bool read, const bool write) {
+  if (read && write) return "read_write";
+  return write ? "write" : "read";
+}
+
+/**
+ * Cut <code>count</code> operators into at most <code>maxStages</code> contiguous segments minimizing the
+ * most expensive one, as given by <code>segmentCost(begin, end)</code>
+ * @return The first operator of each segment
+ */
+template <typename SegmentCost>
+std::vector<size_t> BalancedCuts(const size_t count, const size_t maxStages, const SegmentCost& segmentCost) {
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  const size_t stages = std::max<size_t>(1, std::min(maxStages, count));
+  // best[s][e]: the cost of the most expensive segment when cutting the first e operators into s segments
+  std::vector<std::vector<double>> best(stages + 1, std::vector<double>(count + 1, INF));
+  std::vector<std::vector<size_t>> lastCut(stages + 1, std::vector<size_t>(count + 1, 0));
+  best[0][0] = 0.0;
+  for (size_t s = 1; s <= stages; ++s) {
+    for (size_t e = s; e <= count; ++e) {
+      for (size_t b = s - 1; b < e; ++b) {
+        const double cost = std::max(best[s - 1][b], segmentCost(b, e));
+        if (cost < best[s][e]) {
+          best[s][e] = cost;
+          lastCut[s][e] = b;
+        }
+      }
+    }
+  }
+  // More stages only when they lower the critical stage
+  size_t chosen = 1;
+  for (size_t s = 2; s <= stages; ++s) {
+    if (best[s][count] < best[chosen][count] * (1.0 - 1e-9)) chosen = s;
+  }
+  std::vector<size_t> cuts(chosen);
+  for (size_t s = chosen, e = count; s > 0; --s) {
+    cuts[s - 1] = lastCut[s][e];
+    e = cuts[s - 1];
+  }
+  return cuts;
+}
+
+/**
+ * @return Whether the role reads, and whether it writes
+ */
+std::pair<bool, bool> AccessOf(const std::string& role) { return {role != "write", role != "read"}; }
+
+/**
+ * Rename the tensors of an operator, keeping the operand names of <code>run_algorithm</code> which default to the
+ * tensor names
+ */
+void RenameOperatorTensors(Json& opSpec, const std::unordered_map<std::string, std::string>& names) {
+  const bool mapped = opSpec.value("type", "") == "run_algorithm";
+  for (const char* key : {"inputs", "outputs"}) {
+    const auto listIt = opSpec.find(key);
+    if (listIt == opSpec.end() || !listIt->is_array()) continue;
+    for (auto& each : *listIt) {
+      if (each.is_string()) {
+        const auto it = names.find(each.get<std::string>());
+        if (it == names.end()) continue;
+        each = mapped ? Json{{"name", each}, {"tensor", it->second}} : Json(it->second);
+      } else if (each.is_object() && each.contains("tensor") && each["tensor"].is_string()) {
+        const auto it = names.find(each["tensor"].get<std::string>());
+        if (it == names.end()) continue;
+        if (!each.contains("name")) each["name"] = each["tensor"];
+        each["tensor"] = it->second;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+Json PartitionPipelineSpec(const Json& spec, const PipelinePartitionOptions& options) {
+  const auto tensorsIt = spec.find("tensors");
+  const auto operatorsIt = spec.find("operators");
+  if (!spec.is_object() || tensorsIt == spec.end() || !tensorsIt->is_object() || operatorsIt == spec.end() ||
+      !operatorsIt->is_array()) {
+    throw std::runtime_error("PartitionPipelineSpec: tensors or operators section missing or invalid");
+  }
+  const Json& tensors = *tensorsIt;
+  const auto isPlaceholder = [&tensors](const std::string& name) {
+    return tensors.at(name).value("is_placeholder", false);
+  };
+
+  // Step 1: reads, writes, cost and rate of each operator, in spec order
+  std::vector<OperatorInfo> operators;
+  std::unordered_map<std::string, float> writerRate;
+  const float specRate = spec.value("rate_hz", options.defaultRateHz);
+  for (const auto& opSpec : *operatorsIt) {
+    OperatorInfo info{.spec = &opSpec,
+                      .reads = ParseTensorList(opSpec.value("inputs", Json::array())),
+                      .writes = ParseTensorList(opSpec.value("outputs", Json::array()))};
+    for (const auto* names : {&info.reads, &info.writes}) {
+      for (const auto& name : *names) {
+        if (!tensors.contains(name)) {
+          throw std::runtime_error(Fmt("PartitionPipelineSpec: tensor '%s' not found", name.c_str()));
+        }
+      }
+    }
+    info.cost = opSpec.value("cost", DefaultCost(opSpec.value("type", "")));
+    if (opSpec.contains("rate_hz")) {
+      info.rateHz = opSpec["rate_hz"].get<float>();
+    } else {
+      for (const auto& name : info.reads) {
+        if (const auto it = writerRate.find(name); it != writerRate.end()) {
+          info.rateHz = std::max(info.rateHz, it->second);
+        }
+      }
+      if (info.rateHz <= 0.0f) info.rateHz = specRate;
+    }
+    for (const auto& name : info.writes) writerRate[name] = info.rateHz;
+    operators.push_back(std::move(info));
+  }
+
+  std::unordered_map<std::string, std::vector<size_t>> writersOf;
+  for (size_t i = 0; i < operators.size(); ++i) {
+    for (const auto& name : operators[i].writes) writersOf[name].push_back(i);
+  }
+
+  // Step 2: cut the operators of each rate into cost-balanced stages
+  std::map<float, std::vector<size_t>, std::greater<>> rateGroups;
+  for (size_t i = 0; i < operators.size(); ++i) rateGroups[operators[i].rateHz].push_back(i);
+
+  std::vector<std::vector<size_t>> stages;
+  std::vector<size_t> stageOf(operators.size(), 0);
+  for (const auto& [rateHz, group] : rateGroups) {
+    const auto segmentCost = [&](const size_t begin, const size_t end) {
+      double cost = 0.0;
+      std::set<std::string> imported;
+      for (size_t k = begin; k < end; ++k) {
+        cost += operators[group[k]].cost;
+        for (const auto& name : operators[group[k]].reads) {
+          const auto writers = writersOf.find(name);
+          if (writers == writersOf.end()) continue;
+          const bool writtenOutside = std::any_of(writers->second.begin(), writers->second.end(), [&](size_t w) {
+            const auto at = std::find(group.begin(), group.end(), w);
+            return at == group.end() || static_cast<size_t>(at - group.begin()) < begin ||
+                   static_cast<size_t>(at - group.begin()) >= end;
+          });
+          if (writtenOutside && imported.insert(name).second) cost += options.costPerByte * TensorBytes(tensors[name]);
+        }
+      }
+      return cost;
+    };
+    const auto cuts = BalancedCuts(group.size(), options.maxStagesPerRate, segmentCost);
+    for (size_t c = 0; c < cuts.size(); ++c) {
+      const size_t end = c + 1 < cuts.size() ? cuts[c + 1] : group.size();
+      stages.emplace_back(group.begin() + static_cast<std::ptrdiff_t>(cuts[c]),
+                          group.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+  }
+  std::sort(stages.begin(), stages.end(), [](const auto& a, const auto& b) { return a.front() < b.front(); });
+  for (size_t s = 0; s < stages.size(); ++s) {
+    for (const auto i : stages[s]) stageOf[i] = s;
+  }
+
+  // Step 3: a tensor written in one stage and accessed in another is exchanged through a global tensor
+  std::unordered_map<std::string, std::set<size_t>> accessingStages;
+  for (size_t i = 0; i < operators.size(); ++i) {
+    for (const auto* names : {&operators[i].reads, &operators[i].writes}) {
+      for (const auto& name : *names) accessingStages[name].insert(stageOf[i]);
+    }
+  }
+  Json globals = Json::object();
+  for (const auto& [name, stageSet] : accessingStages) {
+    if (isPlaceholder(name) || writersOf.count(name) == 0 || stageSet.size() < 2) continue;
+    Json global = tensors[name];
+    global.erase("is_placeholder");
+    global.erase("value");
+    globals[name] = std::move(global);
+  }
+
+  // Step 4: a pipeline spec and the placeholder bindings of each stage
+  const auto logicalOutputs = ParseTensorList(spec.value("outputs", Json::array()));
+  Json planStages = Json::array();
+  for (size_t s = 0; s < stages.size(); ++s) {
+    std::map<std::string, std::pair<bool, bool>> access;  // name -> (read, written)
+    Json operatorSpecs = Json::array();
+    double cost = 0.0;
+    for (const auto i : stages[s]) {
+      for (const auto& name : operators[i].reads) access[name].first = true;
+      for (const auto& name : operators[i].writes) access[name].second = true;
+      operatorSpecs.push_back(*operators[i].spec);
+      cost += operators[i].cost;
+    }
+
+    Json stageTensors = Json::object();
+    Json bindings = Json::array();
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    for (const auto& [name, readWrite] : access) {
+      const bool external = isPlaceholder(name);
+      const bool exchanged = globals.contains(name);
+      Json tensorSpec = tensors[name];
+      if (exchanged) {
+        tensorSpec["is_placeholder"] = true;
+        tensorSpec.erase("value");
+      }
+      stageTensors[name] = std::move(tensorSpec);
+      if (external || exchanged) {
+        bindings.push_back({{"placeholder", name},
+                            {"global", name},
+                            {"role", RoleName(readWrite.first, readWrite.second)},
+                            {"external", external}});
+        if (readWrite.first) inputs.push_back(name);
+        if (readWrite.second) outputs.push_back(name);
+      } else if (std::find(logicalOutputs.begin(), logicalOutputs.end(), name) != logicalOutputs.end()) {
+        outputs.push_back(name);
+      }
+    }
+
+    Json stageSpec = Json::object();
+    if (spec.contains("metadata")) stageSpec["metadata"] = spec["metadata"];
+    stageSpec["tensors"] = std::move(stageTensors);
+    stageSpec["operators"] = std::move(operatorSpecs);
+    SetInputs(stageSpec, inputs);
+    SetOutputs(stageSpec, outputs);
+
+    planStages.push_back({{"name", Fmt("stage%zu", s)},
+                          {"rate_hz", operators[stages[s].front()].rateHz},
+                          {"cost", cost},
+                          {"pipeline", std::move(stageSpec)},
+                          {"bindings", std::move(bindings)}});
+  }
+
+  Json plan = Json::object();
+  if (spec.contains("metadata")) plan["metadata"] = spec["metadata"];
+  plan["globals"] = std::move(globals);
+  plan["stages"] = std::move(planStages);
+  return plan;
+}
+
+Json MergePartitionPlan(const Json& plan, const PipelineMergeOptions& options, PipelineMergeReport* outReport) {
+  const auto globalsIt = plan.find("globals");
+  const auto stagesIt = plan.find("stages");
+  if (!plan.is_object() || globalsIt == plan.end() || !globalsIt->is_object() || stagesIt == plan.end() ||
+      !stagesIt->is_array()) {
+    throw std::runtime_error("MergePartitionPlan: globals or stages section missing or invalid");
+  }
+  const Json& stages = *stagesIt;
+  const auto internalBindings = [](const Json& stage) {
+    std::vector<std::pair<std::string, std::pair<bool, bool>>> bindings;
+    for (const auto& binding : stage.value("bindings", Json::array())) {
+      if (binding.value("external", false)) continue;
+      bindings.emplace_back(binding.value("global", ""), AccessOf(binding.value("role", "read")));
+    }
+    return bindings;
+  };
+
+  // Step 1: merge each stage into the previous group of its rate if they hand a global tensor over
+  struct Group {
+    std::vector<size_t> stages;
+    double cost = 0.0;
+    std::set<std::string> written;
+    std::set<std::string> bound;
+  };
+  std::vector<Group> groups;
+  std::unordered_map<std::string, std::set<size_t>> groupsOfGlobal;
+  for (size_t s = 0; s < stages.size(); ++s) {
+    const float rateHz = stages[s].value("rate_hz", 0.0f);
+    const double cost = stages[s].value("cost", 0.0);
+    const auto bindings = internalBindings(stages[s]);
+    const auto previous = std::find_if(groups.rbegin(), groups.rend(), [&](const Group& group) {
+      return stages[group.stages.front()].value("rate_hz", 0.0f) == rateHz;
+    });
+    const bool handOver =
+        previous != groups.rend() && std::any_of(bindings.begin(), bindings.end(), [&previous](const auto& binding) {
+          return (binding.second.second && previous->bound.count(binding.first) > 0) ||
+                 previous->written.count(binding.first) > 0;
+        });
+    const bool merge = handOver && previous->cost + cost <= options.maxStageCost;
+    Group& group = merge ? *previous : groups.emplace_back();
+    group.stages.push_back(s);
+    group.cost += cost;
+    for (const auto& [global, access] : bindings) {
+      group.bound.insert(global);
+      if (access.second) group.written.insert(global);
+    }
+  }
+  for (size_t g = 0; g < groups.size(); ++g) {
+    for (const auto& global : groups[g].bound) groupsOfGlobal[global].insert(g);
+  }
+
+  // Step 2: one pipeline spec per group
+  PipelineMergeReport report;
+  Json globals = *globalsIt;
+  Json mergedStages = Json::array();
+  for (size_t g = 0; g < groups.size(); ++g) {
+    const auto& members = groups[g].stages;
+    if (members.size() == 1) {
+      mergedStages.push_back(stages[members.front()]);
+      continue;
+    }
+    const float rateHz = stages[members.front()].value("rate_hz", 0.0f);
+    std::set<std::string> internal;
+    for (const auto& global : groups[g].bound) {
+      if (groupsOfGlobal[global].size() == 1 && globals.contains(global)) internal.insert(global);
+    }
+
+    // Names bound to global tensors are reserved, so that local tensors never shadow them
+    std::set<std::string> reserved;
+    for (const auto s : members) {
+      for (const auto& binding : stages[s].value("bindings", Json::array())) {
+        reserved.insert(binding.value("global", ""));
+      }
+    }
+
+    Json tensors = Json::object();
+    Json operators = Json::array();
+    std::set<std::string> mutableLocals;
+    std::map<std::pair<std::string, bool>, std::pair<bool, bool>> placeholders;  // (global, external) -> access
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    std::vector<std::string> names;
+    for (const auto s : members) {
+      const Json& stage = stages[s];
+      const std::string stageName = stage.value("name", Fmt("stage%zu", s));
+      names.push_back(stageName);
+      const Json& spec = stage.at("pipeline");
+      std::unordered_map<std::string, std::string> globalOf;
+      for (const auto& binding : stage.value("bindings", Json::array())) {
+        const std::string global = binding.value("global", "");
+        globalOf[binding.value("placeholder", "")] = global;
+        if (internal.count(global) > 0) continue;
+        auto& access = placeholders[{global, binding.value("external", false)}];
+        const auto role = AccessOf(binding.value("role", "read"));
+        access.first |= role.first;
+        access.second |= role.second;
+      }
+      std::set<std::string> written;
+      for (const auto& opSpec : spec.value("operators", Json::array())) {
+        for (const auto& name : ParseTensorList(opSpec.value("outputs", Json::array()))) written.insert(name);
+      }
+
+      std::unordered_map<std::string, std::string> renamed;
+      const Json stageTensors = spec.value("tensors", Json::object());
+      for (const auto& [name, tensorSpec] : stageTensors.items()) {
+        if (const auto it = globalOf.find(name); it != globalOf.end()) {
+          renamed[name] = it->second;
+          if (tensors.contains(it->second)) continue;
+          if (internal.count(it->second) > 0) {
+            tensors[it->second] = globals[it->second];
+          } else {
+            tensors[it->second] = tensorSpec;
+            tensors[it->second]["is_placeholder"] = true;
+          }
+          continue;
+        }
+        const bool constant = written.count(name) == 0;
+        const bool shared = tensors.contains(name) && constant && mutableLocals.count(name) == 0 &&
+                            tensors[name] == tensorSpec;
+        std::string mergedName = name;
+        if (reserved.count(name) > 0 || (tensors.contains(name) && !shared)) mergedName = stageName + "." + name;
+        renamed[name] = mergedName;
+        if (!constant) mutableLocals.insert(mergedName);
+        tensors[mergedName] = tensorSpec;
+      }
+
+      for (auto opSpec : spec.value("operators", Json::array())) {
+        RenameOperatorTensors(opSpec, renamed);
+        operators.push_back(std::move(opSpec));
+      }
+      const auto appendRenamed = [&spec, &renamed, &internal](const char* key, std::vector<std::string>& target) {
+        for (const auto& name : ParseTensorList(spec.value(key, Json::array()))) {
+          const auto it = renamed.find(name);
+          const std::string mergedName = it == renamed.end() ? name : it->second;
+          if (internal.count(mergedName) == 0 && std::find(target.begin(), target.end(), mergedName) == target.end()) {
+            target.push_back(mergedName);
+          }
+        }
+      };
+      appendRenamed("inputs", inputs);
+      appendRenamed("outputs", outputs);
+    }
+
+    Json bindings = Json::array();
+    for (const auto& [key, access] : placeholders) {
+      bindings.push_back({{"placeholder", key.first},
+                          {"global", key.first},
+                          {"role", RoleName(access.first, access.second)},
+                          {"external", key.second}});
+    }
+    Json spec = Json::object();
+    if (const Json& first = stages[members.front()].at("pipeline"); first.contains("metadata")) {
+      spec["metadata"] = first["metadata"];
+    }
+    spec["tensors"] = std::move(tensors);
+    spec["operators"] = std::move(operators);
+    SetInputs(spec, inputs);
+    SetOutputs(spec, outputs);
+
+    std::string name = names.front();
+    for (size_t i = 1; i < names.size(); ++i) name += "+" + names[i];
+    mergedStages.push_back({{"name", name},
+                            {"rate_hz", rateHz},
+                            {"cost", groups[g].cost},
+                            {"pipeline", std::move(spec)},
+                            {"bindings", std::move(bindings)}});
+
+    report.mergedStages += members.size() - 1;
+    report.submitsSavedPerSecond += static_cast<double>(members.size() - 1) * rateHz;
+    for (const auto& global : internal) {
+      size_t accesses = 0;
+      for (const auto s : members) {
+        for (const auto& [bound, access] : internalBindings(stages[s])) {
+          if (bound == global) accesses += (access.first ? 1 : 0) + (access.second ? 1 : 0);
+        }
+      }
+      report.bytesSavedPerSecond += static_cast<double>(TensorBytes(globals[global]) * accesses) * rateHz;
+      report.internalizedGlobals.push_back(global);
+      globals.erase(global);
+    }
+  }
+
+  Log::Write(Log::Level::Info,
+             Fmt("MergePartitionPlan: %zu stages merged, %.1f submits/s and %.1f KB/s of global tensors saved",
+                 report.mergedStages, report.submitsSavedPerSecond, report.bytesSavedPerSecond / 1024.0));
+  if (outReport != nullptr) *outReport = std::move(report);
+
+  Json merged = Json::object();
+  if (plan.contains("metadata")) merged["metadata"] = plan["metadata"];
+  merged["globals"] = std::move(globals);
+  merged["stages"] = std::move(mergedStages);
+  return merged;
+}
+
+bool InstantiatePartitionPlan(const Json& plan, const std::shared_ptr<FrameworkSession>& session,
+                              const std::unordered_map<std::string, std::shared_ptr<GlobalTensor>>& externalGlobals,
+                              PartitionRuntime& outRuntime, std::string& outError,
+                              const PipelineDeserializationOptions& options) {
+  outRuntime = {};
+  outError.clear();
+  const auto globalsIt = plan.find("globals");
+  const auto stagesIt = plan.find("stages");
+  if (!plan.is_object() || globalsIt == plan.end() || !globalsIt->is_object() || stagesIt == plan.end() ||
+      !stagesIt->is_array()) {
+    outError = "globals or stages section missing or invalid";
+    return false;
+  }
+
+  try {
+    for (auto it = globalsIt->begin(); it != globalsIt->end(); ++it) {
+      TensorAttribute attribute{};
+      if (!JsonToTensorAttribute(*it, attribute)) {
+        outError = Fmt("invalid tensor attribute for global %s", it.key().c_str());
+        return false;
+      }
+      outRuntime.globals.emplace(it.key(), std::make_shared<GlobalTensor>(session, attribute));
+    }
+
+    for (const auto& stage : *stagesIt) {
+      const std::string name = stage.value("name", "");
+      PipelineDeserializationResult result;
+      std::string error;
+      if (!DeserializePipelineFromJson(stage.value("pipeline", Json::object()), session, result, error, options)) {
+        outError = Fmt("stage %s: %s", name.c_str(), error.c_str());
+        return false;
+      }
+
+      std::vector<PipelineBinding> bindings;
+      for (const auto& binding : stage.value("bindings", Json::array())) {
+        const std::string placeholder = binding.value("placeholder", "");
+        const std::string global = binding.value("global", "");
+        const auto& globals = binding.value("external", false) ? externalGlobals : outRuntime.globals;
+        const auto globalIt = globals.find(global);
+        const auto placeholderIt = result.tensorMap.find(placeholder);
+        if (globalIt == globals.end() || placeholderIt == result.tensorMap.end()) {
+          outError = Fmt("stage %s: no global tensor '%s' for placeholder '%s'", name.c_str(), global.c_str(),
+                         placeholder.c_str());
+          return false;
+        }
+        const std::string role = binding.value("role", "read");
+        bindings.push_back({.placeholder = placeholderIt->second,
+                            .global = globalIt->second,
+                            .role = role == "read_write" ? TensorRole::READ_WRITE
+                                    : role == "write"    ? TensorRole::WRITE
+                                                         : TensorRole::READ});
+      }
+
+      const float rateHz = stage.value("rate_hz", 0.0f);
+      auto group = std::find_if(outRuntime.groups.begin(), outRuntime.groups.end(),
+                                [rateHz](const PartitionRuntime::RateGroup& each) { return each.rateHz == rateHz; });
+      if (group == outRuntime.groups.end()) {
+        outRuntime.groups.push_back({.rateHz = rateHz});
+        group = std::prev(outRuntime.groups.end());
+      }
+      group->graph.add(result.pipeline, bindings);
+      outRuntime.stages.push_back(std::move(result));
+    }
+  } catch (const std::exception& e) {
+    outError = e.what();
+    return false;
+  }
+
+  std::sort(outRuntime.groups.begin(), outRuntime.groups.end(),
+            [](const PartitionRuntime::RateGroup& a, const PartitionRuntime::RateGroup& b) {
+              return a.rateHz > b.rateHz;
+            });
+  return true;
+}
+
+}  // namespace SecureMR
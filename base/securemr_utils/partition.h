@@ -0,0 +1,151 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_PARTITION_H_
+#define SECUREMR_UTILS_PARTITION_H_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "serialization.h"
+#include "pipelinegraph.h"
+
+namespace SecureMR {
+
+class GlobalTensor;
+
+struct PipelinePartitionOptions {
+  /**
+   * Upper bound of the pipelines each rate group is cut into
+   */
+  size_t maxStagesPerRate = 2;
+  /**
+   * Rate of the operators without a <code>"rate_hz"</code> hint and without producers, if the spec has no
+   * top-level <code>"rate_hz"</code>
+   */
+  float defaultRateHz = 30.0f;
+  /**
+   * Cost, in the units of the operator costs, of each byte a stage reads from a global tensor written by another
+   * stage
+   */
+  double costPerByte = 1e-5;
+};
+
+/**
+ * Cut one logical pipeline spec, as read by <code>DeserializePipelineFromJson</code>, into stages to run
+ * concurrently, and emit a run plan.
+ * <br/>
+ * Each operator may carry a <code>"rate_hz"</code> hint and a <code>"cost"</code>. An operator without a rate runs
+ * at the highest rate of the operators producing its inputs; an operator without a cost is given one by its type,
+ * dominated by <code>run_algorithm</code>. Operators of different rates are never in the same stage. The operators
+ * of each rate, in spec order, are cut into at most <code>maxStagesPerRate</code> contiguous stages minimizing the
+ * cost of the most expensive stage, including the bytes it reads from other stages.
+ * <br/>
+ * A tensor written in one stage and read or written in another becomes a synthesized global tensor, bound to a
+ * placeholder of the same name in each of these stages. Constant tensors are copied into every stage reading them,
+ * and the placeholders of the logical spec stay placeholders of every stage using them.
+ * <br/>
+ * The plan is a JSON object with
+ * <ul>
+ * <li><code>"globals"</code>, the attributes of the synthesized global tensors by name, </li>
+ * <li><code>"stages"</code>, in spec order, each with a <code>"name"</code>, <code>"rate_hz"</code>,
+ *     <code>"cost"</code>, a pipeline spec as <code>"pipeline"</code>, and the <code>"bindings"</code> of its
+ *     placeholders: <code>"placeholder"</code>, <code>"global"</code>, <code>"role"</code> (<code>"read"</code>,
+ *     <code>"write"</code> or <code>"read_write"</code>) and whether the global is <code>"external"</code>, i.e., a
+ *     placeholder of the logical spec bound by the application. </li>
+ * </ul>
+ * @throw std::runtime_error if the spec is malformed, e.g., an operator reads a tensor missing from
+ *        <code>"tensors"</code>
+ */
+Json PartitionPipelineSpec(const Json& spec, const PipelinePartitionOptions& options = {});
+
+struct PipelineMergeOptions {
+  /**
+   * Upper bound of the cost of a merged stage, so that merging does not serialize too much work in one pipeline
+   */
+  double maxStageCost = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * What <code>MergePartitionPlan</code> saves at the stage rates
+ */
+struct PipelineMergeReport {
+  /**
+   * Number of stages merged into the one before them
+   */
+  size_t mergedStages = 0;
+  double submitsSavedPerSecond = 0.0;
+  /**
+   * Bytes written to and read from the global tensors replaced by local tensors
+   */
+  double bytesSavedPerSecond = 0.0;
+  std::vector<std::string> internalizedGlobals;
+};
+
+/**
+ * Merge the stages of a run plan which run back to back at the same rate into one pipeline, removing the round
+ * trips through global tensors and the submissions between them.
+ * <br/>
+ * A stage is merged into the previous stage of the same rate when one of them writes a global tensor the other
+ * accesses, and the cost of the merged stage stays within <code>maxStageCost</code>. The operators of the merged
+ * stages keep their order. A global tensor bound only by the stages of one merged stage becomes a local tensor of
+ * it; the others, including the external ones, stay bound to placeholders named after the global tensor. Local
+ * tensors of the same name in several stages are renamed <code>"<stage>.<tensor>"</code>, unless they are the same
+ * constant.
+ * <br/>
+ * The plan may come from <code>PartitionPipelineSpec</code>, or describe pipelines written by hand in the same
+ * format.
+ * @param outReport If not <code>nullptr</code>, receives the submissions and bytes saved per second
+ * @return The merged plan, to be instantiated by <code>InstantiatePartitionPlan</code>
+ * @throw std::runtime_error if the plan is malformed
+ */
+Json MergePartitionPlan(const Json& plan, const PipelineMergeOptions& options = {},
+                        PipelineMergeReport* outReport = nullptr);
+
+/**
+ * The pipelines and global tensors of a run plan, with one <code>PipelineGraph</code> per rate. Each graph is
+ * meant to be submitted by its own runner at its rate; the graphs exchange data through the global tensors only.
+ */
+struct PartitionRuntime {
+  struct RateGroup {
+    float rateHz = 0.0f;
+    PipelineGraph graph;
+  };
+
+  std::vector<PipelineDeserializationResult> stages;
+  std::unordered_map<std::string, std::shared_ptr<GlobalTensor>> globals;
+  /**
+   * By decreasing rate
+   */
+  std::vector<RateGroup> groups;
+};
+
+/**
+ * Create the pipelines and synthesized global tensors of a plan from <code>PartitionPipelineSpec</code>, and
+ * register every stage with the roles of its placeholders in the graph of its rate
+ * @param externalGlobals The global tensors of the application, by the names of the placeholders of the logical
+ *                        spec they are bound to
+ */
+bool InstantiatePartitionPlan(const Json& plan, const std::shared_ptr<FrameworkSession>& session,
+                              const std::unordered_map<std::string, std::shared_ptr<GlobalTensor>>& externalGlobals,
+                              PartitionRuntime& outRuntime, std::string& outError,
+                              const PipelineDeserializationOptions& options = {});
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_PARTITION_H_
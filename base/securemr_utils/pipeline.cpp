@@ -15,11 +15,21 @@
 #include "rendercommand.h"
 #include "tensor.h"
 #include "pipeline.h"
+#include "tensorarena.h"
+#include "trace.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <optional>
 #include <variant>
 
 namespace SecureMR {
-Pipeline::Pipeline(std::shared_ptr<FrameworkSession> root) : m_rootSession(std::move(root)) {
+namespace {
+std::atomic<uint32_t> g_nextPipelineId{1};
+}
+
+Pipeline::Pipeline(std::shared_ptr<FrameworkSession> root) : m_rootSession(std::move(root)), m_id(g_nextPipelineId++) {
   if (m_rootSession) {
     Log::Write(Log::Level::Info, "Attempting to get xrCreateSecureMrPipelinePICO");
 
@@ -57,28 +67,72 @@ bool Pipeline::verifyPipelineTensor(const std::shared_ptr<PipelineTensor>& candi
   return candidateTensor != nullptr && candidateTensor->getPipeline().get() == this;
 }
 
-Pipeline::~Pipeline(){CHECK_XRCMD(xrDestroySecureMrPipelinePICO(m_handle))}
+Pipeline::~Pipeline() {
+  if (m_rootSession != nullptr) {
+    m_rootSession->memory().releasePipeline(this);
+    m_rootSession->bandwidth().forgetPipeline(this);
+  }
+  CHECK_XRCMD(xrDestroySecureMrPipelinePICO(m_handle))
+}
+
+std::vector<TensorRef> Pipeline::createTensors(const std::vector<TensorAttribute>& attributes,
+                                              const bool isPlaceholder) {
+  if (m_arena == nullptr) m_arena = std::make_unique<TensorArena>(*this);
+  const uint32_t first = m_arena->create(attributes, isPlaceholder);
+  std::vector<TensorRef> refs(attributes.size());
+  for (uint32_t i = 0; i < refs.size(); ++i) refs[i] = {.pipelineId = m_id, .index = first + i};
+  return refs;
+}
+
+TensorRef Pipeline::createTensor(const TensorAttribute& attribute, const bool isPlaceholder) {
+  return createTensors({attribute}, isPlaceholder).front();
+}
+
+void Pipeline::checkRef(const TensorRef tensor) const {
+  CHECK_MSG(tensor.pipelineId == m_id && m_arena != nullptr,
+            Fmt("Tensor reference of pipeline %u used on pipeline %u", tensor.pipelineId, m_id))
+}
+
+XrSecureMrPipelineTensorPICO Pipeline::handleOf(const TensorOperand& tensor) const {
+  if (tensor.tensor() != nullptr) return static_cast<XrSecureMrPipelineTensorPICO>(*tensor.tensor());
+  if (!tensor.ref().valid()) return XR_NULL_HANDLE;
+  checkRef(tensor.ref());
+  return m_arena->handle(tensor.ref().index);
+}
+
+std::variant<std::monostate, TensorAttribute> Pipeline::attributeOf(const TensorOperand& tensor) const {
+  if (tensor.tensor() != nullptr) return tensor.tensor()->getAttribute();
+  checkRef(tensor.ref());
+  return m_arena->attribute(tensor.ref().index);
+}
+
+void Pipeline::setData(const TensorRef tensor, int8_t* const data, const size_t size) {
+  checkRef(tensor);
+  m_arena->setData(tensor.index, data, size);
+}
+
+std::shared_ptr<PipelineTensor> Pipeline::tensor(const TensorRef tensor) {
+  checkRef(tensor);
+  return m_arena->shared(tensor.index);
+}
 
-Pipeline& Pipeline::typeConvert(const std::shared_ptr<PipelineTensor>& src,
-                                const std::shared_ptr<PipelineTensor>& dst) {
+Pipeline& Pipeline::typeConvert(TensorOperand src, TensorOperand dst) {
   return assignment(src, dst);
 }
 
-Pipeline& Pipeline::assignment(const std::shared_ptr<PipelineTensor>& src, const std::shared_ptr<PipelineTensor>& dst) {
+Pipeline& Pipeline::assignment(TensorOperand src, TensorOperand dst) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_ASSIGNMENT_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle,
-                                                     static_cast<XrSecureMrPipelineTensorPICO>(*src), "src"))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*dst), "dst"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(src), "src"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(dst), "dst"))
   return *this;
 }
 
-Pipeline& Pipeline::assignment(const std::shared_ptr<PipelineTensor>& src, const PipelineTensor::Slice& dstSlice) {
+Pipeline& Pipeline::assignment(TensorOperand src, const PipelineTensor::Slice& dstSlice) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
@@ -86,8 +140,7 @@ Pipeline& Pipeline::assignment(const std::shared_ptr<PipelineTensor>& src, const
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_ASSIGNMENT_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle,
-                                                     static_cast<XrSecureMrPipelineTensorPICO>(*src), "src"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(src), "src"))
   CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, dstSlice.sliceTensor(), "dst slices"))
   if (dstSlice.hasChannelSlice()) {
     CHECK_XRCMD(
@@ -98,7 +151,7 @@ Pipeline& Pipeline::assignment(const std::shared_ptr<PipelineTensor>& src, const
   return *this;
 }
 
-Pipeline& Pipeline::assignment(const PipelineTensor::Slice& srcSlice, const std::shared_ptr<PipelineTensor>& dst) {
+Pipeline& Pipeline::assignment(const PipelineTensor::Slice& srcSlice, TensorOperand dst) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
@@ -113,8 +166,7 @@ Pipeline& Pipeline::assignment(const PipelineTensor::Slice& srcSlice, const std:
         xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, srcSlice.channelSliceTensor(), "src channel slice"))
   }
 
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*dst), "dst"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(dst), "dst"))
   return *this;
 }
 
@@ -142,7 +194,7 @@ Pipeline& Pipeline::assignment(const PipelineTensor::Slice& srcSlice, const Pipe
   return *this;
 }
 
-Pipeline& Pipeline::compareTo(const PipelineTensor::Compare& compare, const std::shared_ptr<PipelineTensor>& dst) {
+Pipeline& Pipeline::compareTo(const PipelineTensor::Compare& compare, TensorOperand dst) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorComparisonPICO comparisonConfig{.type = XR_TYPE_SECURE_MR_OPERATOR_COMPARISON_PICO,
                                                     .comparison = compare.comparison};
@@ -152,18 +204,15 @@ Pipeline& Pipeline::compareTo(const PipelineTensor::Compare& compare, const std:
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_CUSTOMIZED_COMPARE_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*compare.left),
-                                         "operand0");
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*compare.right),
-                                         "operand1");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, compare.left, "operand0");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, compare.right, "operand1");
 
-  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*dst),
-                                                    "result"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(dst), "result"))
   return *this;
 }
 
-Pipeline& Pipeline::arithmetic(const std::string& expression, const std::vector<std::shared_ptr<PipelineTensor>>& ops,
-                               const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::arithmetic(const std::string& expression, const std::vector<TensorOperand>& ops,
+                               TensorOperand result) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorArithmeticComposePICO arithmeticConfig{XR_TYPE_SECURE_MR_OPERATOR_ARITHMETIC_COMPOSE_PICO};
   std::strcpy(arithmeticConfig.configText, expression.c_str());
@@ -176,18 +225,15 @@ Pipeline& Pipeline::arithmetic(const std::string& expression, const std::vector<
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
   int operandIndex = 0;
   for (auto& operand : ops) {
-    xrSetSecureMrOperatorOperandByIndexPICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*operand),
-                                            operandIndex);
+    xrSetSecureMrOperatorOperandByIndexPICO(m_handle, opHandle, handleOf(operand), operandIndex);
     operandIndex++;
   }
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result),
-                                        "result");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result");
   return *this;
 }
 
-Pipeline& Pipeline::elementwise(const Pipeline::ElementwiseOp operation,
-                                const std::array<std::shared_ptr<PipelineTensor>, 2>& ops,
-                                const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::elementwise(const Pipeline::ElementwiseOp operation, const std::array<TensorOperand, 2>& ops,
+                                TensorOperand result) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
 
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO};
@@ -209,45 +255,36 @@ Pipeline& Pipeline::elementwise(const Pipeline::ElementwiseOp operation,
       break;
   }
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, ops[0]->operator XrSecureMrPipelineTensorPICO_T*(),
-                                         "operand0");
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, ops[1]->operator XrSecureMrPipelineTensorPICO_T*(),
-                                         "operand1");
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result),
-                                        "result");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(ops[0]), "operand0");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(ops[1]), "operand1");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result");
   return *this;
 }
 
-Pipeline& Pipeline::all(const std::shared_ptr<PipelineTensor>& op, const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::all(TensorOperand op, TensorOperand result) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{.type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
                                                       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_ALL_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, op->operator XrSecureMrPipelineTensorPICO_T*(),
-                                                     "operand"))
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result),
-                                        "result");
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(op), "operand"))
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result");
   return *this;
 }
 
-Pipeline& Pipeline::any(const std::shared_ptr<PipelineTensor>& op, const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::any(TensorOperand op, TensorOperand result) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{.type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
                                                       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_ANY_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, op->operator XrSecureMrPipelineTensorPICO_T*(),
-                                                     "operand"))
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result),
-                                        "result");
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(op), "operand"))
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result");
   return *this;
 }
 
-Pipeline& Pipeline::nms(const std::shared_ptr<PipelineTensor>& scores, std::shared_ptr<PipelineTensor>& boxes,
-                        const std::shared_ptr<PipelineTensor>& result_scores,
-                        const std::shared_ptr<PipelineTensor>& result_boxes,
-                        const std::shared_ptr<PipelineTensor>& result_indices, float threshold) {
+Pipeline& Pipeline::nms(TensorOperand scores, TensorOperand boxes, TensorOperand result_scores,
+                        TensorOperand result_boxes, TensorOperand result_indices, float threshold) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorNonMaximumSuppressionPICO nmsConfig{.type = XR_TYPE_SECURE_MR_OPERATOR_NON_MAXIMUM_SUPPRESSION_PICO,
                                                         .threshold = threshold};
@@ -257,61 +294,47 @@ Pipeline& Pipeline::nms(const std::shared_ptr<PipelineTensor>& scores, std::shar
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_NMS_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*scores, "scores"))
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*boxes, "boxes"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(scores), "scores"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(boxes), "boxes"))
   if (result_scores != nullptr) {
-    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_scores,
-                                                      "scores"))
+    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_scores), "scores"))
   }
   if (result_boxes != nullptr) {
-    CHECK_XRCMD(
-        xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_boxes, "boxes"))
+    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_boxes), "boxes"))
   }
   if (result_indices != nullptr) {
-    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_indices,
-                                                      "indices"))
+    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_indices), "indices"))
   }
   return *this;
 }
 
-Pipeline& Pipeline::solvePnP(const std::shared_ptr<PipelineTensor>& objectPoints,
-                             const std::shared_ptr<PipelineTensor>& imgPoints,
-                             const std::shared_ptr<PipelineTensor>& cameraMatrix,
-                             const std::shared_ptr<PipelineTensor>& result_rotation,
-                             const std::shared_ptr<PipelineTensor>& result_translation) {
+Pipeline& Pipeline::solvePnP(TensorOperand objectPoints, TensorOperand imgPoints, TensorOperand cameraMatrix,
+                             TensorOperand result_rotation, TensorOperand result_translation) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{.type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
                                                       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_SOLVE_P_N_P_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*objectPoints,
-                                         "object points");
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*imgPoints,
-                                                     "image points"))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*cameraMatrix,
-                                         "camera matrix");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(objectPoints), "object points");
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(imgPoints), "image points"))
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(cameraMatrix), "camera matrix");
   if (result_rotation != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_rotation,
-                                          "rotation");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_rotation), "rotation");
   }
   if (result_translation != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_translation,
-                                          "translation");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_translation), "translation");
   }
   return *this;
 }
 
-Pipeline& Pipeline::getAffine(const AffinePoints& srcPoints, const AffinePoints& dstPoints,
-                              const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::getAffine(const AffinePoints& srcPoints, const AffinePoints& dstPoints, TensorOperand result) {
   constexpr TensorAttribute_Point2Array POINT2F_ARRAY3{.size = 3,
                                                        .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO};
 
-  auto operandFromArray2_3 = [&POINT2F_ARRAY3](const std::shared_ptr<Pipeline>& pipeline,
-                                               std::array<float, 6> rawPoint2) {
-    const auto srcTensorPtr = std::make_shared<PipelineTensor>(pipeline, POINT2F_ARRAY3);
-    srcTensorPtr->setData(reinterpret_cast<int8_t*>(rawPoint2.data()), sizeof(float) * rawPoint2.size());
-    return static_cast<XrSecureMrPipelineTensorPICO>(*srcTensorPtr);
+  auto operandFromArray2_3 = [this, &POINT2F_ARRAY3](const std::array<float, 6>& rawPoint2) {
+    const auto srcTensor = createTensor(POINT2F_ARRAY3);
+    setData(srcTensor, reinterpret_cast<int8_t*>(const_cast<float*>(rawPoint2.data())), sizeof(rawPoint2));
+    return handleOf(srcTensor);
   };
 
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
@@ -319,68 +342,52 @@ Pipeline& Pipeline::getAffine(const AffinePoints& srcPoints, const AffinePoints&
                                                       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_GET_AFFINE_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  if (std::holds_alternative<std::shared_ptr<PipelineTensor>>(srcPoints)) {
-    const auto srcTensorPtr = std::get<std::shared_ptr<PipelineTensor>>(srcPoints);
-    CHECK_XRCMD(
-        xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*srcTensorPtr, "src"))
+  if (std::holds_alternative<TensorOperand>(srcPoints)) {
+    const auto srcTensorPtr = std::get<TensorOperand>(srcPoints);
+    CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(srcTensorPtr), "src"))
   } else {
     CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(
-        m_handle, opHandle, operandFromArray2_3(shared_from_this(), std::get<std::array<float, 6>>(srcPoints)), "src"))
+        m_handle, opHandle, operandFromArray2_3(std::get<std::array<float, 6>>(srcPoints)), "src"))
   }
-  if (std::holds_alternative<std::shared_ptr<PipelineTensor>>(dstPoints)) {
-    const auto dstTensorPtr = std::get<std::shared_ptr<PipelineTensor>>(dstPoints);
-    CHECK_XRCMD(
-        xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*dstTensorPtr, "dst"))
+  if (std::holds_alternative<TensorOperand>(dstPoints)) {
+    const auto dstTensorPtr = std::get<TensorOperand>(dstPoints);
+    CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(dstTensorPtr), "dst"))
   } else {
     CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(
-        m_handle, opHandle, operandFromArray2_3(shared_from_this(), std::get<std::array<float, 6>>(dstPoints)), "dst"))
+        m_handle, opHandle, operandFromArray2_3(std::get<std::array<float, 6>>(dstPoints)), "dst"))
   }
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result, "result"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result"))
 
   return *this;
 }
 
-Pipeline& Pipeline::applyAffine(const std::shared_ptr<PipelineTensor>& affine,
-                                const std::shared_ptr<PipelineTensor>& img,
-                                const std::shared_ptr<PipelineTensor>& result_img) {
+Pipeline& Pipeline::applyAffine(TensorOperand affine, TensorOperand img, TensorOperand result_img) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{.type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
                                                       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_APPLY_AFFINE_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*affine, "affine"))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*img, "src image"))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_img, "dst image"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(affine), "affine"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(img), "src image"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_img), "dst image"))
   return *this;
 }
 
-Pipeline& Pipeline::applyAffinePoint(const std::shared_ptr<PipelineTensor>& affine,
-                                     const std::shared_ptr<PipelineTensor>& points,
-                                     const std::shared_ptr<PipelineTensor>& result_points) {
+Pipeline& Pipeline::applyAffinePoint(TensorOperand affine, TensorOperand points, TensorOperand result_points) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_APPLY_AFFINE_POINT_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*affine, "affine"))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*points, "src points"))
-  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_points,
-                                                    "dst points"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(affine), "affine"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(points), "src points"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_points), "dst points"))
   return *this;
 }
 
-Pipeline& Pipeline::uv2Cam(const std::shared_ptr<PipelineTensor>& uv, const std::shared_ptr<PipelineTensor>& timestamp,
-                           const std::shared_ptr<PipelineTensor>& cameraMatrix,
-                           const std::shared_ptr<PipelineTensor>& leftImg,
-                           const std::shared_ptr<PipelineTensor>& rightImg,
-                           const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::uv2Cam(TensorOperand uv, TensorOperand timestamp, TensorOperand cameraMatrix, TensorOperand leftImg,
+                           TensorOperand rightImg, TensorOperand result) {
   // Check for null pointers
   CHECK_MSG(uv != nullptr, "uv2Cam uvPlaceholder1 is null")
   CHECK_MSG(timestamp != nullptr, "uv2Cam timestampPlaceholder1 is null")
@@ -397,22 +404,16 @@ Pipeline& Pipeline::uv2Cam(const std::shared_ptr<PipelineTensor>& uv, const std:
       XR_SECURE_MR_OPERATOR_TYPE_UV_TO_3D_IN_CAM_SPACE_PICO};
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &uvTo3DCreateInfoPico, &opHandle))
 
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*uv, "uv"))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*timestamp, "timestamp"))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*cameraMatrix,
-                                         "camera intrinsic");
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*leftImg, "left image"))
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*rightImg,
-                                                     "right image"))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result, "point_xyz"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(uv), "uv"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(timestamp), "timestamp"))
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(cameraMatrix), "camera intrinsic");
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(leftImg), "left image"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(rightImg), "right image"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "point_xyz"))
   return *this;
 }
 
-Pipeline& Pipeline::normalize(const std::shared_ptr<PipelineTensor>& src, const std::shared_ptr<PipelineTensor>& result,
-                              const Pipeline::NormalizeType type) {
+Pipeline& Pipeline::normalize(TensorOperand src, TensorOperand result, const Pipeline::NormalizeType type) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorNormalizePICO normalizeConfig{.type = XR_TYPE_SECURE_MR_OPERATOR_NORMALIZE_PICO,
                                                   .normalizeType = static_cast<XrSecureMrNormalizeTypePICO>(type)};
@@ -422,39 +423,31 @@ Pipeline& Pipeline::normalize(const std::shared_ptr<PipelineTensor>& src, const
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_NORMALIZE_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*src, "operand0"))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result, "result"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(src), "operand0"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result"))
   return *this;
 }
 
-Pipeline& Pipeline::camSpace2XrLocal(const std::shared_ptr<PipelineTensor>& timestamp,
-                                     const std::shared_ptr<PipelineTensor>& result_rightEyeTransform,
-                                     const std::shared_ptr<PipelineTensor>& result_leftEyeTransform) {
+Pipeline& Pipeline::camSpace2XrLocal(TensorOperand timestamp, TensorOperand result_rightEyeTransform,
+                                     TensorOperand result_leftEyeTransform) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_CAMERA_SPACE_TO_WORLD_PICO};
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(
-      xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*timestamp, "timestamp"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(timestamp), "timestamp"))
   if (result_leftEyeTransform != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_leftEyeTransform,
-                                          "left");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_leftEyeTransform), "left");
   }
   if (result_rightEyeTransform != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_rightEyeTransform,
-                                          "right");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_rightEyeTransform), "right");
   }
   return *this;
 }
 
-Pipeline& Pipeline::cameraAccess(const std::shared_ptr<PipelineTensor>& result_rightEye,
-                                 const std::shared_ptr<PipelineTensor>& result_leftEye,
-                                 const std::shared_ptr<PipelineTensor>& result_timeStamp,
-                                 const std::shared_ptr<PipelineTensor>& result_camMatrix) {
+Pipeline& Pipeline::cameraAccess(TensorOperand result_rightEye, TensorOperand result_leftEye,
+                                 TensorOperand result_timeStamp, TensorOperand result_camMatrix) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
@@ -462,26 +455,21 @@ Pipeline& Pipeline::cameraAccess(const std::shared_ptr<PipelineTensor>& result_r
 
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
   if (result_leftEye != nullptr) {
-    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_leftEye,
-                                                      "left image"))
+    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_leftEye), "left image"))
   }
   if (result_rightEye != nullptr) {
-    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                                      (XrSecureMrPipelineTensorPICO)*result_rightEye, "right image"))
+    CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_rightEye), "right image"))
   }
   if (result_timeStamp != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_timeStamp,
-                                          "timestamp");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_timeStamp), "timestamp");
   }
   if (result_camMatrix != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, (XrSecureMrPipelineTensorPICO)*result_camMatrix,
-                                          "camera matrix");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_camMatrix), "camera matrix");
   }
   return *this;
 }
 
-Pipeline& Pipeline::argMax(const std::shared_ptr<PipelineTensor>& src,
-                           const std::shared_ptr<PipelineTensor>& result_indexPerChannel) {
+Pipeline& Pipeline::argMax(TensorOperand src, TensorOperand result_indexPerChannel) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
 
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
@@ -489,15 +477,12 @@ Pipeline& Pipeline::argMax(const std::shared_ptr<PipelineTensor>& src,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_ARGMAX_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*src),
-                                         "operand");
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                        static_cast<XrSecureMrPipelineTensorPICO>(*result_indexPerChannel), "result");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(src), "operand");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_indexPerChannel), "result");
   return *this;
 }
 
-Pipeline& Pipeline::cvtColor(const int convertFlag, const std::shared_ptr<PipelineTensor>& image,
-                             const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::cvtColor(const int convertFlag, TensorOperand image, TensorOperand result) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorColorConvertPICO convertConfig{.type = XR_TYPE_SECURE_MR_OPERATOR_COLOR_CONVERT_PICO,
                                                    .convert = convertFlag};
@@ -507,16 +492,12 @@ Pipeline& Pipeline::cvtColor(const int convertFlag, const std::shared_ptr<Pipeli
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_CONVERT_COLOR_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle,
-                                                     static_cast<XrSecureMrPipelineTensorPICO>(*image), "src"))
-  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                                    static_cast<XrSecureMrPipelineTensorPICO>(*result), "dst"))
+  CHECK_XRCMD(xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(image), "src"))
+  CHECK_XRCMD(xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "dst"))
   return *this;
 }
 
-Pipeline& Pipeline::sortVec(const std::shared_ptr<PipelineTensor>& srcVec,
-                            const std::shared_ptr<PipelineTensor>& result_sortedVec,
-                            const std::shared_ptr<PipelineTensor>& result_indices) {
+Pipeline& Pipeline::sortVec(TensorOperand srcVec, TensorOperand result_sortedVec, TensorOperand result_indices) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
 
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
@@ -524,22 +505,18 @@ Pipeline& Pipeline::sortVec(const std::shared_ptr<PipelineTensor>& srcVec,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_SORT_VEC_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*srcVec),
-                                         "input");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(srcVec), "input");
   if (result_sortedVec != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                          static_cast<XrSecureMrPipelineTensorPICO>(*result_sortedVec), "sorted");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_sortedVec), "sorted");
   }
   if (result_indices != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                          static_cast<XrSecureMrPipelineTensorPICO>(*result_indices), "indices");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_indices), "indices");
   }
   return *this;
 }
 
-Pipeline& Pipeline::sortMatByRow(const std::shared_ptr<PipelineTensor>& srcMat,
-                                 const std::shared_ptr<PipelineTensor>& result_sortedMat,
-                                 const std::shared_ptr<PipelineTensor>& result_indicesPerRow) {
+Pipeline& Pipeline::sortMatByRow(TensorOperand srcMat, TensorOperand result_sortedMat,
+                                 TensorOperand result_indicesPerRow) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorSortMatrixPICO sortType{.type = XR_TYPE_SECURE_MR_OPERATOR_SORT_MATRIX_PICO,
                                             .sortType = XR_SECURE_MR_MATRIX_SORT_TYPE_ROW_PICO};
@@ -549,22 +526,18 @@ Pipeline& Pipeline::sortMatByRow(const std::shared_ptr<PipelineTensor>& srcMat,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_SORT_MAT_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*srcMat),
-                                         "input");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(srcMat), "input");
   if (result_sortedMat != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                          static_cast<XrSecureMrPipelineTensorPICO>(*result_sortedMat), "sorted");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_sortedMat), "sorted");
   }
   if (result_indicesPerRow != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                          static_cast<XrSecureMrPipelineTensorPICO>(*result_indicesPerRow), "indices");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_indicesPerRow), "indices");
   }
   return *this;
 }
 
-Pipeline& Pipeline::sortMatByColumn(const std::shared_ptr<PipelineTensor>& srcMat,
-                                    const std::shared_ptr<PipelineTensor>& result_sortedMat,
-                                    const std::shared_ptr<PipelineTensor>& result_indicesPerColumn) {
+Pipeline& Pipeline::sortMatByColumn(TensorOperand srcMat, TensorOperand result_sortedMat,
+                                    TensorOperand result_indicesPerColumn) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorSortMatrixPICO sortType{.type = XR_TYPE_SECURE_MR_OPERATOR_SORT_MATRIX_PICO,
                                             .sortType = XR_SECURE_MR_MATRIX_SORT_TYPE_COLUMN_PICO};
@@ -574,129 +547,102 @@ Pipeline& Pipeline::sortMatByColumn(const std::shared_ptr<PipelineTensor>& srcMa
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_SORT_MAT_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*srcMat),
-                                         "operand0");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(srcMat), "operand0");
   if (result_sortedMat != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                          static_cast<XrSecureMrPipelineTensorPICO>(*result_sortedMat), "sorted");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_sortedMat), "sorted");
   }
   if (result_indicesPerColumn != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(
-        m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result_indicesPerColumn), "indices");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_indicesPerColumn), "indices");
   }
   return *this;
 }
 
-Pipeline& Pipeline::singularValueDecomposition(const std::shared_ptr<PipelineTensor>& src,
-                                               const std::shared_ptr<PipelineTensor>& result_w,
-                                               const std::shared_ptr<PipelineTensor>& result_u,
-                                               const std::shared_ptr<PipelineTensor>& result_vt) {
+Pipeline& Pipeline::singularValueDecomposition(TensorOperand src, TensorOperand result_w, TensorOperand result_u,
+                                               TensorOperand result_vt) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_SVD_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*src), "src");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(src), "src");
   if (result_w != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result_w),
-                                          "w");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_w), "w");
   }
   if (result_u != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result_u),
-                                          "u");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_u), "u");
   }
   if (result_vt != nullptr) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result_vt),
-                                          "vt");
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_vt), "vt");
   }
   return *this;
 }
 
-Pipeline& Pipeline::norm(const std::shared_ptr<PipelineTensor>& src,
-                         const std::shared_ptr<PipelineTensor>& result_norm) {
+Pipeline& Pipeline::norm(TensorOperand src, TensorOperand result_norm) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_NORM_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*src),
-                                         "operand0");
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result_norm),
-                                        "result0");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(src), "operand0");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_norm), "result0");
   return *this;
 }
 
-Pipeline& Pipeline::convertHWC_CHW(const std::shared_ptr<PipelineTensor>& src,
-                                   const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::convertHWC_CHW(TensorOperand src, TensorOperand result) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_SWAP_HWC_CHW_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*src),
-                                         "operand0");
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result),
-                                        "result0");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(src), "operand0");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result0");
   return *this;
 }
 
-Pipeline& Pipeline::inversion(const std::shared_ptr<PipelineTensor>& srcMat,
-                              const std::shared_ptr<PipelineTensor>& result_inverted) {
+Pipeline& Pipeline::inversion(TensorOperand srcMat, TensorOperand result_inverted) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_INVERSION_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*srcMat),
-                                         "operand");
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result_inverted),
-                                        "result");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(srcMat), "operand");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_inverted), "result");
   return *this;
 }
 
-Pipeline& Pipeline::transform(const std::shared_ptr<PipelineTensor>& rotation,
-                              const std::shared_ptr<PipelineTensor>& translation,
-                              const std::shared_ptr<PipelineTensor>& scale,
-                              const std::shared_ptr<PipelineTensor>& result) {
+Pipeline& Pipeline::transform(TensorOperand rotation, TensorOperand translation, TensorOperand scale,
+                              TensorOperand result) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_GET_TRANSFORM_MAT_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*rotation),
-                                         "rotation");
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*translation),
-                                         "translation");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(rotation), "rotation");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(translation), "translation");
   if (scale != nullptr) {
-    xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*scale),
-                                           "scale");
+    xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(scale), "scale");
   }
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result),
-                                        "result");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result), "result");
   return *this;
 }
 
-Pipeline& Pipeline::newTextureToGLTF(const std::shared_ptr<PipelineTensor>& gltfPlaceholder,
-                                     const std::shared_ptr<PipelineTensor>& textureSrc,
-                                     const std::shared_ptr<PipelineTensor>& result_newTextureId) {
+Pipeline& Pipeline::newTextureToGLTF(TensorOperand gltfPlaceholder, TensorOperand textureSrc,
+                                     TensorOperand result_newTextureId) {
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
   XrSecureMrOperatorCreateInfoPICO operatorCreateInfo{
       .type = XR_TYPE_SECURE_MR_OPERATOR_CREATE_INFO_PICO,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_LOAD_TEXTURE_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle,
-                                         static_cast<XrSecureMrPipelineTensorPICO>(*gltfPlaceholder), "gltf");
-  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*textureSrc),
-                                         "rgb image");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(gltfPlaceholder), "gltf");
+  xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(textureSrc), "rgb image");
 
-  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle,
-                                        static_cast<XrSecureMrPipelineTensorPICO>(*result_newTextureId), "texture ID");
+  xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result_newTextureId), "texture ID");
   return *this;
 }
 
@@ -707,38 +653,116 @@ Pipeline& Pipeline::execRenderCommand(const std::shared_ptr<RenderCommand>& comm
   return *this;
 }
 
+ModelIoLayout LayoutOf(const TensorAttribute& attribute) {
+  if (attribute.usage != XR_SECURE_MR_TENSOR_TYPE_MAT_PICO) return ModelIoLayout::ANY;
+  if (attribute.dimensions.size() == 2 && attribute.channels > 1) return ModelIoLayout::HWC;
+  if (attribute.dimensions.size() == 3 && attribute.channels == 1 && attribute.dimensions[0] > 1) {
+    return ModelIoLayout::CHW;
+  }
+  return ModelIoLayout::ANY;
+}
+
+/**
+ * The attribute of the result of <code>Pipeline::convertHWC_CHW</code> on a tensor of the given attribute
+ */
+static TensorAttribute transposedHWC_CHW(const TensorAttribute& attribute) {
+  auto transposed = attribute;
+  switch (LayoutOf(attribute)) {
+    case ModelIoLayout::HWC:
+      transposed.dimensions = {attribute.channels, attribute.dimensions[0], attribute.dimensions[1]};
+      transposed.channels = 1;
+      break;
+    case ModelIoLayout::CHW:
+      transposed.dimensions = {attribute.dimensions[1], attribute.dimensions[2]};
+      transposed.channels = static_cast<int8_t>(attribute.dimensions[0]);
+      break;
+    default:
+      THROW("convertHWC_CHW(...) requires an HWC or a CHW tensor");
+  }
+  return transposed;
+}
+
+static XrSecureMrTensorDataTypePICO storageTypeOf(const XrSecureMrModelEncodingPICO encoding) {
+  switch (encoding) {
+    case XR_SECURE_MR_MODEL_ENCODING_FLOAT_32_PICO:
+      return XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO;
+    case XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT8_PICO:
+      return XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO;
+    case XR_SECURE_MR_MODEL_ENCODING_SFIXED_POINT8_PICO:
+      return XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO;
+    case XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT16_PICO:
+      return XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO;
+    case XR_SECURE_MR_MODEL_ENCODING_INT32_PICO:
+      return XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO;
+    default:
+      THROW(Fmt("Unknown model encoding %d", static_cast<int>(encoding)));
+  }
+}
+
+/**
+ * The range of a fixed-point data type, as the FLOAT32 values converting into it
+ */
+static std::pair<float, float> storageRangeOf(const XrSecureMrTensorDataTypePICO dataType) {
+  switch (dataType) {
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+      return {0.0f, 255.0f};
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+      return {-128.0f, 127.0f};
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+      return {0.0f, 65535.0f};
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+      // The largest FLOAT32 below 2^31
+      return {-2147483648.0f, 2147483520.0f};
+    default:
+      THROW(Fmt("No fixed-point range for data type %d", static_cast<int>(dataType)));
+  }
+}
+
 static std::vector<XrSecureMrOperatorIOMapPICO> prepareIoMap(
-    const std::unordered_map<std::string, std::shared_ptr<PipelineTensor>>& tensors,
-    const std::unordered_map<std::string, std::string>& aliasing) {
+    const std::vector<std::pair<std::string, std::variant<std::monostate, TensorAttribute>>>& tensors,
+    const std::unordered_map<std::string, std::string>& aliasing,
+    const std::unordered_map<std::string, ModelIoEncoding>& encodings) {
   std::vector<XrSecureMrOperatorIOMapPICO> ioMaps;
 
   for (auto& tensorPair : tensors) {
-    auto attribute = tensorPair.second->getAttribute();
+    const auto& attribute = tensorPair.second;
     CHECK_MSG(!std::holds_alternative<std::monostate>(attribute), "Customized algorithm operator not for GLTF tensors")
     const auto& tensorAttribute = std::get<TensorAttribute>(attribute);
 
     XrSecureMrModelEncodingPICO ecd;
-    switch (tensorAttribute.dataType) {
-      case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
-        ecd = XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT8_PICO;
-        break;
-      case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
-        ecd = XR_SECURE_MR_MODEL_ENCODING_SFIXED_POINT8_PICO;
-        break;
-      case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
-        Write(Log::Level::Warning, "INT16 will be interpreted as unsigned 16-bit fixed point");
-      // fall-through
-      case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
-        ecd = XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT16_PICO;
-        break;
-      case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
-        ecd = XR_SECURE_MR_MODEL_ENCODING_INT32_PICO;
-        break;
-      case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
-        ecd = XR_SECURE_MR_MODEL_ENCODING_FLOAT_32_PICO;
-        break;
-      default:
-        THROW("float64 is not supported as a customized algorithm operator's operand");
+    if (const auto explicitEncoding = encodings.find(tensorPair.first);
+        explicitEncoding != encodings.end() && explicitEncoding->second.encoding.has_value()) {
+      ecd = *explicitEncoding->second.encoding;
+      CHECK_MSG(tensorAttribute.dataType == storageTypeOf(ecd) ||
+                    (tensorAttribute.dataType == XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO &&
+                     ecd == XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT16_PICO),
+                Fmt("Model I/O \"%s\": encoding %d cannot be read from or written to a tensor of data type %d",
+                    tensorPair.first.c_str(), static_cast<int>(ecd), static_cast<int>(tensorAttribute.dataType)))
+    } else {
+      switch (tensorAttribute.dataType) {
+        case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+          ecd = XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT8_PICO;
+          break;
+        case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+          ecd = XR_SECURE_MR_MODEL_ENCODING_SFIXED_POINT8_PICO;
+          break;
+        case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
+          Write(Log::Level::Warning, Fmt("INT16 model I/O \"%s\" will be interpreted as unsigned 16-bit fixed point, "
+                                         "unless given an explicit encoding",
+                                         tensorPair.first.c_str()));
+        // fall-through
+        case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+          ecd = XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT16_PICO;
+          break;
+        case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+          ecd = XR_SECURE_MR_MODEL_ENCODING_INT32_PICO;
+          break;
+        case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
+          ecd = XR_SECURE_MR_MODEL_ENCODING_FLOAT_32_PICO;
+          break;
+        default:
+          THROW("float64 is not supported as a customized algorithm operator's operand");
+      }
     }
     ioMaps.emplace_back(XrSecureMrOperatorIOMapPICO{
         .type = XR_TYPE_SECURE_MR_OPERATOR_IO_MAP_PICO,
@@ -752,15 +776,155 @@ static std::vector<XrSecureMrOperatorIOMapPICO> prepareIoMap(
   return ioMaps;
 }
 
+/**
+ * Arithmetic expression of <code>{0}</code> adding <code>value</code>, with the sign in the operator
+ */
+static std::string plusOffset(const std::string& expression, const int32_t value) {
+  if (value == 0) return expression;
+  return Fmt(value > 0 ? "%s + %d" : "%s - %d", expression.c_str(), value > 0 ? value : -value);
+}
+
 Pipeline& Pipeline::runAlgorithm(char* algPackageBuf, size_t algPackageSize,
                                  const std::unordered_map<std::string, std::shared_ptr<PipelineTensor>>& algOps,
                                  const std::unordered_map<std::string, std::string>& operandAliasing,
                                  const std::unordered_map<std::string, std::shared_ptr<PipelineTensor>>& algResults,
                                  const std::unordered_map<std::string, std::string>& resultAliasing,
-                                 const std::string& modelName) {
+                                 const std::string& modelName,
+                                 const std::unordered_map<std::string, ModelIoEncoding>& operandEncodings,
+                                 const std::unordered_map<std::string, ModelIoEncoding>& resultEncodings) {
+  std::vector<std::pair<std::string, TensorOperand>> operands(algOps.begin(), algOps.end());
+  std::vector<std::pair<std::string, TensorOperand>> results(algResults.begin(), algResults.end());
+  return addModelOperator(algPackageBuf, algPackageSize, operands, operandAliasing, results, resultAliasing,
+                          modelName, operandEncodings, resultEncodings);
+}
+
+Pipeline& Pipeline::runAlgorithm(char* algPackageBuf, size_t algPackageSize,
+                                 const std::unordered_map<std::string, TensorRef>& algOps,
+                                 const std::unordered_map<std::string, std::string>& operandAliasing,
+                                 const std::unordered_map<std::string, TensorRef>& algResults,
+                                 const std::unordered_map<std::string, std::string>& resultAliasing,
+                                 const std::string& modelName,
+                                 const std::unordered_map<std::string, ModelIoEncoding>& operandEncodings,
+                                 const std::unordered_map<std::string, ModelIoEncoding>& resultEncodings) {
+  std::vector<std::pair<std::string, TensorOperand>> operands(algOps.begin(), algOps.end());
+  std::vector<std::pair<std::string, TensorOperand>> results(algResults.begin(), algResults.end());
+  return addModelOperator(algPackageBuf, algPackageSize, operands, operandAliasing, results, resultAliasing,
+                          modelName, operandEncodings, resultEncodings);
+}
+
+Pipeline& Pipeline::addModelOperator(char* algPackageBuf, size_t algPackageSize,
+                                     const std::vector<std::pair<std::string, TensorOperand>>& algOps,
+                                     const std::unordered_map<std::string, std::string>& operandAliasing,
+                                     const std::vector<std::pair<std::string, TensorOperand>>& algResults,
+                                     const std::unordered_map<std::string, std::string>& resultAliasing,
+                                     const std::string& modelName,
+                                     const std::unordered_map<std::string, ModelIoEncoding>& operandEncodings,
+                                     const std::unordered_map<std::string, ModelIoEncoding>& resultEncodings) {
+  // A tensor of the other layout than the model's, or a float32 tensor of a fixed-point encoding, is bound through
+  // a local tensor of the model's layout and of the encoding's data type
+  const auto transposedFor = [this](const TensorOperand tensor,
+                                    const ModelIoEncoding& encoding) -> std::optional<TensorRef> {
+    const auto attribute = attributeOf(tensor);
+    if (!std::holds_alternative<TensorAttribute>(attribute)) return std::nullopt;
+    const auto layout = LayoutOf(std::get<TensorAttribute>(attribute));
+    if (encoding.layout == ModelIoLayout::ANY || layout == ModelIoLayout::ANY || layout == encoding.layout) {
+      return std::nullopt;
+    }
+    return createTensor(transposedHWC_CHW(std::get<TensorAttribute>(attribute)));
+  };
+  const auto quantizedFor = [this](const TensorOperand tensor,
+                                   const ModelIoEncoding& encoding) -> std::optional<TensorRef> {
+    const auto attribute = attributeOf(tensor);
+    if (!std::holds_alternative<TensorAttribute>(attribute)) return std::nullopt;
+    auto staged = std::get<TensorAttribute>(attribute);
+    if (staged.dataType != XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO || !encoding.encoding.has_value() ||
+        *encoding.encoding == XR_SECURE_MR_MODEL_ENCODING_FLOAT_32_PICO) {
+      return std::nullopt;
+    }
+    CHECK_MSG(encoding.scale != 0.0f, "Pipeline::runAlgorithm(...) fixed-point encoding of scale 0")
+    staged.dataType = storageTypeOf(*encoding.encoding);
+    return createTensor(staged);
+  };
+
+  // stored = round(real / scale + offset), clamped to the range of the stored data type, with the rounding half away
+  // from zero done before typeConvert, which truncates
+  const auto quantize = [this](const TensorOperand real, const TensorRef stored, const ModelIoEncoding& encoding) {
+    const auto attribute = std::get<TensorAttribute>(attributeOf(real));
+    const auto [lowest, highest] = storageRangeOf(storageTypeOf(*encoding.encoding));
+    const bool isSigned = lowest < 0.0f;
+    const auto constant = [this, &attribute](const float value) {
+      std::vector<float> data(TensorByteSize(attribute) / sizeof(float), value);
+      const auto tensor = createTensor(attribute);
+      setData(tensor, reinterpret_cast<int8_t*>(data.data()), data.size() * sizeof(float));
+      return tensor;
+    };
+    const auto scaled = createTensor(attribute);
+    // Unsigned values are rounded up from one half before the clamp, which keeps them non-negative
+    const auto expression = Fmt("{0} / %.9g", encoding.scale);
+    arithmetic(plusOffset(isSigned ? expression : expression + " + 0.5", encoding.offset), {real}, scaled)
+        .elementwise(ElementwiseOp::MAX, {scaled, constant(lowest)}, scaled)
+        .elementwise(ElementwiseOp::MIN, {scaled, constant(isSigned ? highest : highest + 0.5f)}, scaled);
+    if (isSigned) {
+      const auto zero = constant(0.0f);
+      const auto negative = createTensor(attribute);
+      compareTo({.left = handleOf(scaled),
+                 .right = handleOf(zero),
+                 .comparison = XR_SECURE_MR_COMPARISON_SMALLER_THAN_PICO},
+                negative)
+          .arithmetic("{0} + 0.5 - {1}", {scaled, negative}, scaled);
+    }
+    typeConvert(scaled, stored);
+  };
+
+  auto operands = algOps;
+  for (auto& [name, tensor] : operands) {
+    const auto it = operandEncodings.find(name);
+    if (it == operandEncodings.end()) continue;
+    const auto& encoding = it->second;
+    if (const auto transposed = transposedFor(tensor, encoding); transposed.has_value()) {
+      convertHWC_CHW(tensor, *transposed);
+      tensor = *transposed;
+    }
+    if (const auto quantized = quantizedFor(tensor, encoding); quantized.has_value()) {
+      quantize(tensor, *quantized, encoding);
+      tensor = *quantized;
+    }
+  }
+
+  // Conversions from what the model writes to each result tensor, a transpose if without dequantization, in the
+  // reverse order
+  struct ResultConversion {
+    TensorOperand written;
+    TensorOperand result;
+    const ModelIoEncoding* dequantization = nullptr;
+  };
+  std::vector<ResultConversion> resultConversions;
+  auto results = algResults;
+  for (auto& [name, tensor] : results) {
+    const auto it = resultEncodings.find(name);
+    if (it == resultEncodings.end()) continue;
+    const auto& encoding = it->second;
+    if (const auto transposed = transposedFor(tensor, encoding); transposed.has_value()) {
+      resultConversions.push_back({.written = *transposed, .result = tensor});
+      tensor = *transposed;
+    }
+    if (const auto quantized = quantizedFor(tensor, encoding); quantized.has_value()) {
+      resultConversions.push_back({.written = *quantized, .result = tensor, .dequantization = &encoding});
+      tensor = *quantized;
+    }
+  }
+
+  const auto attributesOf = [this](const std::vector<std::pair<std::string, TensorOperand>>& tensors) {
+    std::vector<std::pair<std::string, std::variant<std::monostate, TensorAttribute>>> attributes;
+    attributes.reserve(tensors.size());
+    for (const auto& [name, tensor] : tensors) attributes.emplace_back(name, attributeOf(tensor));
+    return attributes;
+  };
   XrSecureMrOperatorPICO opHandle = XR_NULL_HANDLE;
-  std::vector<XrSecureMrOperatorIOMapPICO> inputConfigs = prepareIoMap(algOps, operandAliasing);
-  std::vector<XrSecureMrOperatorIOMapPICO> outputConfigs = prepareIoMap(algResults, resultAliasing);
+  std::vector<XrSecureMrOperatorIOMapPICO> inputConfigs =
+      prepareIoMap(attributesOf(operands), operandAliasing, operandEncodings);
+  std::vector<XrSecureMrOperatorIOMapPICO> outputConfigs =
+      prepareIoMap(attributesOf(results), resultAliasing, resultEncodings);
   XrSecureMrOperatorModelPICO algConfig{.type = XR_TYPE_SECURE_MR_OPERATOR_MODEL_PICO,
                                         .modelInputCount = static_cast<uint32_t>(inputConfigs.size()),
                                         .modelInputs = inputConfigs.data(),
@@ -776,26 +940,62 @@ Pipeline& Pipeline::runAlgorithm(char* algPackageBuf, size_t algPackageSize,
       .operatorType = XR_SECURE_MR_OPERATOR_TYPE_RUN_MODEL_INFERENCE_PICO,
   };
   CHECK_XRCMD(xrCreateSecureMrOperatorPICO(m_handle, &operatorCreateInfo, &opHandle))
-  for (auto& operand : algOps) {
-    xrSetSecureMrOperatorOperandByNamePICO(
-        m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*operand.second), operand.first.c_str());
+  for (auto& operand : operands) {
+    xrSetSecureMrOperatorOperandByNamePICO(m_handle, opHandle, handleOf(operand.second), operand.first.c_str());
+  }
+  for (auto& result : results) {
+    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, handleOf(result.second), result.first.c_str());
   }
-  for (auto& result : algResults) {
-    xrSetSecureMrOperatorResultByNamePICO(m_handle, opHandle, static_cast<XrSecureMrPipelineTensorPICO>(*result.second),
-                                          result.first.c_str());
+
+  for (auto conversion = resultConversions.rbegin(); conversion != resultConversions.rend(); ++conversion) {
+    if (conversion->dequantization == nullptr) {
+      convertHWC_CHW(conversion->written, conversion->result);
+      continue;
+    }
+    // real = scale * (stored - offset)
+    const auto& encoding = *conversion->dequantization;
+    typeConvert(conversion->written, conversion->result);
+    if (encoding.scale != 1.0f || encoding.offset != 0) {
+      arithmetic(Fmt("(%s) * %.9g", plusOffset("{0}", -encoding.offset).c_str(), encoding.scale),
+                 {conversion->result}, conversion->result);
+    }
   }
   return *this;
 }
 
+Pipeline& Pipeline::widen(const TensorOperand stored, const TensorOperand logical, const float scale) {
+  typeConvert(stored, logical);
+  if (scale != 1.0f) arithmetic(Fmt("{0} / %.9g", scale), {logical}, logical);
+  return *this;
+}
+
+Pipeline& Pipeline::narrow(const TensorOperand logical, const TensorOperand stored, const float scale) {
+  if (scale == 1.0f) return typeConvert(logical, stored);
+  const auto attribute = attributeOf(logical);
+  CHECK_MSG(std::holds_alternative<TensorAttribute>(attribute), "Pipeline::narrow(...) cannot narrow a glTF tensor")
+  const auto scaled = createTensor(std::get<TensorAttribute>(attribute));
+  return arithmetic(Fmt("{0} * %.9g", scale), {logical}, scaled).typeConvert(scaled, stored);
+}
+
+Pipeline& Pipeline::narrowAtSubmit(const std::shared_ptr<PipelineTensor>& logical,
+                                   const std::shared_ptr<PipelineTensor>& stored, const float scale) {
+  CHECK_MSG(verifyPipelineTensor(logical) && verifyPipelineTensor(stored),
+            "Pipeline::narrowAtSubmit(...) tensors of another pipeline")
+  m_pendingNarrows.push_back({.logical = logical, .stored = stored, .scale = scale});
+  return *this;
+}
+
 XrSecureMrPipelineRunPICO Pipeline::submit(
     const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap,
     XrSecureMrPipelineRunPICO waitFor, const std::shared_ptr<GlobalTensor>& condition) {
+  for (const auto& pending : m_pendingNarrows) narrow(pending.logical, pending.stored, pending.scale);
+  m_pendingNarrows.clear();
   std::vector<XrSecureMrPipelineIOPairPICO> pairs;
   pairs.reserve(argumentMap.size());
   for (auto& eachPair : argumentMap) {
     pairs.emplace_back(XrSecureMrPipelineIOPairPICO{
         .type = XR_TYPE_SECURE_MR_PIPELINE_IO_PAIR_PICO,
-        .localPlaceHolderTensor = static_cast<XrSecureMrPipelineTensorPICO>(*eachPair.first),
+        .localPlaceHolderTensor = handleOf(eachPair.first),
         .globalTensor = static_cast<XrSecureMrTensorPICO>(*eachPair.second)});
   }
   XrSecureMrPipelineExecuteParameterPICO runParam{
@@ -805,7 +1005,15 @@ XrSecureMrPipelineRunPICO Pipeline::submit(
       .pairCount = static_cast<uint32_t>(pairs.size()),
       .pipelineIOPair = pairs.data()};
   XrSecureMrPipelineRunPICO runHandle;
+  const auto recorder = TraceRecorder::Active();
+  const auto submitStart = std::chrono::steady_clock::now();
   CHECK_XRCMD(xrExecuteSecureMrPipelinePICO(m_handle, &runParam, &runHandle))
+  if (m_rootSession != nullptr) m_rootSession->bandwidth().recordSubmit(this, argumentMap, condition.get());
+  if (recorder != nullptr) {
+    const auto submitDuration = std::chrono::steady_clock::now() - submitStart;
+    recorder->recordSubmit(*this, argumentMap, waitFor, condition, runHandle,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(submitDuration).count());
+  }
   return runHandle;
 }
 }  // namespace SecureMR
@@ -20,13 +20,60 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <utility>
+#include <variant>
+#include <memory>
+#include <optional>
 
 #include "tensor.h"
+#include "tensorref.h"
 
 namespace SecureMR {
 
 class PipelineTensor;
+class TensorArena;
 struct RenderCommand;
+struct TensorAttribute;
+template <typename Spec>
+class TypedPipelineTensor;
+
+/**
+ * Memory layout of an image-like model input or output, as declared by the model, e.g., by the
+ * <code>Layout</code> entries of <code>Docker/custom_io.yaml</code>: <code>HWC</code> for <code>NHWC</code>, and
+ * <code>CHW</code> for <code>NCHW</code>. An HWC tensor has dimensions <code>(H, W)</code> and <code>C</code>
+ * channels, a CHW tensor dimensions <code>(C, H, W)</code> and 1 channel, as for <code>Pipeline::convertHWC_CHW
+ * </code>.
+ */
+enum class ModelIoLayout { ANY, HWC, CHW };
+
+/**
+ * Layout of a tensor as read by <code>Pipeline::convertHWC_CHW</code>: HWC for a multi-channel matrix, CHW for a
+ * single-channel stack of planes, or <code>ModelIoLayout::ANY</code> if it can be read as both or neither, e.g., a
+ * single-channel image
+ */
+ModelIoLayout LayoutOf(const TensorAttribute& attribute);
+
+/**
+ * Encoding of one input or output of the model run by <code>Pipeline::runAlgorithm</code>, overriding the one
+ * derived from the data type of its tensor.
+ * <br/>
+ * A tensor whose data type stores the encoding, e.g., uint8 for <code>XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT8_PICO
+ * </code>, is bound to the model as is: a quantized model then consumes uint8 camera frames without any conversion.
+ * <code>scale</code> and <code>offset</code> are the quantization of the model, <code>real = scale * (stored -
+ * offset)</code>, used only to convert a float32 tensor to or from a fixed-point encoding; the runtime takes them
+ * from the model package itself.
+ * <br/>
+ * Likewise, a tensor in the other <code>layout</code> than the model's is transposed into or from a local tensor.
+ */
+struct ModelIoEncoding {
+  /**
+   * Empty for the encoding derived from the data type of the tensor
+   */
+  std::optional<XrSecureMrModelEncodingPICO> encoding;
+  float scale = 1.0f;
+  int32_t offset = 0;
+  ModelIoLayout layout = ModelIoLayout::ANY;
+};
 
 /**
  * Pipeline, an adapter for <code>XrSecureMrPipelinePICO</code> handle. By using the class:
@@ -45,6 +92,15 @@ struct RenderCommand;
  */
 class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public std::enable_shared_from_this<Pipeline> {
   const std::shared_ptr<FrameworkSession> m_rootSession;
+  uint32_t m_id = 0;
+  std::unique_ptr<TensorArena> m_arena;
+
+  struct PendingNarrow {
+    std::shared_ptr<PipelineTensor> logical;
+    std::shared_ptr<PipelineTensor> stored;
+    float scale = 1.0f;
+  };
+  std::vector<PendingNarrow> m_pendingNarrows;
 
  protected:
   PFN_xrCreateSecureMrPipelinePICO xrCreateSecureMrPipelinePICO = nullptr;
@@ -69,6 +125,17 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    */
   [[nodiscard]] bool verifyPipelineTensor(const std::shared_ptr<PipelineTensor>& candidateTensor) const;
 
+  void checkRef(TensorRef tensor) const;
+
+  Pipeline& addModelOperator(char* algPackageBuf, size_t algPackageSize,
+                             const std::vector<std::pair<std::string, TensorOperand>>& algOps,
+                             const std::unordered_map<std::string, std::string>& operandAliasing,
+                             const std::vector<std::pair<std::string, TensorOperand>>& algResults,
+                             const std::unordered_map<std::string, std::string>& resultAliasing,
+                             const std::string& modelName,
+                             const std::unordered_map<std::string, ModelIoEncoding>& operandEncodings,
+                             const std::unordered_map<std::string, ModelIoEncoding>& resultEncodings);
+
  public:
   friend struct RenderCommand;
 
@@ -88,6 +155,65 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
 
   [[nodiscard]] std::shared_ptr<FrameworkSession> getRootSession() const { return m_rootSession; }
 
+  /**
+   * Identifier of the pipeline, unique in the process, and never 0
+   */
+  [[nodiscard]] uint32_t id() const { return m_id; }
+
+  // ------------------------------- Bulk tensor creation (see tensorarena.h) ------------------------------- //
+
+  /**
+   * Create many local tensors or placeholders in one pass. The tensors are held in the pipeline's tensor arena
+   * and live as long as the pipeline; each is referred to by a lightweight <code>TensorRef</code>.
+   * @param attributes One attribute per tensor to be created
+   * @param isPlaceholder Whether all of the tensors are placeholders
+   * @return References to the new tensors, in the order of <code>attributes</code>
+   */
+  std::vector<TensorRef> createTensors(const std::vector<TensorAttribute>& attributes, bool isPlaceholder = false);
+  /**
+   * Create a single local tensor or placeholder in the pipeline's tensor arena
+   */
+  TensorRef createTensor(const TensorAttribute& attribute, bool isPlaceholder = false);
+  /**
+   * Write values to a tensor of the arena, with the semantics of <code>PipelineTensor::setData</code>
+   */
+  void setData(TensorRef tensor, int8_t* data, size_t size);
+  /**
+   * A <code>PipelineTensor</code> for a tensor of the arena, to use it with the APIs taking
+   * <code>std::shared_ptr</code>. The same object is returned as long as it is alive.
+   */
+  std::shared_ptr<PipelineTensor> tensor(TensorRef tensor);
+  /**
+   * Resolve an operand to its runtime handle, <code>XR_NULL_HANDLE</code> for an empty operand
+   * @throw std::logic_error if <code>tensor</code> is a <code>TensorRef</code> to a tensor of another pipeline
+   */
+  [[nodiscard]] XrSecureMrPipelineTensorPICO handleOf(const TensorOperand& tensor) const;
+  /**
+   * @throw std::logic_error if <code>tensor</code> is empty, or a <code>TensorRef</code> to a tensor of another
+   *        pipeline
+   */
+  [[nodiscard]] std::variant<std::monostate, TensorAttribute> attributeOf(const TensorOperand& tensor) const;
+
+  // ---------------------- Reduced-precision transport (see TensorTransport in tensor.h) ---------------------- //
+
+  /**
+   * Widen stored values into a tensor of the logical data type, i.e., <code>logical = stored / scale</code>
+   * @param stored Usually a placeholder bound to a global tensor with a transport
+   */
+  Pipeline& widen(TensorOperand stored, TensorOperand logical, float scale);
+  /**
+   * Narrow a tensor of the logical data type into stored values, i.e., <code>stored = logical * scale</code>,
+   * scaled in an intermediate local tensor unless <code>scale</code> is 1
+   * @param stored Usually a placeholder bound to a global tensor with a transport
+   */
+  Pipeline& narrow(TensorOperand logical, TensorOperand stored, float scale);
+  /**
+   * Add the operators of <code>narrow</code> at the first submission of the pipeline, after all the operators
+   * writing <code>logical</code>
+   */
+  Pipeline& narrowAtSubmit(const std::shared_ptr<PipelineTensor>& logical,
+                           const std::shared_ptr<PipelineTensor>& stored, float scale);
+
   // ------------------ The following methods each encapsulate one operator --------------------------- //
   // --- They add the encapsulated operators to the pipeline, but they are not executed until the ----- //
   // ----------------------------- pipeline is submitted for execution -------------------------------- //
@@ -101,7 +227,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *            must match those of the <code>src</code>
    * @return Reference to this pipeline
    */
-  Pipeline& typeConvert(const std::shared_ptr<PipelineTensor>& src, const std::shared_ptr<PipelineTensor>& dst);
+  Pipeline& typeConvert(TensorOperand src, TensorOperand dst);
 
   /**
    * Add to the pipeline an operator to perform
@@ -111,7 +237,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param dst Copy destination
    * @return Reference to this pipeline
    */
-  Pipeline& assignment(const std::shared_ptr<PipelineTensor>& src, const std::shared_ptr<PipelineTensor>& dst);
+  Pipeline& assignment(TensorOperand src, TensorOperand dst);
 
   /**
    * Add to the pipeline an operator to
@@ -122,7 +248,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param dstSlice The destination tensor slice of the copy
    * @return Reference to this pipeline
    */
-  Pipeline& assignment(const std::shared_ptr<PipelineTensor>& src, const PipelineTensor::Slice& dstSlice);
+  Pipeline& assignment(TensorOperand src, const PipelineTensor::Slice& dstSlice);
   /**
    * Add to the pipeline an operator to
    * copy all values from a slice <code>src</code> tensor to a <code>dst</code> tensor. For example, you
@@ -132,7 +258,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param dst The destination tensor
    * @return Reference to this pipeline
    */
-  Pipeline& assignment(const PipelineTensor::Slice& srcSlice, const std::shared_ptr<PipelineTensor>& dst);
+  Pipeline& assignment(const PipelineTensor::Slice& srcSlice, TensorOperand dst);
   /**
    * Add to the pipeline an operator to
    * copy values from one tensor slice to another.
@@ -154,7 +280,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *            must be the same as the tensors forming the comparison.
    * @return Reference to this pipeline
    */
-  Pipeline& compareTo(const PipelineTensor::Compare& compare, const std::shared_ptr<PipelineTensor>& dst);
+  Pipeline& compareTo(const PipelineTensor::Compare& compare, TensorOperand dst);
   /**
    * Add to the pipeline an operator to
    * evaluate an arithmetic expression, such as <code>{0} + {1} / 2</code>.
@@ -167,8 +293,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *               <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& arithmetic(const std::string& expression, const std::vector<std::shared_ptr<PipelineTensor>>& ops,
-                       const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& arithmetic(const std::string& expression, const std::vector<TensorOperand>& ops, TensorOperand result);
   enum class ElementwiseOp { MIN, MAX, MULTIPLY, OR, AND };
   /**
    * Add to the pipeline an operator to
@@ -186,8 +311,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param result The result tensor, which must be of the same dimensions and channels as each of the ops.
    * @return Reference to this pipeline
    */
-  Pipeline& elementwise(ElementwiseOp operation, const std::array<std::shared_ptr<PipelineTensor>, 2>& ops,
-                        const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& elementwise(ElementwiseOp operation, const std::array<TensorOperand, 2>& ops, TensorOperand result);
   /**
    * Add to the pipeline an operator to perform ALL on given tensor: TRUE (non-zero) if all values in the tensor
    * is non-zero, FALSE otherwise.
@@ -197,7 +321,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *               with usage flag = <code>XR_SECURE_MR_TENSOR_TYPE_SCALAR_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& all(const std::shared_ptr<PipelineTensor>& op, const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& all(TensorOperand op, TensorOperand result);
   /**
    * Add to the pipeline an operator to perform ANY on given tensor: TRUE (non-zero) if any values in the
    * tensor is non-zero, FALSE otherwise.
@@ -207,7 +331,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *               with usage flag = <code>XR_SECURE_MR_TENSOR_TYPE_SCALAR_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& any(const std::shared_ptr<PipelineTensor>& op, const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& any(TensorOperand op, TensorOperand result);
   /**
    * Add to the pipeline an operator to compute NMS on N bounding boxes, producing the top-M bounding boxes sorted
    * by their scores.
@@ -231,10 +355,8 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param threshold the IOU threshold
    * @return Reference to this pipeline
    */
-  Pipeline& nms(const std::shared_ptr<PipelineTensor>& scores, std::shared_ptr<PipelineTensor>& boxes,
-                const std::shared_ptr<PipelineTensor>& result_scores,
-                const std::shared_ptr<PipelineTensor>& result_boxes,
-                const std::shared_ptr<PipelineTensor>& result_indices, float threshold);
+  Pipeline& nms(TensorOperand scores, TensorOperand boxes, TensorOperand result_scores, TensorOperand result_boxes,
+                TensorOperand result_indices, float threshold);
   /**
    * Add to the pipeline an operator to solve PnP. You may refer to
    * <a href="https://docs.opencv.org/3.4/d5/d1f/calib3d_solvePnP.html">this OpenCV page</a>
@@ -252,13 +374,10 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                        <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& solvePnP(const std::shared_ptr<PipelineTensor>& objectPoints,
-                     const std::shared_ptr<PipelineTensor>& imgPoints,
-                     const std::shared_ptr<PipelineTensor>& cameraMatrix,
-                     const std::shared_ptr<PipelineTensor>& result_rotation,
-                     const std::shared_ptr<PipelineTensor>& result_translation);
+  Pipeline& solvePnP(TensorOperand objectPoints, TensorOperand imgPoints, TensorOperand cameraMatrix,
+                     TensorOperand result_rotation, TensorOperand result_translation);
 
-  typedef std::variant<std::shared_ptr<PipelineTensor>, std::array<float, 6>> AffinePoints;
+  typedef std::variant<TensorOperand, std::array<float, 6>> AffinePoints;
 
   /**
    * Add to the pipeline an operator to compute the affine matrix. You may refer to
@@ -271,8 +390,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *               <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& getAffine(const AffinePoints& srcPoints, const AffinePoints& dstPoints,
-                      const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& getAffine(const AffinePoints& srcPoints, const AffinePoints& dstPoints, TensorOperand result);
 
   /**
    * Add to the pipeline an operator to apply affine on 2D image tensor
@@ -284,8 +402,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                   <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& applyAffine(const std::shared_ptr<PipelineTensor>& affine, const std::shared_ptr<PipelineTensor>& img,
-                        const std::shared_ptr<PipelineTensor>& result_img);
+  Pipeline& applyAffine(TensorOperand affine, TensorOperand img, TensorOperand result_img);
   /**
    * Add to the pipeline an operator to 2D points
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_APPLY_AFFINE_POINT_PICO</code>
@@ -296,9 +413,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param result_points the result points after affine, must containing N 2-chanel floating point values
    * @return Reference to this pipeline
    */
-  Pipeline& applyAffinePoint(const std::shared_ptr<PipelineTensor>& affine,
-                             const std::shared_ptr<PipelineTensor>& points,
-                             const std::shared_ptr<PipelineTensor>& result_points);
+  Pipeline& applyAffinePoint(TensorOperand affine, TensorOperand points, TensorOperand result_points);
   /**
    * Add to the pipeline an operator to use the on-device depth sensor to get the 3D coordinates relative to
    * the <b>left-eye</b> camera from pixel coordinates on the left-eye image.
@@ -316,9 +431,8 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *               float or double.
    * @return Reference to this pipeline
    */
-  Pipeline& uv2Cam(const std::shared_ptr<PipelineTensor>& uv, const std::shared_ptr<PipelineTensor>& timestamp,
-                   const std::shared_ptr<PipelineTensor>& cameraMatrix, const std::shared_ptr<PipelineTensor>& leftImg,
-                   const std::shared_ptr<PipelineTensor>& rightImg, const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& uv2Cam(TensorOperand uv, TensorOperand timestamp, TensorOperand cameraMatrix, TensorOperand leftImg,
+                   TensorOperand rightImg, TensorOperand result);
   enum class NormalizeType {
     L1 = XR_SECURE_MR_NORMALIZE_TYPE_L1_PICO,
     L2 = XR_SECURE_MR_NORMALIZE_TYPE_L2_PICO,
@@ -333,8 +447,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param type the normalize type
    * @return Reference to this pipeline
    */
-  Pipeline& normalize(const std::shared_ptr<PipelineTensor>& src, const std::shared_ptr<PipelineTensor>& result,
-                      NormalizeType type = NormalizeType::L2);
+  Pipeline& normalize(TensorOperand src, TensorOperand result, NormalizeType type = NormalizeType::L2);
   /**
    * Add to the pipeline an operator to query the transform matrix for left/right-eye camera to
    * OpenXR's <code>XR_REFERENCE_SPACE_TYPE_LOCAL</code> at the time when the image is taken
@@ -348,9 +461,8 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                                 floating point values, usage flat = <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& camSpace2XrLocal(const std::shared_ptr<PipelineTensor>& timestamp,
-                             const std::shared_ptr<PipelineTensor>& result_rightEyeTransform,
-                             const std::shared_ptr<PipelineTensor>& result_leftEyeTransform);
+  Pipeline& camSpace2XrLocal(TensorOperand timestamp, TensorOperand result_rightEyeTransform,
+                             TensorOperand result_leftEyeTransform);
   /**
    * Add to the pipeline an operator to get the latest camera image for both eyes
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_RECTIFIED_VST_ACCESS_PICO</code>
@@ -366,10 +478,8 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                         floating point values, of usage flag <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& cameraAccess(const std::shared_ptr<PipelineTensor>& result_rightEye,
-                         const std::shared_ptr<PipelineTensor>& result_leftEye,
-                         const std::shared_ptr<PipelineTensor>& result_timeStamp,
-                         const std::shared_ptr<PipelineTensor>& result_camMatrix);
+  Pipeline& cameraAccess(TensorOperand result_rightEye, TensorOperand result_leftEye, TensorOperand result_timeStamp,
+                         TensorOperand result_camMatrix);
   /**
    * Add to the pipeline an operator to conduct channel-wise arg max
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_ARGMAX_PICO</code>
@@ -379,8 +489,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                               D channels, where D matches the number of dimensions of the input tensor.
    * @return Reference to this pipeline
    */
-  Pipeline& argMax(const std::shared_ptr<PipelineTensor>& src,
-                   const std::shared_ptr<PipelineTensor>& result_indexPerChannel);
+  Pipeline& argMax(TensorOperand src, TensorOperand result_indexPerChannel);
   /**
    * Add to the pipeline an operator to convert color space
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_CONVERT_COLOR_PICO</code>
@@ -392,8 +501,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *               source image.
    * @return Reference to this pipeline
    */
-  Pipeline& cvtColor(int convertFlag, const std::shared_ptr<PipelineTensor>& image,
-                     const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& cvtColor(int convertFlag, TensorOperand image, TensorOperand result);
   /**
    * Add to the pipeline an operator to sort a 1D 1-channel tensor
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_SORT_VEC_PICO</code>
@@ -403,9 +511,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                       the srcVec, and the datatype must be integer
    * @return Reference to this pipeline
    */
-  Pipeline& sortVec(const std::shared_ptr<PipelineTensor>& srcVec,
-                    const std::shared_ptr<PipelineTensor>& result_sortedVec,
-                    const std::shared_ptr<PipelineTensor>& result_indices);
+  Pipeline& sortVec(TensorOperand srcVec, TensorOperand result_sortedVec, TensorOperand result_indices);
   /**
    * Add to the pipeline an operator to sort 2D 1-channel tensor (matrix) row-by-row.
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_SORT_MAT_PICO</code>
@@ -415,9 +521,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param result_indicesPerRow the column indices in srcMat of each value in the sorted tensor per row
    * @return Reference to this pipeline
    */
-  Pipeline& sortMatByRow(const std::shared_ptr<PipelineTensor>& srcMat,
-                         const std::shared_ptr<PipelineTensor>& result_sortedMat,
-                         const std::shared_ptr<PipelineTensor>& result_indicesPerRow);
+  Pipeline& sortMatByRow(TensorOperand srcMat, TensorOperand result_sortedMat, TensorOperand result_indicesPerRow);
   /**
    * Add to the pipeline an operator to sort 2D 1-channel tensor (matrix) column-by-column.
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_SORT_MAT_PICO</code>
@@ -427,9 +531,8 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param result_indicesPerColumn the row indices in srcMat of each value in the sorted tensor per column
    * @return Reference to this pipeline
    */
-  Pipeline& sortMatByColumn(const std::shared_ptr<PipelineTensor>& srcMat,
-                            const std::shared_ptr<PipelineTensor>& result_sortedMat,
-                            const std::shared_ptr<PipelineTensor>& result_indicesPerColumn);
+  Pipeline& sortMatByColumn(TensorOperand srcMat, TensorOperand result_sortedMat,
+                            TensorOperand result_indicesPerColumn);
 
   /**
    *
@@ -446,10 +549,8 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *    <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code> required, and the tensor must have only two dimensions.
    * @return Reference to this pipeline
    */
-  Pipeline& singularValueDecomposition(const std::shared_ptr<PipelineTensor>& src,
-                                       const std::shared_ptr<PipelineTensor>& result_w,
-                                       const std::shared_ptr<PipelineTensor>& result_u,
-                                       const std::shared_ptr<PipelineTensor>& result_vt);
+  Pipeline& singularValueDecomposition(TensorOperand src, TensorOperand result_w, TensorOperand result_u,
+                                       TensorOperand result_vt);
 
   /**
    * Compute the norm of a tensor (by default, L2 norm)
@@ -464,7 +565,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *    </ol>
    * @return Reference to this pipeline
    */
-  Pipeline& norm(const std::shared_ptr<PipelineTensor>& src, const std::shared_ptr<PipelineTensor>& result_norm);
+  Pipeline& norm(TensorOperand src, TensorOperand result_norm);
 
   /**
    * Convert the HWC and CHW tensors. An HWC tensor is a 2-dimension tensor, with dimensions = <code>(H, W)</code> and
@@ -480,7 +581,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * be either 2 or 3. The last 2 dimensions of <code>result</code> must be the same as those of <code>src</code>
    * @return Reference to this pipeline
    */
-  Pipeline& convertHWC_CHW(const std::shared_ptr<PipelineTensor>& src, const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& convertHWC_CHW(TensorOperand src, TensorOperand result);
 
   /**
    * Add to the pipeline an operator to conduct matrix inversion
@@ -490,8 +591,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    * @param result_inverted the result matrix, must have the same attribute as the srcMat
    * @return Reference to this pipeline
    */
-  Pipeline& inversion(const std::shared_ptr<PipelineTensor>& srcMat,
-                      const std::shared_ptr<PipelineTensor>& result_inverted);
+  Pipeline& inversion(TensorOperand srcMat, TensorOperand result_inverted);
   /**
    * Add to the pipeline an operator to make a 4x4 transform
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_GET_TRANSFORM_MAT_PICO</code>
@@ -505,9 +605,7 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *               usage flag <code>XR_SECURE_MR_TENSOR_TYPE_MAT_PICO</code> required
    * @return Reference to this pipeline
    */
-  Pipeline& transform(const std::shared_ptr<PipelineTensor>& rotation,
-                      const std::shared_ptr<PipelineTensor>& translation, const std::shared_ptr<PipelineTensor>& scale,
-                      const std::shared_ptr<PipelineTensor>& result);
+  Pipeline& transform(TensorOperand rotation, TensorOperand translation, TensorOperand scale, TensorOperand result);
   /**
    * Add to the pipeline an operator to create a new texture to a glTF object from a tensor
    * Encapsulating operator of type <code>XR_SECURE_MR_OPERATOR_TYPE_LOAD_TEXTURE_PICO</code>
@@ -519,9 +617,8 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                            UINT16 value, with usage flag <code>XR_SECURE_MR_TENSOR_TYPE_SCALAR_PICO</code>
    * @return Reference to this pipeline
    */
-  Pipeline& newTextureToGLTF(const std::shared_ptr<PipelineTensor>& gltfPlaceholder,
-                             const std::shared_ptr<PipelineTensor>& textureSrc,
-                             const std::shared_ptr<PipelineTensor>& result_newTextureId);
+  Pipeline& newTextureToGLTF(TensorOperand gltfPlaceholder, TensorOperand textureSrc,
+                             TensorOperand result_newTextureId);
   /**
    * Add a render command to the pipeline.
    *
@@ -545,6 +642,13 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
    *                       a result in parameter <code>algResults</code> is not given here, the result name will be used
    *                       directly as the internal node ID.
    * @param modelName An identifier to the operator
+   * @param operandEncodings The encodings and layouts of the operands, by operand name. An operand not given here
+   *                         is encoded after the data type of its tensor, and an int16 tensor as unsigned 16-bit
+   *                         fixed point. A float32 operand of a fixed-point encoding is quantized, and an operand of
+   *                         the other layout transposed, into a local tensor first.
+   * @param resultEncodings The encodings and layouts of the results, by result name. A float32 result of a
+   *                        fixed-point encoding, or a result of the other layout, is converted from a local tensor
+   *                        the model writes.
    * @return Reference to this pipeline
    */
   Pipeline& runAlgorithm(char* algPackageBuf, size_t algPackageSize,
@@ -552,7 +656,44 @@ class Pipeline final : public XrHandleAdapter<XrSecureMrPipelinePICO>, public st
                          const std::unordered_map<std::string, std::string>& operandAliasing,
                          const std::unordered_map<std::string, std::shared_ptr<PipelineTensor>>& algResults,
                          const std::unordered_map<std::string, std::string>& resultAliasing,
-                         const std::string& modelName);
+                         const std::string& modelName,
+                         const std::unordered_map<std::string, ModelIoEncoding>& operandEncodings = {},
+                         const std::unordered_map<std::string, ModelIoEncoding>& resultEncodings = {});
+  /**
+   * <code>runAlgorithm</code> on tensors of the pipeline's tensor arena
+   */
+  Pipeline& runAlgorithm(char* algPackageBuf, size_t algPackageSize,
+                         const std::unordered_map<std::string, TensorRef>& algOps,
+                         const std::unordered_map<std::string, std::string>& operandAliasing,
+                         const std::unordered_map<std::string, TensorRef>& algResults,
+                         const std::unordered_map<std::string, std::string>& resultAliasing,
+                         const std::string& modelName,
+                         const std::unordered_map<std::string, ModelIoEncoding>& operandEncodings = {},
+                         const std::unordered_map<std::string, ModelIoEncoding>& resultEncodings = {});
+
+  // ------------- Typed overloads, checking operand shapes at compile time (see tensorspec.h) ------------- //
+  // ------------ They are defined in tensorspec.h, which must be included to use typed tensors ----------- //
+
+  template <typename Src, typename Dst>
+  Pipeline& typeConvert(const TypedPipelineTensor<Src>& src, const TypedPipelineTensor<Dst>& dst);
+  template <typename Src, typename Dst>
+  Pipeline& assignment(const TypedPipelineTensor<Src>& src, const TypedPipelineTensor<Dst>& dst);
+  template <typename A, typename B, typename R>
+  Pipeline& elementwise(ElementwiseOp operation, const TypedPipelineTensor<A>& op0, const TypedPipelineTensor<B>& op1,
+                        const TypedPipelineTensor<R>& result);
+  template <typename S, typename R>
+  Pipeline& all(const TypedPipelineTensor<S>& op, const TypedPipelineTensor<R>& result);
+  template <typename S, typename R>
+  Pipeline& any(const TypedPipelineTensor<S>& op, const TypedPipelineTensor<R>& result);
+  template <typename S, typename R>
+  Pipeline& norm(const TypedPipelineTensor<S>& src, const TypedPipelineTensor<R>& result_norm);
+  template <typename Src, typename Dst>
+  Pipeline& convertHWC_CHW(const TypedPipelineTensor<Src>& src, const TypedPipelineTensor<Dst>& result);
+  template <typename Src, typename Dst>
+  Pipeline& inversion(const TypedPipelineTensor<Src>& srcMat, const TypedPipelineTensor<Dst>& result_inverted);
+  template <typename Rot, typename Trans, typename Scale, typename R>
+  Pipeline& transform(const TypedPipelineTensor<Rot>& rotation, const TypedPipelineTensor<Trans>& translation,
+                      const TypedPipelineTensor<Scale>& scale, const TypedPipelineTensor<R>& result);
 
   /**
    * Submit the pipeline to be executed. The architecture (pipeline tensors, operators) of the pipeline will be frozen
@@ -0,0 +1,278 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipelinegraph.h"
+
+#include <algorithm>
+#include <optional>
+#include <sstream>
+
+namespace SecureMR {
+
+namespace {
+
+struct Access {
+  std::shared_ptr<GlobalTensor> global;
+  bool read = false;
+  bool write = false;
+};
+
+std::vector<Access> AccessesOf(const std::vector<PipelineBinding>& bindings,
+                               const std::shared_ptr<GlobalTensor>& condition) {
+  std::vector<Access> accesses;
+  const auto merge = [&accesses](const std::shared_ptr<GlobalTensor>& global, const bool read, const bool write) {
+    const auto it = std::find_if(accesses.begin(), accesses.end(),
+                                 [&global](const Access& each) { return each.global == global; });
+    if (it == accesses.end()) {
+      accesses.push_back({.global = global, .read = read, .write = write});
+    } else {
+      it->read |= read;
+      it->write |= write;
+    }
+  };
+  for (const auto& binding : bindings) {
+    merge(binding.global, binding.role != TensorRole::WRITE, binding.role != TensorRole::READ);
+  }
+  if (condition != nullptr) merge(condition, true, false);
+  return accesses;
+}
+
+/**
+ * The strongest conflict between a pipeline and one accessing global tensors after it in program order
+ */
+std::optional<std::pair<PipelineHazard::Kind, std::shared_ptr<GlobalTensor>>> ConflictOf(
+    const std::vector<Access>& earlier, const std::vector<Access>& later) {
+  std::optional<std::pair<PipelineHazard::Kind, std::shared_ptr<GlobalTensor>>> conflict;
+  for (const auto& first : earlier) {
+    for (const auto& second : later) {
+      if (first.global != second.global) continue;
+      if (first.write && second.write) return std::make_pair(PipelineHazard::Kind::WRITE_WRITE, first.global);
+      if (first.write && second.read) {
+        conflict = std::make_pair(PipelineHazard::Kind::READ_AFTER_WRITE, first.global);
+      } else if (first.read && second.write && !conflict.has_value()) {
+        conflict = std::make_pair(PipelineHazard::Kind::WRITE_AFTER_READ, first.global);
+      }
+    }
+  }
+  return conflict;
+}
+
+const char* KindName(const PipelineHazard::Kind kind) {
+  switch (kind) {
+    case PipelineHazard::Kind::WRITE_WRITE:
+      return "write-write race";
+    case PipelineHazard::Kind::READ_AFTER_WRITE:
+      return "read after write";
+    case PipelineHazard::Kind::WRITE_AFTER_READ:
+      return "write after read";
+  }
+  return "";
+}
+
+std::string HazardDescription(const PipelineHazard& hazard) {
+  return Fmt("%s on global tensor %p between pipeline %u%s and pipeline %u", KindName(hazard.kind),
+             static_cast<const void*>(hazard.global.get()), hazard.earlier->id(),
+             hazard.acrossRounds ? " (previous round)" : "", hazard.later->id());
+}
+
+}  // namespace
+
+PipelineGraph& PipelineGraph::add(const std::shared_ptr<Pipeline>& pipeline,
+                                  const std::vector<PipelineBinding>& bindings,
+                                  const std::shared_ptr<GlobalTensor>& condition) {
+  CHECK_MSG(pipeline != nullptr, "PipelineGraph::add(...) null pipeline")
+  CHECK_MSG(indexOf(pipeline) == m_nodes.size(), Fmt("Pipeline %u is already in the graph", pipeline->id()))
+  Node node{.pipeline = pipeline, .bindings = bindings, .condition = condition};
+  for (const auto& binding : bindings) {
+    CHECK_MSG(binding.placeholder != nullptr && binding.global != nullptr,
+              "PipelineGraph::add(...) binding without placeholder or global tensor")
+    CHECK_MSG(binding.placeholder->getPipeline() == pipeline,
+              Fmt("PipelineGraph::add(...) placeholder of another pipeline bound to pipeline %u", pipeline->id()))
+    node.argumentMap.emplace(binding.placeholder, binding.global);
+  }
+  auto& bandwidth = pipeline->getRootSession()->bandwidth();
+  for (const auto& access : AccessesOf(bindings, condition)) {
+    bandwidth.declareAccess(pipeline.get(), access.global.get(), access.read, access.write);
+  }
+  m_nodes.push_back(std::move(node));
+  m_built = false;
+  m_lastRuns.clear();
+  return *this;
+}
+
+const std::vector<PipelineHazard>& PipelineGraph::build() {
+  const size_t n = m_nodes.size();
+  std::vector<std::vector<Access>> accesses;
+  accesses.reserve(n);
+  for (const auto& node : m_nodes) accesses.push_back(AccessesOf(node.bindings, node.condition));
+
+  // Pipelines registered before in this round, or after in the previous round, precede a pipeline
+  std::vector<std::vector<bool>> isRace(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto& node = m_nodes[i];
+    node.dependencies.clear();
+    node.waitFor = NO_WAIT;
+    for (size_t j = 0; j < n; ++j) {
+      const auto conflict = j == i ? std::nullopt : ConflictOf(accesses[j], accesses[i]);
+      if (!conflict.has_value()) continue;
+      node.dependencies.push_back(j < i ? n + j : j);
+      isRace[i].push_back(conflict->first == PipelineHazard::Kind::WRITE_WRITE);
+    }
+  }
+
+  // ordered[x][y]: the run y of the two-round window completes before the run x starts. The previous round is
+  // submitted as the current one, so the run i of the previous round waits for n + waitFor of the pipeline i when
+  // that is in the same round, and for a run out of the window otherwise. A pipeline waiting for a later pipeline
+  // of the previous round sees the waits of that pipeline only after they are chosen, so choose until stable.
+  std::vector<std::vector<bool>> ordered(2 * n, std::vector<bool>(2 * n, false));
+  bool changed = true;
+  for (size_t pass = 0; changed && pass <= n; ++pass) {
+    changed = false;
+    for (size_t i = 0; i < n; ++i) {
+      auto& node = m_nodes[i];
+      const auto orderedBy = [&ordered, n, i](const size_t waitFor) {
+        std::vector<bool> previous(2 * n, false);
+        if (waitFor != NO_WAIT && waitFor >= n) {
+          previous = ordered[waitFor - n];
+          previous[waitFor - n] = true;
+        }
+        auto current = previous;
+        current[i] = true;
+        if (waitFor != NO_WAIT) {
+          for (size_t k = 0; k < 2 * n; ++k) current[k] = current[k] || ordered[waitFor][k];
+          current[waitFor] = true;
+        }
+        return std::make_pair(previous, current);
+      };
+      // Order the most write-write dependencies first, then the most dependencies, then the latest run
+      size_t best = NO_WAIT;
+      std::pair<size_t, size_t> bestCovered{0, 0};
+      for (const auto candidate : node.dependencies) {
+        const auto current = orderedBy(candidate).second;
+        std::pair<size_t, size_t> covered{0, 0};
+        for (size_t k = 0; k < node.dependencies.size(); ++k) {
+          if (!current[node.dependencies[k]]) continue;
+          covered.first += isRace[i][k] ? 1 : 0;
+          covered.second += 1;
+        }
+        if (best == NO_WAIT || covered > bestCovered || (covered == bestCovered && candidate > best)) {
+          best = candidate;
+          bestCovered = covered;
+        }
+      }
+      const auto [previous, current] = orderedBy(best);
+      changed = changed || best != node.waitFor || previous != ordered[i] || current != ordered[n + i];
+      node.waitFor = best;
+      ordered[i] = previous;
+      ordered[n + i] = current;
+    }
+  }
+
+  m_hazards.clear();
+  std::vector<std::string> races;
+  for (size_t i = 0; i < n; ++i) {
+    for (const auto dependency : m_nodes[i].dependencies) {
+      if (ordered[n + i][dependency]) continue;
+      const size_t j = dependency % n;
+      const auto conflict = ConflictOf(accesses[j], accesses[i]);
+      PipelineHazard hazard{.kind = conflict->first,
+                            .global = conflict->second,
+                            .earlier = m_nodes[j].pipeline,
+                            .later = m_nodes[i].pipeline,
+                            .acrossRounds = dependency < n};
+      if (hazard.kind == PipelineHazard::Kind::WRITE_WRITE) races.push_back(HazardDescription(hazard));
+      Log::Write(Log::Level::Warning, "PipelineGraph: unordered " + HazardDescription(hazard));
+      m_hazards.push_back(std::move(hazard));
+    }
+  }
+  CHECK_MSG(races.empty(), "PipelineGraph: " + races.front())
+  m_built = true;
+  return m_hazards;
+}
+
+XrSecureMrPipelineRunPICO PipelineGraph::submit(const XrSecureMrPipelineRunPICO waitFor) {
+  CHECK_MSG(!m_nodes.empty(), "PipelineGraph::submit() without pipelines")
+  if (!m_built) build();
+  const size_t n = m_nodes.size();
+  std::vector<XrSecureMrPipelineRunPICO> runs(n, XR_NULL_HANDLE);
+  for (size_t i = 0; i < n; ++i) {
+    const auto& node = m_nodes[i];
+    XrSecureMrPipelineRunPICO pre = waitFor;
+    if (node.waitFor != NO_WAIT && node.waitFor >= n) {
+      pre = runs[node.waitFor - n];
+    } else if (node.waitFor != NO_WAIT && !m_lastRuns.empty()) {
+      pre = m_lastRuns[node.waitFor];
+    }
+    runs[i] = node.pipeline->submit(node.argumentMap, pre, node.condition);
+  }
+  m_lastRuns = std::move(runs);
+  return m_lastRuns.back();
+}
+
+std::vector<std::shared_ptr<Pipeline>> PipelineGraph::producersOf(const std::shared_ptr<GlobalTensor>& global) const {
+  std::vector<std::shared_ptr<Pipeline>> producers;
+  for (const auto& node : m_nodes) {
+    for (const auto& access : AccessesOf(node.bindings, node.condition)) {
+      if (access.global == global && access.write) producers.push_back(node.pipeline);
+    }
+  }
+  return producers;
+}
+
+std::vector<std::shared_ptr<Pipeline>> PipelineGraph::consumersOf(const std::shared_ptr<GlobalTensor>& global) const {
+  std::vector<std::shared_ptr<Pipeline>> consumers;
+  for (const auto& node : m_nodes) {
+    for (const auto& access : AccessesOf(node.bindings, node.condition)) {
+      if (access.global == global && access.read) consumers.push_back(node.pipeline);
+    }
+  }
+  return consumers;
+}
+
+std::vector<std::shared_ptr<Pipeline>> PipelineGraph::dependenciesOf(const std::shared_ptr<Pipeline>& pipeline) {
+  const auto index = indexOf(pipeline);
+  CHECK_MSG(index < m_nodes.size(), "PipelineGraph::dependenciesOf(...) pipeline not in the graph")
+  if (!m_built) build();
+  std::vector<std::shared_ptr<Pipeline>> dependencies;
+  for (const auto dependency : m_nodes[index].dependencies) {
+    dependencies.push_back(m_nodes[dependency % m_nodes.size()].pipeline);
+  }
+  return dependencies;
+}
+
+std::string PipelineGraph::describe() {
+  if (!m_built) build();
+  const size_t n = m_nodes.size();
+  std::ostringstream oss;
+  for (const auto& node : m_nodes) {
+    oss << "pipeline " << node.pipeline->id();
+    if (node.waitFor == NO_WAIT) {
+      oss << ": no wait";
+    } else {
+      oss << ": waits for pipeline " << m_nodes[node.waitFor % n].pipeline->id()
+          << (node.waitFor < n ? " (previous round)" : "");
+    }
+    oss << '\n';
+  }
+  for (const auto& hazard : m_hazards) oss << "unordered " << HazardDescription(hazard) << '\n';
+  return oss.str();
+}
+
+size_t PipelineGraph::indexOf(const std::shared_ptr<Pipeline>& pipeline) const {
+  const auto it = std::find_if(m_nodes.begin(), m_nodes.end(),
+                               [&pipeline](const Node& node) { return node.pipeline == pipeline; });
+  return static_cast<size_t>(it - m_nodes.begin());
+}
+
+}  // namespace SecureMR
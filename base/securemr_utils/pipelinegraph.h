@@ -0,0 +1,168 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_PIPELINEGRAPH_H_
+#define SECUREMR_UTILS_PIPELINEGRAPH_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+/**
+ * How a pipeline accesses the global tensor bound to one of its placeholders
+ */
+enum class TensorRole { READ, WRITE, READ_WRITE };
+
+/**
+ * A placeholder of a pipeline bound to a global tensor at every submission, with the role of the placeholder
+ */
+struct PipelineBinding {
+  std::shared_ptr<PipelineTensor> placeholder;
+  std::shared_ptr<GlobalTensor> global;
+  TensorRole role = TensorRole::READ;
+};
+
+/**
+ * A dependency between two pipelines of a <code>PipelineGraph</code> on a global tensor, which the
+ * <code>waitFor</code> chain of the graph cannot enforce, because a submission can only wait for one run.
+ */
+struct PipelineHazard {
+  enum class Kind { WRITE_WRITE, READ_AFTER_WRITE, WRITE_AFTER_READ };
+
+  Kind kind = Kind::WRITE_WRITE;
+  std::shared_ptr<GlobalTensor> global;
+  /**
+   * The pipeline accessing the global tensor first in registration order
+   */
+  std::shared_ptr<Pipeline> earlier;
+  std::shared_ptr<Pipeline> later;
+  /**
+   * Whether <code>earlier</code> is the submission of the previous round, i.e., it was registered after
+   * <code>later</code>
+   */
+  bool acrossRounds = false;
+};
+
+/**
+ * A set of pipelines exchanging data through global tensors, submitted together in rounds.
+ * <br/>
+ * Each pipeline is registered once with the global tensors bound to its placeholders, and whether it reads or
+ * writes them. Registration order is the program order: a pipeline is expected to see the writes of the pipelines
+ * registered before it in the same round, and of those registered after it in the previous round.
+ * <br/>
+ * From the bindings, the graph derives which pipelines produce and which consume each global tensor, and chains
+ * the <code>waitFor</code> handles of <code>Pipeline::submit</code> so that every producer/consumer pair is ordered,
+ * while pipelines sharing no global tensor run in parallel. As a submission can only wait for one run, the graph
+ * picks, for each pipeline, the dependency that transitively orders the most of the others. Dependencies left
+ * unordered are reported as hazards; unordered write-write pairs are races and rejected by <code>build</code>.
+ * <br/>
+ * For example, for the pose sample:
+ * <pre>
+ * graph.add(detection, {{imagePh, imageGlobal, TensorRole::READ}, {roiPh1, roiGlobal, TensorRole::WRITE}})
+ *      .add(affineUpdate, {{roiPh2, roiGlobal}, {roiPh3, roiUpdatedGlobal, TensorRole::WRITE}})
+ *      .add(landmark, {{roiPh4, roiUpdatedGlobal}, {landmarkPh, landmarkGlobal, TensorRole::WRITE}});
+ * graph.submit();  // affineUpdate waits for detection, landmark for affineUpdate
+ * </pre>
+ */
+class PipelineGraph {
+ public:
+  /**
+   * Register a pipeline, to be submitted after the pipelines already registered in each round
+   * @param bindings The placeholders of the pipeline and the global tensors they refer to at each submission
+   * @param condition The condition tensor of each submission, see <code>Pipeline::submit</code>. It is read by
+   *                  the pipeline.
+   * @return Reference to this graph
+   * @throw std::logic_error if the pipeline is already registered, or a placeholder is of another pipeline
+   */
+  PipelineGraph& add(const std::shared_ptr<Pipeline>& pipeline, const std::vector<PipelineBinding>& bindings,
+                     const std::shared_ptr<GlobalTensor>& condition = nullptr);
+
+  /**
+   * Derive the dependencies between the registered pipelines and choose the run each of them waits for. Called by
+   * the first <code>submit</code> after a registration, if not called explicitly.
+   * @return The dependencies which cannot be ordered by the chosen waits, logged as warnings
+   * @throw std::logic_error if two pipelines write the same global tensor and cannot be ordered
+   */
+  const std::vector<PipelineHazard>& build();
+
+  /**
+   * Submit every registered pipeline once, in registration order, each waiting for the run chosen by
+   * <code>build</code>
+   * @param waitFor Run waited for by the pipelines depending on no other pipeline of the graph, and by those whose
+   *                dependency belongs to the previous round, in the first round
+   * @return The run of the last registered pipeline. The runs of all the pipelines are given by
+   *         <code>lastRuns</code>.
+   */
+  XrSecureMrPipelineRunPICO submit(XrSecureMrPipelineRunPICO waitFor = XR_NULL_HANDLE);
+
+  /**
+   * The runs of the latest <code>submit</code>, in registration order
+   */
+  [[nodiscard]] const std::vector<XrSecureMrPipelineRunPICO>& lastRuns() const { return m_lastRuns; }
+
+  /**
+   * The registered pipelines accessing <code>global</code> in the given way, in registration order
+   */
+  [[nodiscard]] std::vector<std::shared_ptr<Pipeline>> producersOf(const std::shared_ptr<GlobalTensor>& global) const;
+  [[nodiscard]] std::vector<std::shared_ptr<Pipeline>> consumersOf(const std::shared_ptr<GlobalTensor>& global) const;
+
+  /**
+   * The pipelines that must complete before <code>pipeline</code> starts, by direct access to a common global
+   * tensor. Pipelines of the previous round are included.
+   */
+  [[nodiscard]] std::vector<std::shared_ptr<Pipeline>> dependenciesOf(const std::shared_ptr<Pipeline>& pipeline);
+
+  /**
+   * Human-readable waits and hazards of the graph, one pipeline per line, for logging
+   */
+  [[nodiscard]] std::string describe();
+
+ private:
+  static constexpr size_t NO_WAIT = static_cast<size_t>(-1);
+
+  struct Node {
+    std::shared_ptr<Pipeline> pipeline;
+    std::vector<PipelineBinding> bindings;
+    std::shared_ptr<GlobalTensor> condition;
+    std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>> argumentMap;
+
+    /**
+     * Direct dependencies, as indices into the two-round window: <code>[0, n)</code> for the previous round,
+     * <code>[n, 2n)</code> for the current one
+     */
+    std::vector<size_t> dependencies;
+    /**
+     * Index into the two-round window of the run to wait for, or <code>NO_WAIT</code>
+     */
+    size_t waitFor = NO_WAIT;
+  };
+
+  [[nodiscard]] size_t indexOf(const std::shared_ptr<Pipeline>& pipeline) const;
+
+  std::vector<Node> m_nodes;
+  std::vector<PipelineHazard> m_hazards;
+  std::vector<XrSecureMrPipelineRunPICO> m_lastRuns;
+  bool m_built = false;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_PIPELINEGRAPH_H_
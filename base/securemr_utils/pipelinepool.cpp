@@ -0,0 +1,204 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipelinepool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace SecureMR {
+
+struct PipelineLease::Entry {
+  std::shared_ptr<Pipeline> pipeline;
+  std::unordered_map<std::string, std::shared_ptr<PipelineTensor>> tensors;
+  /**
+   * The values last written to each local tensor
+   */
+  std::unordered_map<std::string, std::vector<int8_t>> values;
+  /**
+   * The last run submitted by any lease of the pipeline, which the next job's submission waits for
+   */
+  XrSecureMrPipelineRunPICO lastRun = XR_NULL_HANDLE;
+  uint64_t skippedResets = 0;
+};
+
+struct PipelinePool::Template {
+  std::string name;
+  PipelineTemplate build;
+  size_t capacity = 0;
+  std::vector<std::unique_ptr<PipelineLease::Entry>> idle;
+  Stats stats;
+  double totalCreationMicros = 0.0;
+};
+
+PipelineLease::PipelineLease(PipelineLease&& other) noexcept
+    : m_pool(other.m_pool), m_templateIndex(other.m_templateIndex), m_entry(other.m_entry) {
+  other.m_entry = nullptr;
+}
+
+PipelineLease& PipelineLease::operator=(PipelineLease&& other) noexcept {
+  if (this != &other) {
+    release();
+    m_pool = other.m_pool;
+    m_templateIndex = other.m_templateIndex;
+    m_entry = other.m_entry;
+    other.m_entry = nullptr;
+  }
+  return *this;
+}
+
+const std::shared_ptr<Pipeline>& PipelineLease::pipeline() const {
+  CHECK_MSG(m_entry != nullptr, "PipelineLease: released")
+  return m_entry->pipeline;
+}
+
+const std::shared_ptr<PipelineTensor>& PipelineLease::tensor(const std::string& name) const {
+  CHECK_MSG(m_entry != nullptr, "PipelineLease: released")
+  const auto it = m_entry->tensors.find(name);
+  CHECK_MSG(it != m_entry->tensors.end(), Fmt("PipelineLease: the template has no tensor \"%s\"", name.c_str()))
+  return it->second;
+}
+
+bool PipelineLease::setData(const std::string& name, const int8_t* data, const size_t size) {
+  const auto& target = tensor(name);
+  auto& values = m_entry->values[name];
+  if (values.size() == size && std::memcmp(values.data(), data, size) == 0) {
+    ++m_entry->skippedResets;
+    return false;
+  }
+  target->setData(const_cast<int8_t*>(data), size);
+  values.assign(data, data + size);
+  return true;
+}
+
+XrSecureMrPipelineRunPICO PipelineLease::submit(
+    const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap,
+    const XrSecureMrPipelineRunPICO waitFor, const std::shared_ptr<GlobalTensor>& condition) {
+  // Without a dependency of its own, a job waits for the run of the previous job leasing the pipeline
+  const auto run = pipeline()->submit(argumentMap, waitFor != XR_NULL_HANDLE ? waitFor : m_entry->lastRun, condition);
+  m_entry->lastRun = run;
+  return run;
+}
+
+void PipelineLease::release() {
+  if (m_entry == nullptr) return;
+  m_pool->release(m_templateIndex, m_entry);
+  m_entry = nullptr;
+}
+
+PipelinePool::PipelinePool(std::shared_ptr<FrameworkSession> session) : m_session(std::move(session)) {}
+
+PipelinePool::~PipelinePool() = default;
+
+std::unique_ptr<PipelineLease::Entry> PipelinePool::create(Template& pipelineTemplate) {
+  const auto start = std::chrono::steady_clock::now();
+  auto entry = std::make_unique<PipelineLease::Entry>();
+  entry->pipeline = std::make_shared<Pipeline>(m_session);
+  entry->tensors = pipelineTemplate.build(entry->pipeline);
+  const double micros =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto& stats = pipelineTemplate.stats;
+  ++stats.created;
+  pipelineTemplate.totalCreationMicros += micros;
+  stats.meanCreationMicros = pipelineTemplate.totalCreationMicros / static_cast<double>(stats.created);
+  stats.maxCreationMicros = std::max(stats.maxCreationMicros, micros);
+  return entry;
+}
+
+PipelinePool::TemplateId PipelinePool::registerTemplate(const std::string& name, PipelineTemplate build,
+                                                        const size_t capacity) {
+  CHECK_MSG(build != nullptr, Fmt("PipelinePool: template \"%s\" without builder", name.c_str()))
+  auto pipelineTemplate = std::make_unique<Template>();
+  pipelineTemplate->name = name;
+  pipelineTemplate->build = std::move(build);
+  pipelineTemplate->capacity = capacity;
+  pipelineTemplate->idle.reserve(capacity);
+  for (size_t index = 0; index < capacity; ++index) pipelineTemplate->idle.push_back(create(*pipelineTemplate));
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  CHECK_MSG(m_templateIds.count(name) == 0, Fmt("PipelinePool: template \"%s\" already registered", name.c_str()))
+  pipelineTemplate->stats.idle = pipelineTemplate->idle.size();
+  const TemplateId id = m_templates.size();
+  m_templates.push_back(std::move(pipelineTemplate));
+  m_templateIds.emplace(name, id);
+  return id;
+}
+
+PipelineLease PipelinePool::acquire(const TemplateId id) {
+  Template* pipelineTemplate = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    CHECK_MSG(id < m_templates.size(), Fmt("PipelinePool: no template %zu", id))
+    pipelineTemplate = m_templates[id].get();
+    ++pipelineTemplate->stats.acquisitions;
+    if (!pipelineTemplate->idle.empty()) {
+      ++pipelineTemplate->stats.hits;
+      auto* entry = pipelineTemplate->idle.back().release();
+      pipelineTemplate->idle.pop_back();
+      pipelineTemplate->stats.idle = pipelineTemplate->idle.size();
+      return {this, id, entry};
+    }
+  }
+  // Miss: create outside of the lock, the other templates stay available
+  return {this, id, create(*pipelineTemplate).release()};
+}
+
+PipelineLease PipelinePool::acquire(const std::string& name) { return acquire(idOf(name)); }
+
+void PipelinePool::release(const TemplateId id, PipelineLease::Entry* const entry) {
+  std::unique_ptr<PipelineLease::Entry> owned(entry);
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto& pipelineTemplate = *m_templates[id];
+  pipelineTemplate.stats.skippedResets += std::exchange(owned->skippedResets, 0);
+  if (pipelineTemplate.idle.size() < pipelineTemplate.capacity) {
+    pipelineTemplate.idle.push_back(std::move(owned));
+    pipelineTemplate.stats.idle = pipelineTemplate.idle.size();
+  }
+}
+
+PipelinePool::TemplateId PipelinePool::idOf(const std::string& name) const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const auto it = m_templateIds.find(name);
+  CHECK_MSG(it != m_templateIds.end(), Fmt("PipelinePool: no template \"%s\"", name.c_str()))
+  return it->second;
+}
+
+PipelinePool::Stats PipelinePool::stats(const TemplateId id) const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  CHECK_MSG(id < m_templates.size(), Fmt("PipelinePool: no template %zu", id))
+  return m_templates[id]->stats;
+}
+
+PipelinePool::Stats PipelinePool::stats(const std::string& name) const { return stats(idOf(name)); }
+
+std::string PipelinePool::report() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  std::string text = Fmt("Pipeline pool: %zu templates", m_templates.size());
+  for (const auto& pipelineTemplate : m_templates) {
+    const auto& stats = pipelineTemplate->stats;
+    text += Fmt("\n  %s: %llu acquisitions, %.1f%% hits, %zu/%zu idle, %llu created in %.1f us (max %.1f us), "
+                "%llu resets skipped",
+                pipelineTemplate->name.c_str(), static_cast<unsigned long long>(stats.acquisitions),
+                stats.hitRate() * 100.0, stats.idle, pipelineTemplate->capacity,
+                static_cast<unsigned long long>(stats.created), stats.meanCreationMicros, stats.maxCreationMicros,
+                static_cast<unsigned long long>(stats.skippedResets));
+  }
+  return text;
+}
+
+}  // namespace SecureMR
@@ -0,0 +1,180 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_PIPELINEPOOL_H_
+#define SECUREMR_UTILS_PIPELINEPOOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+class PipelinePool;
+
+/**
+ * Adds the operators of a pipeline template to a new pipeline, and returns the tensors a job sets or binds, by name:
+ * local tensors receiving the inputs of the job, and placeholders
+ */
+using PipelineTemplate = std::function<std::unordered_map<std::string, std::shared_ptr<PipelineTensor>>(
+    const std::shared_ptr<Pipeline>& pipeline)>;
+
+/**
+ * A pooled pipeline acquired for one job, returned to the pool when the lease is destroyed or released
+ */
+class PipelineLease {
+ public:
+  PipelineLease() = default;
+  PipelineLease(PipelineLease&& other) noexcept;
+  PipelineLease& operator=(PipelineLease&& other) noexcept;
+  PipelineLease(const PipelineLease&) = delete;
+  PipelineLease& operator=(const PipelineLease&) = delete;
+  ~PipelineLease() { release(); }
+
+  [[nodiscard]] bool valid() const { return m_entry != nullptr; }
+  [[nodiscard]] const std::shared_ptr<Pipeline>& pipeline() const;
+  /**
+   * A tensor returned by the template, by name
+   */
+  [[nodiscard]] const std::shared_ptr<PipelineTensor>& tensor(const std::string& name) const;
+
+  /**
+   * Write the values of a local tensor of the template, unless it already holds them from a previous job of the
+   * pooled pipeline
+   * @return Whether the tensor was reset
+   */
+  bool setData(const std::string& name, const int8_t* data, size_t size);
+  template <typename T>
+  bool setData(const std::string& name, const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "setData(...) requires trivially copyable values");
+    return setData(name, reinterpret_cast<const int8_t*>(data), count * sizeof(T));
+  }
+  template <typename T>
+  bool setData(const std::string& name, const std::vector<T>& data) {
+    return setData(name, data.data(), data.size());
+  }
+
+  /**
+   * Submit the pooled pipeline. Unless <code>waitFor</code> is set, the run waits for the last run submitted on the
+   * pipeline, including the runs of the previous jobs leasing it.
+   */
+  XrSecureMrPipelineRunPICO submit(
+      const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap = {},
+      XrSecureMrPipelineRunPICO waitFor = XR_NULL_HANDLE, const std::shared_ptr<GlobalTensor>& condition = nullptr);
+
+  /**
+   * Return the pipeline to the pool now. Its submitted runs go on, and the next job's submission is chained on the
+   * last of them.
+   */
+  void release();
+
+ private:
+  friend class PipelinePool;
+  struct Entry;
+
+  PipelineLease(PipelinePool* pool, size_t templateIndex, Entry* entry)
+      : m_pool(pool), m_templateIndex(templateIndex), m_entry(entry) {}
+
+  PipelinePool* m_pool = nullptr;
+  size_t m_templateIndex = 0;
+  Entry* m_entry = nullptr;
+};
+
+/**
+ * Pre-created pipelines for short-lived jobs, e.g., pushing a glTF once, which would otherwise create and destroy a
+ * pipeline on the critical path.
+ * <br/>
+ * Each registered template keeps up to <code>capacity</code> idle pipelines, all created at registration.
+ * <code>acquire</code> pops an idle pipeline, or creates one if there is none, and releasing the lease pushes it
+ * back, both in constant time. The local tensors of a pooled pipeline remember what they hold, so a job only resets
+ * the ones whose values change.
+ * <br/>
+ * The pool must outlive its leases. All methods are thread-safe.
+ */
+class PipelinePool {
+ public:
+  using TemplateId = size_t;
+
+  struct Stats {
+    uint64_t acquisitions = 0;
+    /**
+     * Acquisitions served by an idle pipeline
+     */
+    uint64_t hits = 0;
+    size_t idle = 0;
+    /**
+     * Pipelines created, pre-created or on a miss
+     */
+    uint64_t created = 0;
+    double meanCreationMicros = 0.0;
+    double maxCreationMicros = 0.0;
+    /**
+     * Tensor writes skipped because the tensor already held the values
+     */
+    uint64_t skippedResets = 0;
+
+    [[nodiscard]] double hitRate() const {
+      return acquisitions == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(acquisitions);
+    }
+  };
+
+  explicit PipelinePool(std::shared_ptr<FrameworkSession> session);
+  ~PipelinePool();
+
+  PipelinePool(const PipelinePool&) = delete;
+  PipelinePool& operator=(const PipelinePool&) = delete;
+
+  /**
+   * Register a template and pre-create <code>capacity</code> pipelines of it
+   * @return The id of the template, to acquire its pipelines without looking up its name
+   */
+  TemplateId registerTemplate(const std::string& name, PipelineTemplate build, size_t capacity);
+
+  PipelineLease acquire(TemplateId id);
+  PipelineLease acquire(const std::string& name);
+
+  [[nodiscard]] Stats stats(TemplateId id) const;
+  [[nodiscard]] Stats stats(const std::string& name) const;
+  /**
+   * One line per template with its hit rate and creation latency
+   */
+  [[nodiscard]] std::string report() const;
+
+ private:
+  friend class PipelineLease;
+  struct Template;
+
+  void release(TemplateId id, PipelineLease::Entry* entry);
+  std::unique_ptr<PipelineLease::Entry> create(Template& pipelineTemplate);
+  [[nodiscard]] TemplateId idOf(const std::string& name) const;
+
+  std::shared_ptr<FrameworkSession> m_session;
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<Template>> m_templates;
+  std::unordered_map<std::string, TemplateId> m_templateIds;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_PIPELINEPOOL_H_
@@ -14,7 +14,9 @@
 
 #include "securemr_utils/serialization.h"
 
+#include <algorithm>
 #include <fstream>
+#include <optional>
 #include <system_error>
 #include <stdexcept>
 #include <unordered_map>
@@ -23,6 +25,7 @@
 #include "oxr_utils/logger.h"
 #include "pipeline.h"
 #include "tensor.h"
+#include "tensormemory.h"
 
 #ifdef XR_USE_PLATFORM_ANDROID
 #include <android/asset_manager.h>
@@ -176,6 +179,53 @@ bool JsonToFloatArray(const Json& arr, std::array<float, 6>& dest) {
   return true;
 }
 
+bool JsonToModelIoEncoding(const Json& j, ModelIoEncoding& out) {
+  static const std::unordered_map<std::string, XrSecureMrModelEncodingPICO> kEncodings{
+      {"float32", XR_SECURE_MR_MODEL_ENCODING_FLOAT_32_PICO},
+      {"ufixed8", XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT8_PICO},
+      {"sfixed8", XR_SECURE_MR_MODEL_ENCODING_SFIXED_POINT8_PICO},
+      {"ufixed16", XR_SECURE_MR_MODEL_ENCODING_UFIXED_POINT16_PICO},
+      {"int32", XR_SECURE_MR_MODEL_ENCODING_INT32_PICO},
+  };
+  static const std::unordered_map<std::string, ModelIoLayout> kLayouts{
+      {"any", ModelIoLayout::ANY}, {"hwc", ModelIoLayout::HWC}, {"chw", ModelIoLayout::CHW}};
+  out = ModelIoEncoding{};
+  const Json& encoding = j.is_object() ? j.value("encoding", Json()) : j;
+  if (encoding.is_string()) {
+    const auto it = kEncodings.find(encoding.get<std::string>());
+    if (it == kEncodings.end()) {
+      return false;
+    }
+    out.encoding = it->second;
+  } else if (encoding.is_number_integer()) {
+    out.encoding = static_cast<XrSecureMrModelEncodingPICO>(encoding.get<int>());
+  } else if (!encoding.is_null() || !j.is_object()) {
+    return false;
+  }
+  if (j.is_object()) {
+    if (const auto scale = j.find("scale"); scale != j.end()) {
+      if (!scale->is_number() || scale->get<float>() == 0.0f) {
+        return false;
+      }
+      out.scale = scale->get<float>();
+    }
+    if (const auto offset = j.find("offset"); offset != j.end()) {
+      if (!offset->is_number_integer()) {
+        return false;
+      }
+      out.offset = offset->get<int32_t>();
+    }
+    if (const auto layout = j.find("layout"); layout != j.end()) {
+      const auto it = layout->is_string() ? kLayouts.find(layout->get<std::string>()) : kLayouts.end();
+      if (it == kLayouts.end()) {
+        return false;
+      }
+      out.layout = it->second;
+    }
+  }
+  return true;
+}
+
 Json LoadJsonFromFile(const std::filesystem::path& filePath) {
   Json parsed;
   if (filePath.empty()) {
@@ -197,6 +247,175 @@ Json LoadJsonFromFile(const std::filesystem::path& filePath) {
   return parsed;
 }
 
+namespace {
+
+std::string FirstTensor(const Json& opSpec, const char* key) {
+  const auto tensors = ParseTensorList(opSpec.value(key, Json::array()));
+  return tensors.empty() ? std::string{} : tensors.front();
+}
+
+}  // namespace
+
+size_t ReconcileModelLayouts(Json& spec, ModelLayoutReport* outReport) {
+  ModelLayoutReport report;
+  const auto tensorsIt = spec.find("tensors");
+  const auto operatorsIt = spec.find("operators");
+  if (tensorsIt == spec.end() || !tensorsIt->is_object() || operatorsIt == spec.end() || !operatorsIt->is_array()) {
+    if (outReport != nullptr) *outReport = std::move(report);
+    return 0;
+  }
+  Json& tensors = *tensorsIt;
+  Json& operators = *operatorsIt;
+
+  const auto attributeOf = [&](const std::string& name) -> std::optional<TensorAttribute> {
+    TensorAttribute attribute;
+    const auto it = tensors.find(name);
+    if (it == tensors.end() || it->value("is_gltf", false) || !JsonToTensorAttribute(*it, attribute)) {
+      return std::nullopt;
+    }
+    return attribute;
+  };
+  const auto layoutOf = [&](const std::string& name) {
+    const auto attribute = attributeOf(name);
+    return attribute.has_value() ? LayoutOf(*attribute) : ModelIoLayout::ANY;
+  };
+  const auto bytesOf = [&](const std::string& name) {
+    const auto attribute = attributeOf(name);
+    return attribute.has_value() ? TensorByteSize(*attribute) : size_t{0};
+  };
+  // Readers and writers of each tensor, including whoever consumes the pipeline's outputs
+  std::unordered_map<std::string, int> readCount;
+  std::unordered_map<std::string, std::vector<size_t>> writers;
+  std::unordered_map<std::string, std::vector<size_t>> readers;
+  for (size_t index = 0; index < operators.size(); ++index) {
+    for (const auto& name : ParseTensorList(operators[index].value("inputs", Json::array()))) {
+      ++readCount[name];
+      readers[name].push_back(index);
+    }
+    for (const auto& name : ParseTensorList(operators[index].value("outputs", Json::array()))) {
+      writers[name].push_back(index);
+    }
+  }
+  for (const auto& name : ParseTensorList(spec.value("outputs", Json::array()))) ++readCount[name];
+  // A tensor only passed from one operator to another, which can be skipped or changed in layout
+  const auto isPrivate = [&](const std::string& name) {
+    const auto it = tensors.find(name);
+    return it != tensors.end() && !it->value("is_placeholder", false) && readCount[name] == 1 &&
+           writers[name].size() == 1;
+  };
+  const auto isTranspose = [&](const size_t index) {
+    return operators[index].value("type", "") == "convert_hwc_chw";
+  };
+
+  std::vector<bool> removed(operators.size(), false);
+  std::vector<std::string> unused;
+  const auto drop = [&](const size_t index, const std::string& intermediate) {
+    removed[index] = true;
+    unused.push_back(intermediate);
+    ++report.droppedTransposes;
+    report.bytesSavedPerFrame += 2 * bytesOf(intermediate);
+  };
+
+  for (size_t index = 0; index < operators.size(); ++index) {
+    Json& model = operators[index];
+    if (model.value("type", "") != "run_algorithm") continue;
+    const auto layoutsOf = [&model](const char* key) {
+      std::unordered_map<std::string, ModelIoLayout> layouts;
+      if (const auto it = model.find(key); it != model.end() && it->is_object()) {
+        for (auto each = it->begin(); each != it->end(); ++each) {
+          ModelIoEncoding encoding;
+          if (JsonToModelIoEncoding(each.value(), encoding)) layouts.emplace(each.key(), encoding.layout);
+        }
+      }
+      return layouts;
+    };
+    const std::string modelName = model.value("model_name", "");
+
+    // Inputs: source -> transpose -> ... -> transpose -> model
+    const auto inputLayouts = layoutsOf("input_encodings");
+    auto inputs = ParseMappedTensorList(model.value("inputs", Json::array()));
+    for (auto& [operand, tensor] : inputs) {
+      const auto declared = inputLayouts.find(operand);
+      if (declared == inputLayouts.end() || declared->second == ModelIoLayout::ANY) continue;
+      std::vector<size_t> chain;
+      std::string source = tensor;
+      while (isPrivate(source) && writers[source].front() < index && isTranspose(writers[source].front())) {
+        chain.push_back(writers[source].front());
+        source = FirstTensor(operators[chain.back()], "inputs");
+      }
+      const auto sourceLayout = layoutOf(source);
+      if (sourceLayout == ModelIoLayout::ANY) continue;
+      if (sourceLayout != declared->second) {
+        if (chain.empty()) {
+          report.transposedIo.push_back(modelName + ":" + operand);
+          continue;
+        }
+        // Keep the transpose reading the source
+        for (size_t each = 0; each + 1 < chain.size(); ++each) {
+          drop(chain[each], FirstTensor(operators[chain[each]], "outputs"));
+        }
+        tensor = FirstTensor(operators[chain.back()], "outputs");
+        continue;
+      }
+      for (const auto each : chain) drop(each, FirstTensor(operators[each], "outputs"));
+      tensor = source;
+    }
+    model["inputs"] = MappedTensorListToJson(inputs);
+
+    // Results: model -> transpose -> ... -> transpose -> destination
+    const auto outputLayouts = layoutsOf("output_encodings");
+    auto outputs = ParseMappedTensorList(model.value("outputs", Json::array()));
+    for (auto& [result, tensor] : outputs) {
+      const auto declared = outputLayouts.find(result);
+      if (declared == outputLayouts.end() || declared->second == ModelIoLayout::ANY) continue;
+      std::vector<size_t> chain;
+      std::string destination = tensor;
+      while (isPrivate(destination) && readers[destination].size() == 1 && isTranspose(readers[destination].front())) {
+        chain.push_back(readers[destination].front());
+        destination = FirstTensor(operators[chain.back()], "outputs");
+      }
+      const auto destinationLayout = layoutOf(destination);
+      if (destinationLayout == ModelIoLayout::ANY) continue;
+      if (destinationLayout == declared->second) {
+        for (const auto each : chain) drop(each, FirstTensor(operators[each], "inputs"));
+        tensor = destination;
+      } else if (chain.empty()) {
+        report.transposedIo.push_back(modelName + ":" + result);
+      } else {
+        // Keep the transpose writing the destination
+        for (size_t each = 0; each + 1 < chain.size(); ++each) {
+          drop(chain[each], FirstTensor(operators[chain[each]], "inputs"));
+        }
+        tensor = FirstTensor(operators[chain.back()], "inputs");
+      }
+    }
+    model["outputs"] = MappedTensorListToJson(outputs);
+  }
+
+  Json reconciled = Json::array();
+  for (size_t index = 0; index < operators.size(); ++index) {
+    if (!removed[index]) reconciled.push_back(std::move(operators[index]));
+  }
+  operators = std::move(reconciled);
+  // The intermediates of the removed transposes, unless still used
+  std::unordered_map<std::string, int> uses;
+  for (const auto& opSpec : operators) {
+    for (const auto& name : ParseTensorList(opSpec.value("inputs", Json::array()))) ++uses[name];
+    for (const auto& name : ParseTensorList(opSpec.value("outputs", Json::array()))) ++uses[name];
+  }
+  for (const auto& name : unused) {
+    if (uses[name] == 0 && !tensors.value(name, Json::object()).value("is_placeholder", false)) tensors.erase(name);
+  }
+
+  const size_t count = report.droppedTransposes;
+  Log::Write(Log::Level::Info,
+             Fmt("ReconcileModelLayouts: %zu transposes dropped, %zu bytes per frame saved, %zu model I/O still "
+                 "transposed",
+                 report.droppedTransposes, report.bytesSavedPerFrame, report.transposedIo.size()));
+  if (outReport != nullptr) *outReport = std::move(report);
+  return count;
+}
+
 bool DeserializePipelineFromJson(const Json& spec,
                                  const std::shared_ptr<FrameworkSession>& session,
                                  PipelineDeserializationResult& outResult,
@@ -322,7 +541,7 @@ bool DeserializePipelineFromJson(const Json& spec,
                               requireByIndex(outputs, 0, "type_convert output"));
       } else if (type == "arithmetic") {
         const std::string expression = opSpec.value("expression", "");
-        std::vector<std::shared_ptr<PipelineTensor>> operands;
+        std::vector<TensorOperand> operands;
         operands.reserve(inputs.size());
         for (size_t idx = 0; idx < inputs.size(); ++idx) {
           operands.push_back(requireByIndex(inputs, idx, "arithmetic input"));
@@ -331,6 +550,12 @@ bool DeserializePipelineFromJson(const Json& spec,
           throw std::runtime_error("arithmetic requires output tensor");
         }
         pipeline->arithmetic(expression, operands, requireByIndex(outputs, 0, "arithmetic output"));
+      } else if (type == "convert_hwc_chw") {
+        if (inputs.empty() || outputs.empty()) {
+          throw std::runtime_error("convert_hwc_chw requires input and output tensors");
+        }
+        pipeline->convertHWC_CHW(requireByIndex(inputs, 0, "convert_hwc_chw input"),
+                                 requireByIndex(outputs, 0, "convert_hwc_chw output"));
       } else if (type == "run_algorithm") {
         // Parse mapped inputs/outputs
         auto mappedInputs = ParseMappedTensorList(opSpec.value("inputs", Json::array()));
@@ -408,8 +633,31 @@ bool DeserializePipelineFromJson(const Json& spec,
           }
         }
 
+        // Optional per-input/output encodings, e.g., "input_encodings": {"images": "ufixed8"} to feed uint8 frames
+        // to a quantized model as is, {"encoding": "ufixed8", "scale": 0.0039, "offset": 0} to quantize float32, or
+        // {"layout": "hwc"} for the layout the model reads
+        const auto parseEncodings = [&opSpec](const char* key) {
+          std::unordered_map<std::string, ModelIoEncoding> encodings;
+          if (auto it = opSpec.find(key); it != opSpec.end()) {
+            if (!it->is_object()) {
+              throw std::runtime_error(Fmt("run_algorithm '%s' must be an object", key));
+            }
+            for (auto each = it->begin(); each != it->end(); ++each) {
+              ModelIoEncoding encoding;
+              if (!JsonToModelIoEncoding(each.value(), encoding)) {
+                throw std::runtime_error(Fmt("run_algorithm '%s': malformed encoding of '%s'", key,
+                                             each.key().c_str()));
+              }
+              encodings.emplace(each.key(), encoding);
+            }
+          }
+          return encodings;
+        };
+        const auto operandEncodings = parseEncodings("input_encodings");
+        const auto resultEncodings = parseEncodings("output_encodings");
+
         pipeline->runAlgorithm(modelBuffer.data(), modelBuffer.size(), inputMap, operandAliasing, outputMap,
-                               resultAliasing, modelName);
+                               resultAliasing, modelName, operandEncodings, resultEncodings);
       } else {
         bool handled = false;
         if (options.customOperatorHandler) {
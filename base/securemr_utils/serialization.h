@@ -29,6 +29,7 @@
 
 namespace SecureMR {
 struct TensorAttribute;
+struct ModelIoEncoding;
 class FrameworkSession;
 class Pipeline;
 class PipelineTensor;
@@ -48,6 +49,13 @@ void SetOutputs(Json& spec, const std::vector<std::string>& outputs);
 bool JsonToTensorAttribute(const Json& j, TensorAttribute& out);
 std::vector<std::string> ParseTensorList(const Json& arr);
 std::vector<std::pair<std::string, std::string>> ParseMappedTensorList(const Json& arr);
+/**
+ * Read the encoding of a <code>run_algorithm</code> input or output: an encoding name, among <code>"float32"</code>,
+ * <code>"ufixed8"</code>, <code>"sfixed8"</code>, <code>"ufixed16"</code> and <code>"int32"</code>, or an object
+ * with the optional name as <code>"encoding"</code>, quantization <code>"scale"</code> and <code>"offset"</code>,
+ * and <code>"layout"</code> of the model, <code>"hwc"</code> or <code>"chw"</code>
+ */
+bool JsonToModelIoEncoding(const Json& j, ModelIoEncoding& out);
 bool JsonToFloatArray(const Json& arr, std::array<float, 6>& dest);
 Json LoadJsonFromFile(const std::filesystem::path& filePath);
 
@@ -64,6 +72,36 @@ struct PipelineDeserializationOptions {
       customOperatorHandler;
 };
 
+/**
+ * What <code>ReconcileModelLayouts</code> changed in a pipeline spec
+ */
+struct ModelLayoutReport {
+  size_t droppedTransposes = 0;
+  /**
+   * Bytes no longer written and read per submission by the dropped transposes
+   */
+  size_t bytesSavedPerFrame = 0;
+  /**
+   * <code>"<model>:<operand or result>"</code> still bound to a tensor of the other layout than the model's, which
+   * <code>Pipeline::runAlgorithm</code> transposes
+   */
+  std::vector<std::string> transposedIo;
+};
+
+/**
+ * Check the layout each <code>run_algorithm</code> operator declares for its inputs and outputs, as
+ * <code>"layout"</code> in <code>"input_encodings"</code> and <code>"output_encodings"</code>, against the
+ * <code>convert_hwc_chw</code> operators producing or consuming them.
+ * <br/>
+ * A chain of transposes between a tensor already in the model's layout and the model is dropped, e.g., when the
+ * model takes NHWC images through the custom I/O layout of its conversion, as in <code>Docker/custom_io.yaml</code>,
+ * while the pipeline still converts them to CHW. Of a chain that is needed, only one transpose is kept. The
+ * intermediate tensors are only skipped if no other operator reads them.
+ * @param outReport If not <code>nullptr</code>, receives the transposes removed and the bytes saved per frame
+ * @return The number of transposes dropped
+ */
+size_t ReconcileModelLayouts(Json& spec, ModelLayoutReport* outReport = nullptr);
+
 bool DeserializePipelineFromJson(const Json& spec,
                                  const std::shared_ptr<FrameworkSession>& session,
                                  PipelineDeserializationResult& outResult,
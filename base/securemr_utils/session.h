@@ -14,10 +14,13 @@
 
 #ifndef SESSION_H
 #define SESSION_H
+#include <memory>
 #include <optional>
 #include <string>
 
 #include "openxr/openxr.h"
+#include "tensorbandwidth.h"
+#include "tensormemory.h"
 
 namespace SecureMR {
 
@@ -40,6 +43,8 @@ class FrameworkSession {
   XrInstance m_instance = XR_NULL_HANDLE;
   XrSession m_session = XR_NULL_HANDLE;
   XrSecureMrFrameworkPICO m_frameworkSession = XR_NULL_HANDLE;
+  std::shared_ptr<TensorMemoryLedger> m_memory = std::make_shared<TensorMemoryLedger>();
+  std::shared_ptr<TensorBandwidthMeter> m_bandwidth = std::make_shared<TensorBandwidthMeter>();
 
  public:
   static PFN_xrCreateSecureMrFrameworkPICO xrCreateSecureMrFrameworkPICO;
@@ -57,6 +62,18 @@ class FrameworkSession {
 
   [[nodiscard]] XrSecureMrFrameworkPICO getFrameworkPICO() const { return m_frameworkSession; }
 
+  /**
+   * Bytes held by the global tensors of this session and the local tensors of its pipelines, with an optional
+   * budget enforced when tensors are created
+   */
+  [[nodiscard]] TensorMemoryLedger& memory() const { return *m_memory; }
+
+  /**
+   * Bytes of global tensors bound to the placeholders of the submissions of this session's pipelines, per global
+   * tensor and pipeline, with an optional periodic report
+   */
+  [[nodiscard]] TensorBandwidthMeter& bandwidth() const { return *m_bandwidth; }
+
   /**
    * Create a framework session
    * @param instance The OpenXR instance
@@ -15,6 +15,7 @@
 // #include "rendercommand.h"
 #include "pipeline.h"
 #include "tensor.h"
+#include "trace.h"
 
 #include <utility>
 
@@ -39,9 +40,11 @@ GlobalTensor::GlobalTensor(const std::shared_ptr<FrameworkSession>& session, Ten
       .dimensionsCount = static_cast<uint32_t>(attribute.dimensions.size()),
       .dimensions = attribute.dimensions.data(),
       .format = &format};
+  m_memoryToken = m_session->memory().allocate(nullptr, TensorByteSize(attribute), TensorDescription(attribute));
   auto result =
       xrCreateSecureMrTensorPICO(m_session->getFrameworkPICO(),
                                  reinterpret_cast<XrSecureMrTensorCreateInfoBaseHeaderPICO*>(&createInfo), &m_handle);
+  if (XR_FAILED(result)) m_session->memory().release(m_memoryToken);
   CHECK_XRRESULT(
       result,
       Fmt("xrCreateSecureMrTensorPICO(dimensionsCount = %d, format = {datatype = %d, channel = %d, tensorType = %d})",
@@ -55,6 +58,17 @@ GlobalTensor::GlobalTensor(const std::shared_ptr<FrameworkSession>& session, Ten
   setData(data, size);
 }
 
+GlobalTensor::GlobalTensor(const std::shared_ptr<FrameworkSession>& session, const TensorAttribute& attribute,
+                           const TensorTransport transport)
+    : GlobalTensor(session, TensorAttribute{.dimensions = attribute.dimensions,
+                                            .channels = attribute.channels,
+                                            .usage = attribute.usage,
+                                            .dataType = transport.storageType}) {
+  CHECK_MSG(transport.scale != 0.0f, "GlobalTensor(...) transport with a scale of 0")
+  m_transport = transport;
+  m_logicalDataType = attribute.dataType;
+}
+
 GlobalTensor::GlobalTensor(const std::shared_ptr<FrameworkSession>& session, char* const gltfContent, size_t size)
     : m_session(session), m_attribute(std::monostate()) {
   xrCreateSecureMrTensorPICO =
@@ -72,9 +86,11 @@ GlobalTensor::GlobalTensor(const std::shared_ptr<FrameworkSession>& session, cha
                                                    .bufferSize = static_cast<uint32_t>(size),
                                                    .buffer = gltfContent};
 
+  m_memoryToken = m_session->memory().allocate(nullptr, size, Fmt("glTF of %zu bytes", size));
   auto result =
       xrCreateSecureMrTensorPICO(m_session->getFrameworkPICO(),
                                  reinterpret_cast<XrSecureMrTensorCreateInfoBaseHeaderPICO*>(&createInfo), &m_handle);
+  if (XR_FAILED(result)) m_session->memory().release(m_memoryToken);
   CHECK_XRRESULT(result, Fmt("xrCreateSecureMrTensorPICO(gltf[%d])", size).c_str())
 }
 
@@ -82,6 +98,8 @@ GlobalTensor::GlobalTensor(const GlobalTensor& other)
     : XrHandleAdapter(other),
       m_session(other.m_session),
       m_attribute(other.m_attribute),
+      m_transport(other.m_transport),
+      m_logicalDataType(other.m_logicalDataType),
       xrCreateSecureMrTensorPICO(other.xrCreateSecureMrTensorPICO),
       xrDestroySecureMrTensorPICO(other.xrDestroySecureMrTensorPICO),
       xrResetSecureMrTensorPICO(other.xrResetSecureMrTensorPICO) {
@@ -94,9 +112,11 @@ GlobalTensor::GlobalTensor(const GlobalTensor& other)
                                                     .dimensionsCount = static_cast<uint32_t>(attr.dimensions.size()),
                                                     .dimensions = attr.dimensions.data(),
                                                     .format = &format};
+  m_memoryToken = m_session->memory().allocate(nullptr, TensorByteSize(attr), TensorDescription(attr));
   auto result =
       xrCreateSecureMrTensorPICO(m_session->getFrameworkPICO(),
                                  reinterpret_cast<XrSecureMrTensorCreateInfoBaseHeaderPICO*>(&createInfo), &m_handle);
+  if (XR_FAILED(result)) m_session->memory().release(m_memoryToken);
   CHECK_XRRESULT(
       result,
       Fmt("xrCreateSecureMrTensorPICO(dimensionsCount = %d, format = {datatype = %d, channel = %d, tensorType = %d})",
@@ -108,6 +128,17 @@ GlobalTensor::~GlobalTensor() {
   if (xrCreateSecureMrTensorPICO != nullptr) {
     xrDestroySecureMrTensorPICO(m_handle);
   }
+  if (m_session != nullptr) {
+    m_session->memory().release(m_memoryToken);
+    m_session->bandwidth().forgetGlobal(this);
+  }
+}
+
+std::variant<std::monostate, TensorAttribute> GlobalTensor::getLogicalAttribute() const {
+  if (!m_transport.has_value()) return m_attribute;
+  auto attribute = std::get<TensorAttribute>(m_attribute);
+  attribute.dataType = m_logicalDataType;
+  return attribute;
 }
 
 void GlobalTensor::setData(int8_t* data, size_t size) const {
@@ -117,50 +148,66 @@ void GlobalTensor::setData(int8_t* data, size_t size) const {
       .type = XR_TYPE_SECURE_MR_TENSOR_BUFFER_PICO, .bufferSize = static_cast<uint32_t>(size), .buffer = data};
   const auto result = xrResetSecureMrTensorPICO(m_handle, &buffer);
   CHECK_XRRESULT(result, Fmt("xrResetSecureMrTensorPICO(%p, %zu)", data, size).c_str());
+  if (const auto recorder = TraceRecorder::Active()) recorder->recordTensorWrite(*this, data, size);
+}
+
+void GlobalTensor::checkDataSize(const size_t size) const {
+  CHECK_MSG(std::holds_alternative<TensorAttribute>(m_attribute),
+            "GlobalTensor::setData(...) only for non-glTF global tensor")
+  const size_t tensorSize = TensorByteSize(std::get<TensorAttribute>(m_attribute));
+  CHECK_MSG(size > 0 && size <= tensorSize && tensorSize % size == 0,
+            Fmt("GlobalTensor::setData(...) of %zu bytes cannot fill a tensor of %zu bytes (%s)", size, tensorSize,
+                TensorDescription(std::get<TensorAttribute>(m_attribute)).c_str()))
 }
 
 PipelineTensor::Slice::Slice(const std::shared_ptr<PipelineTensor>& tensor,
                              const std::shared_ptr<PipelineTensor>& slices)
-    : m_tensor(tensor), m_slices(slices), m_channelSlice(nullptr) {}
+    : Slice(*tensor->m_pipeline, static_cast<XrSecureMrPipelineTensorPICO>(*tensor),
+            static_cast<XrSecureMrPipelineTensorPICO>(*slices)) {}
+
+PipelineTensor::Slice::Slice(Pipeline& pipeline, const XrSecureMrPipelineTensorPICO tensor,
+                             const XrSecureMrPipelineTensorPICO slices)
+    : m_pipeline(&pipeline), m_tensor(tensor), m_slices(slices) {}
 
 PipelineTensor::Slice& PipelineTensor::Slice::operator[](const std::shared_ptr<PipelineTensor>& channelSlice) {
-  m_channelSlice = channelSlice;
+  m_channelSlice = static_cast<XrSecureMrPipelineTensorPICO>(*channelSlice);
   return *this;
 }
 
 PipelineTensor::Slice& PipelineTensor::Slice::operator[](std::array<int, 3> channelSliceStatic) {
-  m_channelSlice = std::make_shared<PipelineTensor>(
-      m_tensor->m_pipeline, TensorAttribute{.dimensions = {1},
-                                            .channels = 3,
-                                            .usage = XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO,
-                                            .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
-  m_channelSlice->setData(reinterpret_cast<int8_t*>(channelSliceStatic.data()),
-                          channelSliceStatic.size() * sizeof(int32_t));
+  m_channelSlice = sliceTensorOf(*m_pipeline, {channelSliceStatic.begin(), channelSliceStatic.end()}, 3);
   return *this;
 }
 
 PipelineTensor::Slice& PipelineTensor::Slice::operator[](std::array<int, 2> channelSliceStatic) {
-  m_channelSlice = std::make_shared<PipelineTensor>(
-      m_tensor->m_pipeline, TensorAttribute{.dimensions = {1},
-                                            .channels = 2,
-                                            .usage = XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO,
-                                            .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
-  m_channelSlice->setData(reinterpret_cast<int8_t*>(channelSliceStatic.data()),
-                          channelSliceStatic.size() * sizeof(int32_t));
+  m_channelSlice = sliceTensorOf(*m_pipeline, {channelSliceStatic.begin(), channelSliceStatic.end()}, 2);
   return *this;
 }
 
 PipelineTensor::Slice& PipelineTensor::Slice::operator[](int index) {
-  m_channelSlice = std::make_shared<PipelineTensor>(
-      m_tensor->m_pipeline, TensorAttribute{.dimensions = {1},
-                                            .channels = 2,
-                                            .usage = XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO,
-                                            .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
-  int channelSliceData[]{static_cast<int>(index), static_cast<int>(index + 1)};
-  m_channelSlice->setData(reinterpret_cast<int8_t*>(channelSliceData), 2 * sizeof(int32_t));
+  m_channelSlice = sliceTensorOf(*m_pipeline, {index, index + 1}, 2);
   return *this;
 }
 
+XrSecureMrPipelineTensorPICO PipelineTensor::sliceTensorOf(Pipeline& pipeline, const std::vector<int32_t>& ranges,
+                                                           const int8_t channels) {
+  const auto slices = pipeline.createTensor(TensorAttribute{.dimensions = {static_cast<int>(ranges.size()) / channels},
+                                                            .channels = channels,
+                                                            .usage = XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO,
+                                                            .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
+  pipeline.setData(slices, reinterpret_cast<int8_t*>(const_cast<int32_t*>(ranges.data())),
+                   ranges.size() * sizeof(int32_t));
+  return pipeline.handleOf(slices);
+}
+
+XrSecureMrPipelineTensorPICO PipelineTensor::literalLike(const int8_t* data, const size_t size) const {
+  CHECK_MSG(std::holds_alternative<TensorAttribute>(m_attribute), "Literal comparison not for glTF tensor")
+  checkDataSize(size);
+  const auto literal = m_pipeline->createTensor(std::get<TensorAttribute>(m_attribute));
+  m_pipeline->setData(literal, const_cast<int8_t*>(data), size);
+  return m_pipeline->handleOf(literal);
+}
+
 PipelineTensor::PipelineTensor(std::shared_ptr<Pipeline> pipeline)
     : m_pipeline(std::move(pipeline)), m_attribute(std::monostate()), isPlaceholder(true) {
   xrCreateSecureMrPipelineTensorPICO =
@@ -192,9 +239,11 @@ PipelineTensor::PipelineTensor(std::shared_ptr<Pipeline> pipeline, TensorAttribu
       .dimensions = attribute.dimensions.data(),
       .format = &format};
 
+  const auto memoryToken = accountStorage();
   auto result = xrCreateSecureMrPipelineTensorPICO(
       static_cast<XrSecureMrPipelinePICO>(*m_pipeline),
       reinterpret_cast<XrSecureMrTensorCreateInfoBaseHeaderPICO*>(&createInfo), &m_handle);
+  if (XR_FAILED(result) && memoryToken != 0) m_pipeline->getRootSession()->memory().release(memoryToken);
   CHECK_XRRESULT(
       result,
       Fmt("xrCreateSecureMrPipelineTensorPICO(isPlaceholder = %s, dimensionsCount = %d, format = {datatype = %d, "
@@ -204,6 +253,37 @@ PipelineTensor::PipelineTensor(std::shared_ptr<Pipeline> pipeline, TensorAttribu
           .c_str())
 }
 
+PipelineTensor::PipelineTensor(std::shared_ptr<Pipeline> pipeline, TensorAttribute attribute, const bool isPlaceholder,
+                               const XrSecureMrPipelineTensorPICO handle)
+    : XrHandleAdapter(handle),
+      m_pipeline(std::move(pipeline)),
+      m_attribute(std::move(attribute)),
+      isPlaceholder(isPlaceholder) {
+  xrCreateSecureMrPipelineTensorPICO =
+      m_pipeline->getRootSession()->getAPIFromXrInstance<PFN_xrCreateSecureMrPipelineTensorPICO>(
+          "xrCreateSecureMrPipelineTensorPICO");
+  xrResetSecureMrPipelineTensorPICO =
+      m_pipeline->getRootSession()->getAPIFromXrInstance<PFN_xrResetSecureMrPipelineTensorPICO>(
+          "xrResetSecureMrPipelineTensorPICO");
+}
+
+uint64_t PipelineTensor::accountStorage() const {
+  const auto& session = m_pipeline->getRootSession();
+  if (isPlaceholder || session == nullptr || !std::holds_alternative<TensorAttribute>(m_attribute)) return 0;
+  // Local storage lives as long as the pipeline, so it is released by Pipeline::~Pipeline
+  const auto& attribute = std::get<TensorAttribute>(m_attribute);
+  return session->memory().allocate(m_pipeline.get(), TensorByteSize(attribute), TensorDescription(attribute));
+}
+
+void PipelineTensor::checkDataSize(const size_t size) const {
+  CHECK_MSG(!isPlaceholder, "setData(...) not for pipeline placeholder")
+  CHECK_MSG(std::holds_alternative<TensorAttribute>(m_attribute), "setData(...) not for glTF tensor")
+  const size_t tensorSize = TensorByteSize(std::get<TensorAttribute>(m_attribute));
+  CHECK_MSG(size > 0 && size <= tensorSize && tensorSize % size == 0,
+            Fmt("PipelineTensor::setData(...) of %zu bytes cannot fill a tensor of %zu bytes (%s)", size, tensorSize,
+                TensorDescription(std::get<TensorAttribute>(m_attribute)).c_str()))
+}
+
 PipelineTensor::PipelineTensor(std::shared_ptr<Pipeline> pipeline, TensorAttribute attribute, int8_t* data, size_t size)
     : PipelineTensor(std::move(pipeline), std::move(attribute), false) {
   setData(data, size);
@@ -232,6 +312,24 @@ std::shared_ptr<PipelineTensor> PipelineTensor::PipelinePlaceholderLike(const st
   return std::make_shared<PipelineTensor>(root, tensorAttr, true);
 }
 
+PipelineTensor::TransportEndpoint PipelineTensor::PipelineTransportReader(const std::shared_ptr<Pipeline>& root,
+                                                                          const std::shared_ptr<GlobalTensor>& global) {
+  const auto placeholder = PipelinePlaceholderLike(root, global);
+  if (!global->transport().has_value()) return {.placeholder = placeholder, .logical = placeholder};
+  const auto logical = std::make_shared<PipelineTensor>(root, std::get<TensorAttribute>(global->getLogicalAttribute()));
+  root->widen(placeholder, logical, global->transport()->scale);
+  return {.placeholder = placeholder, .logical = logical};
+}
+
+PipelineTensor::TransportEndpoint PipelineTensor::PipelineTransportWriter(const std::shared_ptr<Pipeline>& root,
+                                                                          const std::shared_ptr<GlobalTensor>& global) {
+  const auto placeholder = PipelinePlaceholderLike(root, global);
+  if (!global->transport().has_value()) return {.placeholder = placeholder, .logical = placeholder};
+  const auto logical = std::make_shared<PipelineTensor>(root, std::get<TensorAttribute>(global->getLogicalAttribute()));
+  root->narrowAtSubmit(logical, placeholder, global->transport()->scale);
+  return {.placeholder = placeholder, .logical = logical};
+}
+
 PipelineTensor::PipelineTensor(const PipelineTensor& other)
     : XrHandleAdapter(other),
       enable_shared_from_this(other),
@@ -251,9 +349,11 @@ PipelineTensor::PipelineTensor(const PipelineTensor& other)
                                                     .dimensions = attr.dimensions.data(),
                                                     .format = &format};
 
+  const auto memoryToken = accountStorage();
   auto result = xrCreateSecureMrPipelineTensorPICO(
       static_cast<XrSecureMrPipelinePICO>(*m_pipeline),
       reinterpret_cast<XrSecureMrTensorCreateInfoBaseHeaderPICO*>(&createInfo), &m_handle);
+  if (XR_FAILED(result) && memoryToken != 0) m_pipeline->getRootSession()->memory().release(memoryToken);
   CHECK_XRRESULT(
       result,
       Fmt("xrCreateSecureMrPipelineTensorPICO(isPlaceholder = %s, dimensionsCount = %d, format = {datatype = %d, "
@@ -288,14 +388,7 @@ PipelineTensor::Slice PipelineTensor::operator[](const std::vector<std::vector<i
     CHECK_MSG(eachSlice.size() == channelCnt, "operator[]: slices must be of the same size")
     for (auto& element : eachSlice) allSliceData.push_back(element);
   }
-  auto slicesTensor = std::make_shared<PipelineTensor>(
-      m_pipeline, TensorAttribute{.dimensions = {static_cast<int>(slices.size())},
-                                  .channels = static_cast<int8_t>(channelCnt),
-                                  .usage = XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO,
-                                  .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
-  slicesTensor->setData(reinterpret_cast<int8_t*>(allSliceData.data()), allSliceData.size() * sizeof(int));
-
-  return {shared_from_this(), slicesTensor};
+  return {*m_pipeline, m_handle, sliceTensorOf(*m_pipeline, allSliceData, static_cast<int8_t>(channelCnt))};
 }
 
 PipelineTensor::Slice PipelineTensor::operator[](const std::vector<int>& slices) {
@@ -308,18 +401,11 @@ PipelineTensor::Slice PipelineTensor::operator[](const std::vector<int>& slices)
     allSliceData.push_back(eachDimSlice);
     allSliceData.push_back(eachDimSlice + 1);
   }
-  auto slicesTensor = std::make_shared<PipelineTensor>(
-      m_pipeline, TensorAttribute{.dimensions = {static_cast<int>(slices.size())},
-                                  .channels = 2,
-                                  .usage = XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO,
-                                  .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
-  slicesTensor->setData(reinterpret_cast<int8_t*>(allSliceData.data()), allSliceData.size() * sizeof(int));
-
-  return {shared_from_this(), slicesTensor};
+  return {*m_pipeline, m_handle, sliceTensorOf(*m_pipeline, allSliceData, 2)};
 }
 
 PipelineTensor::Slice PipelineTensor::operator[](const std::shared_ptr<PipelineTensor>& sliceTensor) {
-  return {shared_from_this(), sliceTensor};
+  return {*m_pipeline, m_handle, static_cast<XrSecureMrPipelineTensorPICO>(*sliceTensor)};
 }
 
 PipelineTensor::Slice PipelineTensor::operator[](int index) {
@@ -327,40 +413,36 @@ PipelineTensor::Slice PipelineTensor::operator[](int index) {
   auto& attr = std::get<TensorAttribute>(m_attribute);
   CHECK_MSG(index >= 0 && index < attr.dimensions[0], "operator[]: index out of bounds")
 
-  std::vector<int> sliceData = {index, index + 1};
-  auto sliceTensor = std::make_shared<PipelineTensor>(
-      m_pipeline, TensorAttribute{.dimensions = {1},
-                                  .channels = 2,
-                                  .usage = XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO,
-                                  .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO});
-  sliceTensor->setData(reinterpret_cast<int8_t*>(sliceData.data()), sliceData.size() * sizeof(int));
+  return {*m_pipeline, m_handle, sliceTensorOf(*m_pipeline, {index, index + 1}, 2)};
+}
 
-  return {shared_from_this(), sliceTensor};
+PipelineTensor::Compare PipelineTensor::compareWith(const XrSecureMrPipelineTensorPICO other,
+                                                    const XrSecureMrComparisonPICO comparison) const {
+  return Compare{.left = m_handle, .right = other, .comparison = comparison};
 }
 
-PipelineTensor::Compare PipelineTensor::operator>(const std::shared_ptr<PipelineTensor>& other) const {
-  return Compare{.left = shared_from_this(), .right = other, .comparison = XR_SECURE_MR_COMPARISON_LARGER_THAN_PICO};
+PipelineTensor::Compare PipelineTensor::operator>(const TensorOperand& other) const {
+  return compareWith(m_pipeline->handleOf(other), XR_SECURE_MR_COMPARISON_LARGER_THAN_PICO);
 }
-PipelineTensor::Compare PipelineTensor::operator<(const std::shared_ptr<PipelineTensor>& other) const {
-  return Compare{.left = shared_from_this(), .right = other, .comparison = XR_SECURE_MR_COMPARISON_SMALLER_THAN_PICO};
+
+PipelineTensor::Compare PipelineTensor::operator<(const TensorOperand& other) const {
+  return compareWith(m_pipeline->handleOf(other), XR_SECURE_MR_COMPARISON_SMALLER_THAN_PICO);
 }
 
-PipelineTensor::Compare PipelineTensor::operator>=(const std::shared_ptr<PipelineTensor>& other) const {
-  return Compare{
-      .left = shared_from_this(), .right = other, .comparison = XR_SECURE_MR_COMPARISON_LARGER_OR_EQUAL_PICO};
+PipelineTensor::Compare PipelineTensor::operator>=(const TensorOperand& other) const {
+  return compareWith(m_pipeline->handleOf(other), XR_SECURE_MR_COMPARISON_LARGER_OR_EQUAL_PICO);
 }
 
-PipelineTensor::Compare PipelineTensor::operator<=(const std::shared_ptr<PipelineTensor>& other) const {
-  return Compare{
-      .left = shared_from_this(), .right = other, .comparison = XR_SECURE_MR_COMPARISON_SMALLER_OR_EQUAL_PICO};
+PipelineTensor::Compare PipelineTensor::operator<=(const TensorOperand& other) const {
+  return compareWith(m_pipeline->handleOf(other), XR_SECURE_MR_COMPARISON_SMALLER_OR_EQUAL_PICO);
 }
 
-PipelineTensor::Compare PipelineTensor::operator==(const std::shared_ptr<PipelineTensor>& other) const {
-  return Compare{.left = shared_from_this(), .right = other, .comparison = XR_SECURE_MR_COMPARISON_EQUAL_TO_PICO};
+PipelineTensor::Compare PipelineTensor::operator==(const TensorOperand& other) const {
+  return compareWith(m_pipeline->handleOf(other), XR_SECURE_MR_COMPARISON_EQUAL_TO_PICO);
 }
 
-PipelineTensor::Compare PipelineTensor::operator!=(const std::shared_ptr<PipelineTensor>& other) const {
-  return Compare{.left = shared_from_this(), .right = other, .comparison = XR_SECURE_MR_COMPARISON_NOT_EQUAL_PICO};
+PipelineTensor::Compare PipelineTensor::operator!=(const TensorOperand& other) const {
+  return compareWith(m_pipeline->handleOf(other), XR_SECURE_MR_COMPARISON_NOT_EQUAL_PICO);
 }
 
 }  // namespace SecureMR
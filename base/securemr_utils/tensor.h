@@ -15,6 +15,8 @@
 #ifndef ATENSOR_H
 #define ATENSOR_H
 #include <array>
+#include <optional>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -22,6 +24,7 @@
 #include "adapter.hpp"
 #include "pipeline.h"
 #include "check.h"
+#include "tensorref.h"
 
 namespace SecureMR {
 class Pipeline;
@@ -159,6 +162,20 @@ struct TensorAttribute_SliceArray {
   }
 };
 
+/**
+ * Reduced-precision storage of a global tensor, to cut its memory and the bytes exchanged between pipelines. The
+ * pipelines compute with the logical data type of the tensor, and convert at the placeholders: the stored value is
+ * the logical value multiplied by <code>scale</code>, then converted by <code>Pipeline::typeConvert</code>, which
+ * rounds and saturates as the runtime does.
+ * <br/>
+ * For example, an image normalized to [0, 1] in float32 can be stored as uint8 with a scale of 255, i.e., 4 times
+ * fewer bytes, at the cost of a 1/255 quantization step.
+ */
+struct TensorTransport {
+  XrSecureMrTensorDataTypePICO storageType = XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO;
+  float scale = 1.0f;
+};
+
 /**
  * Adapter of <code>XrSecureMrTensorPICO</code>, which represents a global tensor.
  * A global tensor is a tensor that is shared between pipelines. As pipelines are executed in different threads
@@ -175,6 +192,9 @@ class GlobalTensor : public XrHandleAdapter<XrSecureMrTensorPICO> {
  private:
   std::shared_ptr<FrameworkSession> m_session = nullptr;
   std::variant<std::monostate, TensorAttribute> m_attribute{};
+  uint64_t m_memoryToken = 0;
+  std::optional<TensorTransport> m_transport;
+  XrSecureMrTensorDataTypePICO m_logicalDataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO;
 
  protected:
   PFN_xrCreateSecureMrTensorPICO xrCreateSecureMrTensorPICO = nullptr;
@@ -201,6 +221,19 @@ class GlobalTensor : public XrHandleAdapter<XrSecureMrTensorPICO> {
    */
   GlobalTensor(const std::shared_ptr<FrameworkSession>& session, TensorAttribute attribute, int8_t* data, size_t size);
 
+  /**
+   * Create a global tensor stored in a narrower data type than the one its pipelines compute with. Use
+   * <code>PipelineTensor::PipelineTransportReader</code> and <code>PipelineTensor::PipelineTransportWriter</code>
+   * to access it with its logical data type; plain placeholders see the stored values.
+   * <br/>
+   * <b>NOTE</b> the data of <code>setData</code> is in the storage data type.
+   * @param session The framework session to which the global tensor's lifespan will be associated to
+   * @param attribute The tensor's logical attribute
+   * @param transport The storage data type, and the scale from logical to stored values
+   */
+  GlobalTensor(const std::shared_ptr<FrameworkSession>& session, const TensorAttribute& attribute,
+               TensorTransport transport);
+
   /**
    * Create a glTF tensor. In the implementation of SecureMR, a glTF object is treated as a tensor as well,
    * but of 0 dimension, 0 channel, none datatype and special GLTF usage flag.
@@ -239,16 +272,52 @@ class GlobalTensor : public XrHandleAdapter<XrSecureMrTensorPICO> {
    */
   void setData(int8_t* data, size_t size) const;
 
+  /**
+   * Write typed values to the tensor, without copying them on the host side.
+   * @param data The start address of the values to be written.
+   * @param count The number of values. The byte size, <code>count * sizeof(T)</code>, must divide the tensor's byte
+   *              size implied by its attribute, so that the values can be duplicated to fill the entire tensor.
+   * @throw std::logic_error if the byte size does not fit the tensor
+   */
+  template <typename T>
+  void setData(const T* data, size_t count) const {
+    static_assert(std::is_trivially_copyable_v<T>, "setData(...) requires trivially copyable values");
+    checkDataSize(count * sizeof(T));
+    setData(reinterpret_cast<int8_t*>(const_cast<T*>(data)), count * sizeof(T));
+  }
+  template <typename T>
+  void setData(const std::vector<T>& data) const {
+    setData(data.data(), data.size());
+  }
+  template <typename T, size_t N>
+  void setData(const std::array<T, N>& data) const {
+    setData(data.data(), N);
+  }
+
   [[nodiscard]] std::variant<std::monostate, TensorAttribute> getAttribute() const { return m_attribute; }
 
   /**
-   * A syntax sugar for <code>setData</code>
+   * The reduced-precision storage of the tensor, if created with one
+   */
+  [[nodiscard]] const std::optional<TensorTransport>& transport() const { return m_transport; }
+  /**
+   * The attribute the pipelines compute with: that of <code>getAttribute</code>, except for the data type of a
+   * tensor with a transport
+   */
+  [[nodiscard]] std::variant<std::monostate, TensorAttribute> getLogicalAttribute() const;
+
+  /**
+   * A syntax sugar for <code>setData</code>. The values are written straight from <code>input</code>, which binds to
+   * temporaries as well, so no copy is made either way.
    */
   template <typename T>
-  GlobalTensor& operator=(std::vector<T> input) {
-    setData(reinterpret_cast<int8_t*>(input.data()), input.size() * sizeof(T));
+  GlobalTensor& operator=(const std::vector<T>& input) {
+    setData(input);
     return *this;
   }
+
+ private:
+  void checkDataSize(size_t size) const;
 };
 
 /**
@@ -275,6 +344,29 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
   PFN_xrCreateSecureMrPipelineTensorPICO xrCreateSecureMrPipelineTensorPICO;
   PFN_xrResetSecureMrPipelineTensorPICO xrResetSecureMrPipelineTensorPICO;
 
+  /**
+   * Account the storage of a non-placeholder tensor in the memory ledger of the pipeline's session
+   * @return The token to release it with if the tensor cannot be created, 0 if not accounted
+   */
+  uint64_t accountStorage() const;
+  void checkDataSize(size_t size) const;
+
+  /**
+   * Create a local (non-placeholder) tensor of the same attribute as this one in the pipeline's tensor arena,
+   * holding the given values
+   */
+  template <typename T>
+  XrSecureMrPipelineTensorPICO literalLike(const std::vector<T>& values) const {
+    static_assert(std::is_trivially_copyable_v<T>, "Tensor values must be trivially copyable");
+    return literalLike(reinterpret_cast<const int8_t*>(values.data()), values.size() * sizeof(T));
+  }
+  XrSecureMrPipelineTensorPICO literalLike(const int8_t* data, size_t size) const;
+  /**
+   * Create a slice tensor of int32 ranges in the pipeline's tensor arena
+   */
+  static XrSecureMrPipelineTensorPICO sliceTensorOf(Pipeline& pipeline, const std::vector<int32_t>& ranges,
+                                                    int8_t channels);
+
  public:
   /**
    * Describe a comparison of two pipeline tensors, to be used by
@@ -284,8 +376,8 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * tensors, such as <code>Compare largeThan = pipelineTensor1 > pipelineTensor2</code>
    */
   struct Compare {
-    std::shared_ptr<const PipelineTensor> left;
-    std::shared_ptr<const PipelineTensor> right;
+    XrSecureMrPipelineTensorPICO left = XR_NULL_HANDLE;
+    XrSecureMrPipelineTensorPICO right = XR_NULL_HANDLE;
 
     XrSecureMrComparisonPICO comparison = XR_SECURE_MR_COMPARISON_EQUAL_TO_PICO;
   };
@@ -312,12 +404,17 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    */
   class Slice {
    private:
-    std::shared_ptr<const PipelineTensor> m_tensor;
-    std::shared_ptr<const PipelineTensor> m_slices;
-    std::shared_ptr<const PipelineTensor> m_channelSlice;
+    Pipeline* m_pipeline = nullptr;
+    XrSecureMrPipelineTensorPICO m_tensor = XR_NULL_HANDLE;
+    XrSecureMrPipelineTensorPICO m_slices = XR_NULL_HANDLE;
+    XrSecureMrPipelineTensorPICO m_channelSlice = XR_NULL_HANDLE;
 
    public:
     Slice(const std::shared_ptr<PipelineTensor>& tensor, const std::shared_ptr<PipelineTensor>& slices);
+    /**
+     * A slice on tensors given by their runtime handles, such as tensors of the pipeline's tensor arena
+     */
+    Slice(Pipeline& pipeline, XrSecureMrPipelineTensorPICO tensor, XrSecureMrPipelineTensorPICO slices);
 
     Slice(const Slice& other) = default;
     Slice(Slice&&) = default;
@@ -353,19 +450,13 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
      */
     Slice& operator[](int index);
 
-    [[nodiscard]] XrSecureMrPipelineTensorPICO targetTensor() const {
-      return static_cast<XrSecureMrPipelineTensorPICO>(*m_tensor);
-    }
+    [[nodiscard]] XrSecureMrPipelineTensorPICO targetTensor() const { return m_tensor; }
 
-    [[nodiscard]] XrSecureMrPipelineTensorPICO sliceTensor() const {
-      return static_cast<XrSecureMrPipelineTensorPICO>(*m_slices);
-    }
+    [[nodiscard]] XrSecureMrPipelineTensorPICO sliceTensor() const { return m_slices; }
 
-    [[nodiscard]] bool hasChannelSlice() const { return m_channelSlice != nullptr; }
+    [[nodiscard]] bool hasChannelSlice() const { return m_channelSlice != XR_NULL_HANDLE; }
 
-    [[nodiscard]] XrSecureMrPipelineTensorPICO channelSliceTensor() const {
-      return static_cast<XrSecureMrPipelineTensorPICO>(*m_channelSlice);
-    }
+    [[nodiscard]] XrSecureMrPipelineTensorPICO channelSliceTensor() const { return m_channelSlice; }
   };
 
   /**
@@ -411,6 +502,40 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
   static std::shared_ptr<PipelineTensor> PipelinePlaceholderLike(const std::shared_ptr<Pipeline>& root,
                                                                  const std::shared_ptr<GlobalTensor>& like);
 
+  /**
+   * The placeholder of a global tensor with a <code>TensorTransport</code>, and the local tensor of its logical
+   * data type, which the operators of the pipeline use instead of the placeholder
+   */
+  struct TransportEndpoint {
+    /**
+     * To be bound to the global tensor at submission
+     */
+    std::shared_ptr<PipelineTensor> placeholder;
+    std::shared_ptr<PipelineTensor> logical;
+  };
+
+  /**
+   * Create the endpoint of a pipeline reading a global tensor: the stored values are widened into
+   * <code>logical</code> by operators added right away, before the operators reading <code>logical</code>.
+   * <br/>
+   * For a global tensor without transport, both tensors of the endpoint are the same placeholder.
+   * @param root The SecureMR pipeline in which the pipeline tensors are local to
+   * @param global The global tensor to be read
+   */
+  static TransportEndpoint PipelineTransportReader(const std::shared_ptr<Pipeline>& root,
+                                                   const std::shared_ptr<GlobalTensor>& global);
+  /**
+   * Create the endpoint of a pipeline writing a global tensor: <code>logical</code> is narrowed into the stored
+   * values by operators added at the first submission of the pipeline, after all the operators writing
+   * <code>logical</code>.
+   * <br/>
+   * For a global tensor without transport, both tensors of the endpoint are the same placeholder.
+   * @param root The SecureMR pipeline in which the pipeline tensors are local to
+   * @param global The global tensor to be written
+   */
+  static TransportEndpoint PipelineTransportWriter(const std::shared_ptr<Pipeline>& root,
+                                                   const std::shared_ptr<GlobalTensor>& global);
+
   PipelineTensor(const PipelineTensor& other);
   PipelineTensor(PipelineTensor&& other) = default;
 
@@ -429,11 +554,34 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
   void setData(int8_t* data, size_t size) const;
 
   /**
-   * A syntax sugar to <code>setData</code>
+   * Write typed values to the tensor, without copying them on the host side.
+   * @param data The start address of the values to be written.
+   * @param count The number of values. The byte size, <code>count * sizeof(T)</code>, must divide the tensor's byte
+   *              size implied by its attribute, so that the values can be duplicated to fill the entire tensor.
+   * @throw std::logic_error if the byte size does not fit the tensor
+   */
+  template <typename T>
+  void setData(const T* data, size_t count) const {
+    static_assert(std::is_trivially_copyable_v<T>, "setData(...) requires trivially copyable values");
+    checkDataSize(count * sizeof(T));
+    setData(reinterpret_cast<int8_t*>(const_cast<T*>(data)), count * sizeof(T));
+  }
+  template <typename T>
+  void setData(const std::vector<T>& data) const {
+    setData(data.data(), data.size());
+  }
+  template <typename T, size_t N>
+  void setData(const std::array<T, N>& data) const {
+    setData(data.data(), N);
+  }
+
+  /**
+   * A syntax sugar to <code>setData</code>. The values are written straight from <code>input</code>, which binds to
+   * temporaries as well, so no copy is made either way.
    */
   template <typename T>
-  PipelineTensor& operator=(std::vector<T> input) {
-    setData(reinterpret_cast<int8_t*>(input.data()), input.size() * sizeof(T));
+  PipelineTensor& operator=(const std::vector<T>& input) {
+    setData(input);
     return *this;
   }
 
@@ -475,7 +623,7 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
   /**
    * A syntax sugar to quickly create a compare between two tensors, to be used by <code>Pipeline::compareTo</code>.
    */
-  Compare operator>(const std::shared_ptr<PipelineTensor>& other) const;
+  Compare operator>(const TensorOperand& other) const;
   /**
    * Compare directly to literal values. This pipeline tensor will be compare
    * against a implicitly-constructed PipelineTensor having the same attribute
@@ -483,15 +631,13 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * @param compareBase the literal values this tensor is to be compared with
    */
   template <typename T>
-  Compare operator>(std::vector<T> compareBase) const {
-    auto other = std::make_shared<PipelineTensor>(*this);
-    *other = compareBase;
-    return operator>(other);
+  Compare operator>(const std::vector<T>& compareBase) const {
+    return compareWith(literalLike(compareBase), XR_SECURE_MR_COMPARISON_LARGER_THAN_PICO);
   }
   /**
    * A syntax sugar to quickly create a compare between two tensors, to be used by <code>Pipeline::compareTo</code>.
    */
-  Compare operator<(const std::shared_ptr<PipelineTensor>& other) const;
+  Compare operator<(const TensorOperand& other) const;
   /**
    * Compare directly to literal values. This pipeline tensor will be compare
    * against a implicitly-constructed PipelineTensor having the same attribute
@@ -499,15 +645,13 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * @param compareBase the literal values this tensor is to be compared with
    */
   template <typename T>
-  Compare operator<(std::vector<T> compareBase) const {
-    auto other = std::make_shared<PipelineTensor>(*this);
-    *other = compareBase;
-    return operator<(other);
+  Compare operator<(const std::vector<T>& compareBase) const {
+    return compareWith(literalLike(compareBase), XR_SECURE_MR_COMPARISON_SMALLER_THAN_PICO);
   }
   /**
    * A syntax sugar to quickly create a compare between two tensors, to be used by <code>Pipeline::compareTo</code>.
    */
-  Compare operator>=(const std::shared_ptr<PipelineTensor>& other) const;
+  Compare operator>=(const TensorOperand& other) const;
   /**
    * Compare directly to literal values. This pipeline tensor will be compare
    * against a implicitly-constructed PipelineTensor having the same attribute
@@ -515,15 +659,13 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * @param compareBase the literal values this tensor is to be compared with
    */
   template <typename T>
-  Compare operator>=(std::vector<T> compareBase) const {
-    auto other = std::make_shared<PipelineTensor>(*this);
-    *other = compareBase;
-    return operator>=(other);
+  Compare operator>=(const std::vector<T>& compareBase) const {
+    return compareWith(literalLike(compareBase), XR_SECURE_MR_COMPARISON_LARGER_OR_EQUAL_PICO);
   }
   /**
    * A syntax sugar to quickly create a compare between two tensors, to be used by <code>Pipeline::compareTo</code>.
    */
-  Compare operator<=(const std::shared_ptr<PipelineTensor>& other) const;
+  Compare operator<=(const TensorOperand& other) const;
   /**
    * Compare directly to literal values. This pipeline tensor will be compare
    * against a implicitly-constructed PipelineTensor having the same attribute
@@ -531,15 +673,13 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * @param compareBase the literal values this tensor is to be compared with
    */
   template <typename T>
-  Compare operator<=(std::vector<T> compareBase) const {
-    auto other = std::make_shared<PipelineTensor>(*this);
-    *other = compareBase;
-    return operator<=(other);
+  Compare operator<=(const std::vector<T>& compareBase) const {
+    return compareWith(literalLike(compareBase), XR_SECURE_MR_COMPARISON_SMALLER_OR_EQUAL_PICO);
   }
   /**
    * A syntax sugar to quickly create a compare between two tensors, to be used by <code>Pipeline::compareTo</code>.
    */
-  Compare operator==(const std::shared_ptr<PipelineTensor>& other) const;
+  Compare operator==(const TensorOperand& other) const;
   /**
    * Compare directly to literal values. This pipeline tensor will be compare
    * against a implicitly-constructed PipelineTensor having the same attribute
@@ -547,15 +687,13 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * @param compareBase the literal values this tensor is to be compared with
    */
   template <typename T>
-  Compare operator==(std::vector<T> compareBase) const {
-    auto other = std::make_shared<PipelineTensor>(*this);
-    *other = compareBase;
-    return operator==(other);
+  Compare operator==(const std::vector<T>& compareBase) const {
+    return compareWith(literalLike(compareBase), XR_SECURE_MR_COMPARISON_EQUAL_TO_PICO);
   }
   /**
    * A syntax sugar to quickly create a compare between two tensors, to be used by <code>Pipeline::compareTo</code>.
    */
-  Compare operator!=(const std::shared_ptr<PipelineTensor>& other) const;
+  Compare operator!=(const TensorOperand& other) const;
   /**
    * Compare directly to literal values. This pipeline tensor will be compare
    * against a implicitly-constructed PipelineTensor having the same attribute
@@ -563,10 +701,8 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * @param compareBase the literal values this tensor is to be compared with
    */
   template <typename T>
-  Compare operator!=(std::vector<T> compareBase) const {
-    auto other = std::make_shared<PipelineTensor>(*this);
-    *other = compareBase;
-    return operator!=(other);
+  Compare operator!=(const std::vector<T>& compareBase) const {
+    return compareWith(literalLike(compareBase), XR_SECURE_MR_COMPARISON_NOT_EQUAL_PICO);
   }
 
   /**
@@ -575,6 +711,17 @@ class PipelineTensor : public XrHandleAdapter<XrSecureMrPipelineTensorPICO>,
    * @param pipeline The SecureMr pipeline to which the pipeline tensor is associated to
    */
   explicit PipelineTensor(std::shared_ptr<Pipeline> pipeline);
+
+ private:
+  friend class TensorArena;
+
+  /**
+   * Wrap a tensor already created by a <code>TensorArena</code>, whose storage is already accounted
+   */
+  PipelineTensor(std::shared_ptr<Pipeline> pipeline, TensorAttribute attribute, bool isPlaceholder,
+                 XrSecureMrPipelineTensorPICO handle);
+
+  [[nodiscard]] Compare compareWith(XrSecureMrPipelineTensorPICO other, XrSecureMrComparisonPICO comparison) const;
 };
 }  // namespace SecureMR
 
@@ -0,0 +1,95 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorarena.h"
+
+#include <utility>
+
+namespace SecureMR {
+
+TensorArena::TensorArena(Pipeline& pipeline) : m_pipeline(pipeline) {
+  const auto& session = m_pipeline.getRootSession();
+  xrCreateSecureMrPipelineTensorPICO =
+      session->getAPIFromXrInstance<PFN_xrCreateSecureMrPipelineTensorPICO>("xrCreateSecureMrPipelineTensorPICO");
+  xrResetSecureMrPipelineTensorPICO =
+      session->getAPIFromXrInstance<PFN_xrResetSecureMrPipelineTensorPICO>("xrResetSecureMrPipelineTensorPICO");
+  CHECK_MSG(xrCreateSecureMrPipelineTensorPICO != nullptr, "xrCreateSecureMrPipelineTensorPICO is null")
+  CHECK_MSG(xrResetSecureMrPipelineTensorPICO != nullptr, "xrResetSecureMrPipelineTensorPICO is null")
+}
+
+uint32_t TensorArena::create(const std::vector<TensorAttribute>& attributes, const bool isPlaceholder) {
+  const auto first = static_cast<uint32_t>(m_entries.size());
+  m_entries.reserve(m_entries.size() + attributes.size());
+  auto& memory = m_pipeline.getRootSession()->memory();
+  const auto pipelineHandle = static_cast<XrSecureMrPipelinePICO>(m_pipeline);
+
+  for (const auto& attribute : attributes) {
+    XrSecureMrTensorFormatPICO format = {
+        .dataType = attribute.dataType, .channel = attribute.channels, .tensorType = attribute.usage};
+    XrSecureMrTensorCreateInfoShapePICO createInfo = {
+        .type = XR_TYPE_SECURE_MR_TENSOR_CREATE_INFO_SHAPE_PICO,
+        .placeHolder = isPlaceholder,
+        .dimensionsCount = static_cast<uint32_t>(attribute.dimensions.size()),
+        .dimensions = const_cast<int*>(attribute.dimensions.data()),
+        .format = &format};
+
+    // Local storage lives as long as the pipeline, so it is released by Pipeline::~Pipeline
+    const uint64_t memoryToken =
+        isPlaceholder ? 0 : memory.allocate(&m_pipeline, TensorByteSize(attribute), TensorDescription(attribute));
+    Entry entry{.isPlaceholder = isPlaceholder, .attribute = attribute};
+    const auto result = xrCreateSecureMrPipelineTensorPICO(
+        pipelineHandle, reinterpret_cast<XrSecureMrTensorCreateInfoBaseHeaderPICO*>(&createInfo), &entry.handle);
+    if (XR_FAILED(result) && memoryToken != 0) memory.release(memoryToken);
+    CHECK_XRRESULT(result,
+                   Fmt("xrCreateSecureMrPipelineTensorPICO(tensor %zu of %zu in bulk, isPlaceholder = %s, %s)",
+                       m_entries.size() - first, attributes.size(), isPlaceholder ? "true" : "false",
+                       TensorDescription(attribute).c_str())
+                       .c_str())
+    m_entries.push_back(std::move(entry));
+  }
+  return first;
+}
+
+const TensorArena::Entry& TensorArena::at(const uint32_t index) const {
+  CHECK_MSG(index < m_entries.size(), Fmt("Tensor %u is not in the arena of %zu tensors", index, m_entries.size()))
+  return m_entries[index];
+}
+
+XrSecureMrPipelineTensorPICO TensorArena::handle(const uint32_t index) const { return at(index).handle; }
+
+const TensorAttribute& TensorArena::attribute(const uint32_t index) const { return at(index).attribute; }
+
+bool TensorArena::isPlaceholder(const uint32_t index) const { return at(index).isPlaceholder; }
+
+void TensorArena::setData(const uint32_t index, int8_t* const data, const size_t size) const {
+  const auto& entry = at(index);
+  CHECK_MSG(!entry.isPlaceholder, "setData(...) not for pipeline placeholder")
+  XrSecureMrTensorBufferPICO buffer{
+      .type = XR_TYPE_SECURE_MR_TENSOR_BUFFER_PICO, .bufferSize = static_cast<uint32_t>(size), .buffer = data};
+  const auto result =
+      xrResetSecureMrPipelineTensorPICO(static_cast<XrSecureMrPipelinePICO>(m_pipeline), entry.handle, &buffer);
+  CHECK_XRRESULT(result, Fmt("xrResetSecureMrPipelineTensorPICO(%p, %zu)", data, size).c_str())
+}
+
+std::shared_ptr<PipelineTensor> TensorArena::shared(const uint32_t index) {
+  (void)at(index);  // Bounds check
+  auto& entry = m_entries[index];
+  if (auto wrapper = entry.wrapper.lock()) return wrapper;
+  std::shared_ptr<PipelineTensor> wrapper(
+      new PipelineTensor(m_pipeline.shared_from_this(), entry.attribute, entry.isPlaceholder, entry.handle));
+  entry.wrapper = wrapper;
+  return wrapper;
+}
+
+}  // namespace SecureMR
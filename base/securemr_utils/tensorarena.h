@@ -0,0 +1,87 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_TENSORARENA_H_
+#define SECUREMR_UTILS_TENSORARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+/**
+ * Contiguous storage of the pipeline tensors created in bulk by <code>Pipeline::createTensors</code>.
+ * <br/>
+ * The arena keeps the raw tensor handles and their attributes in one array, and resolves the OpenXR functions it
+ * needs once, instead of once per tensor as the <code>PipelineTensor</code> constructors do. Tensors are referred to
+ * by <code>TensorRef</code>. A <code>PipelineTensor</code> wrapper is only created when existing code asks for a
+ * <code>std::shared_ptr</code>, and the same wrapper is handed out while it is alive.
+ * <br/>
+ * Pipeline tensors are freed by the runtime with their pipeline, so the arena only needs to live as long as the
+ * pipeline that owns it.
+ */
+class TensorArena {
+ public:
+  explicit TensorArena(Pipeline& pipeline);
+
+  TensorArena(const TensorArena&) = delete;
+  TensorArena& operator=(const TensorArena&) = delete;
+
+  /**
+   * Create one tensor per attribute
+   * @param isPlaceholder Whether all of the tensors are placeholders
+   * @return Index of the first tensor created; the others follow contiguously
+   */
+  uint32_t create(const std::vector<TensorAttribute>& attributes, bool isPlaceholder);
+
+  [[nodiscard]] size_t size() const { return m_entries.size(); }
+  [[nodiscard]] XrSecureMrPipelineTensorPICO handle(uint32_t index) const;
+  [[nodiscard]] const TensorAttribute& attribute(uint32_t index) const;
+  [[nodiscard]] bool isPlaceholder(uint32_t index) const;
+
+  /**
+   * Write values to a non-placeholder tensor, with the semantics of <code>PipelineTensor::setData</code>
+   */
+  void setData(uint32_t index, int8_t* data, size_t size) const;
+
+  /**
+   * @return A <code>PipelineTensor</code> wrapping the tensor at <code>index</code>, for the APIs taking
+   *         <code>std::shared_ptr</code>
+   */
+  std::shared_ptr<PipelineTensor> shared(uint32_t index);
+
+ private:
+  struct Entry {
+    XrSecureMrPipelineTensorPICO handle = XR_NULL_HANDLE;
+    bool isPlaceholder = false;
+    TensorAttribute attribute;
+    std::weak_ptr<PipelineTensor> wrapper;
+  };
+
+  [[nodiscard]] const Entry& at(uint32_t index) const;
+
+  Pipeline& m_pipeline;
+  PFN_xrCreateSecureMrPipelineTensorPICO xrCreateSecureMrPipelineTensorPICO = nullptr;
+  PFN_xrResetSecureMrPipelineTensorPICO xrResetSecureMrPipelineTensorPICO = nullptr;
+  std::vector<Entry> m_entries;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_TENSORARENA_H_
@@ -0,0 +1,186 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorbandwidth.h"
+
+#include <algorithm>
+
+#include "pipeline.h"
+
+namespace SecureMR {
+
+namespace {
+
+std::string FormatRate(const double bytesPerSecond) {
+  if (bytesPerSecond >= (1 << 20)) return Fmt("%.2f MiB/s", bytesPerSecond / (1 << 20));
+  if (bytesPerSecond >= (1 << 10)) return Fmt("%.2f KiB/s", bytesPerSecond / (1 << 10));
+  return Fmt("%.0f B/s", bytesPerSecond);
+}
+
+const char* AccessName(const TensorBandwidthMeter::Flow& flow) {
+  if (!flow.declared) return "binds";
+  if (flow.reads && flow.writes) return "reads and writes";
+  return flow.writes ? "writes" : "reads";
+}
+
+}  // namespace
+
+void TensorBandwidthMeter::setReportInterval(const Clock::duration interval) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_reportInterval = interval;
+}
+
+TensorBandwidthMeter::Clock::duration TensorBandwidthMeter::reportInterval() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_reportInterval;
+}
+
+void TensorBandwidthMeter::label(const GlobalTensor& global, const std::string& name) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_labels[&global] = name;
+}
+
+void TensorBandwidthMeter::declareAccess(const Pipeline* pipeline, const GlobalTensor* global, const bool reads,
+                                         const bool writes) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto& access = m_accesses[{global, pipeline}];
+  access.first |= reads;
+  access.second |= writes;
+}
+
+void TensorBandwidthMeter::recordSubmit(
+    const Pipeline* pipeline,
+    const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap,
+    const GlobalTensor* condition) {
+  const auto count = [this, pipeline](const GlobalTensor* global) {
+    auto& counter = m_counters[{global, pipeline}];
+    if (counter.submits++ == 0) {
+      const auto attribute = global->getAttribute();
+      if (std::holds_alternative<TensorAttribute>(attribute)) {
+        counter.tensorBytes = TensorByteSize(std::get<TensorAttribute>(attribute));
+        counter.description = TensorDescription(std::get<TensorAttribute>(attribute));
+      } else {
+        counter.description = "glTF";
+      }
+    }
+  };
+
+  std::string text;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (const auto& [placeholder, global] : argumentMap) count(global.get());
+    if (condition != nullptr) count(condition);
+    const auto now = Clock::now();
+    if (m_reportInterval > Clock::duration::zero() && now - m_windowStart >= m_reportInterval) {
+      text = reportLocked(now, 10);
+      m_counters.clear();
+      m_windowStart = now;
+    }
+  }
+  if (!text.empty()) Log::Write(Log::Level::Info, text);
+}
+
+void TensorBandwidthMeter::forgetGlobal(const GlobalTensor* global) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const auto ofGlobal = [global](const auto& entry) { return entry.first.first == global; };
+  for (auto it = m_counters.begin(); it != m_counters.end();) it = ofGlobal(*it) ? m_counters.erase(it) : ++it;
+  for (auto it = m_accesses.begin(); it != m_accesses.end();) it = ofGlobal(*it) ? m_accesses.erase(it) : ++it;
+  m_labels.erase(global);
+}
+
+void TensorBandwidthMeter::forgetPipeline(const Pipeline* pipeline) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const auto ofPipeline = [pipeline](const auto& entry) { return entry.first.second == pipeline; };
+  for (auto it = m_counters.begin(); it != m_counters.end();) it = ofPipeline(*it) ? m_counters.erase(it) : ++it;
+  for (auto it = m_accesses.begin(); it != m_accesses.end();) it = ofPipeline(*it) ? m_accesses.erase(it) : ++it;
+}
+
+void TensorBandwidthMeter::reset() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_counters.clear();
+  m_windowStart = Clock::now();
+}
+
+std::vector<TensorBandwidthMeter::Flow> TensorBandwidthMeter::flows() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return flowsLocked(Clock::now());
+}
+
+std::string TensorBandwidthMeter::report(const size_t count) const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return reportLocked(Clock::now(), count);
+}
+
+std::vector<TensorBandwidthMeter::Flow> TensorBandwidthMeter::flowsLocked(const Clock::time_point now) const {
+  const double seconds = std::max(std::chrono::duration<double>(now - m_windowStart).count(), 1e-9);
+  std::vector<Flow> flows;
+  flows.reserve(m_counters.size());
+  for (const auto& [key, counter] : m_counters) {
+    Flow flow{.global = key.first,
+              .pipeline = key.second,
+              .description = counter.description,
+              .tensorBytes = counter.tensorBytes,
+              .submits = counter.submits,
+              .submitsPerSecond = static_cast<double>(counter.submits) / seconds,
+              .bytesPerSecond = static_cast<double>(counter.submits * counter.tensorBytes) / seconds};
+    if (const auto label = m_labels.find(key.first); label != m_labels.end()) {
+      flow.description = label->second + " (" + counter.description + ")";
+    }
+    if (const auto access = m_accesses.find(key); access != m_accesses.end()) {
+      flow.declared = true;
+      flow.reads = access->second.first;
+      flow.writes = access->second.second;
+    }
+    flows.push_back(std::move(flow));
+  }
+  std::stable_sort(flows.begin(), flows.end(),
+                   [](const Flow& a, const Flow& b) { return a.bytesPerSecond > b.bytesPerSecond; });
+  return flows;
+}
+
+std::string TensorBandwidthMeter::reportLocked(const Clock::time_point now, const size_t count) const {
+  const auto flows = flowsLocked(now);
+  // Busiest global tensors first, each with its flows
+  std::vector<std::pair<const GlobalTensor*, double>> globals;
+  double total = 0.0;
+  for (const auto& flow : flows) {
+    total += flow.bytesPerSecond;
+    const auto it = std::find_if(globals.begin(), globals.end(),
+                                 [&flow](const auto& each) { return each.first == flow.global; });
+    if (it == globals.end()) {
+      globals.emplace_back(flow.global, flow.bytesPerSecond);
+    } else {
+      it->second += flow.bytesPerSecond;
+    }
+  }
+  std::stable_sort(globals.begin(), globals.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+  std::string text = Fmt("Global tensor traffic: %s over %.2f s, %zu global tensors", FormatRate(total).c_str(),
+                         std::chrono::duration<double>(now - m_windowStart).count(), globals.size());
+  for (size_t i = 0; i < std::min(count, globals.size()); ++i) {
+    bool first = true;
+    for (const auto& flow : flows) {
+      if (flow.global != globals[i].first) continue;
+      if (first) {
+        text += Fmt("\n  %12s  %s", FormatRate(globals[i].second).c_str(), flow.description.c_str());
+        first = false;
+      }
+      text += Fmt("\n      %12s  %6.1f submits/s  pipeline %u %s", FormatRate(flow.bytesPerSecond).c_str(),
+                  flow.submitsPerSecond, flow.pipeline->id(), AccessName(flow));
+    }
+  }
+  return text;
+}
+
+}  // namespace SecureMR
@@ -0,0 +1,137 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_TENSORBANDWIDTH_H_
+#define SECUREMR_UTILS_TENSORBANDWIDTH_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SecureMR {
+
+class Pipeline;
+class PipelineTensor;
+class GlobalTensor;
+
+/**
+ * Accounts the global tensor traffic between the pipelines of a framework session: the bytes of the global tensors
+ * bound to the placeholders of each submission, per global tensor and per pipeline.
+ * <br/>
+ * Every <code>FrameworkSession</code> has one meter, fed by <code>Pipeline::submit</code>. Whether a pipeline
+ * produces or consumes a global tensor is not visible at submission; it is declared by
+ * <code>declareAccess</code>, as done by <code>PipelineGraph::add</code> from the roles of its bindings. Undeclared
+ * bindings are reported as such.
+ * <br/>
+ * Rates are measured over a window, which starts when the meter is created or <code>reset</code>. With a report
+ * interval, the meter logs its report and starts a new window whenever a submission ends one.
+ */
+class TensorBandwidthMeter {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * The traffic of one global tensor bound to the placeholders of one pipeline
+   */
+  struct Flow {
+    const GlobalTensor* global = nullptr;
+    const Pipeline* pipeline = nullptr;
+    /**
+     * The label of the global tensor, or its shape and type
+     */
+    std::string description;
+    size_t tensorBytes = 0;
+    uint64_t submits = 0;
+    double submitsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+    bool declared = false;
+    bool reads = false;
+    bool writes = false;
+  };
+
+  /**
+   * @param interval Length of the window logged and restarted by the submissions, 0 for no periodic report
+   */
+  void setReportInterval(Clock::duration interval);
+  [[nodiscard]] Clock::duration reportInterval() const;
+
+  /**
+   * Name a global tensor in the reports, e.g., after the variable holding it
+   */
+  void label(const GlobalTensor& global, const std::string& name);
+
+  /**
+   * Declare how a pipeline accesses the global tensor bound to its placeholders, for the producer and consumer
+   * breakdown of the reports
+   */
+  void declareAccess(const Pipeline* pipeline, const GlobalTensor* global, bool reads, bool writes);
+
+  /**
+   * Account one submission, with the global tensor bound to each placeholder and the condition tensor, which is
+   * read
+   */
+  void recordSubmit(const Pipeline* pipeline,
+                    const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap,
+                    const GlobalTensor* condition);
+
+  /**
+   * Forget a global tensor or a pipeline being destroyed, so that a new one at the same address starts afresh
+   */
+  void forgetGlobal(const GlobalTensor* global);
+  void forgetPipeline(const Pipeline* pipeline);
+
+  /**
+   * Start a new window, keeping the labels and declared accesses
+   */
+  void reset();
+
+  /**
+   * The flows of the current window, by decreasing bytes per second
+   */
+  [[nodiscard]] std::vector<Flow> flows() const;
+
+  /**
+   * Multi-line summary of the current window: the total, then the <code>count</code> busiest global tensors with
+   * the pipelines producing and consuming each of them
+   */
+  [[nodiscard]] std::string report(size_t count = 10) const;
+
+ private:
+  struct Counter {
+    std::string description;
+    size_t tensorBytes = 0;
+    uint64_t submits = 0;
+  };
+
+  [[nodiscard]] std::vector<Flow> flowsLocked(Clock::time_point now) const;
+  [[nodiscard]] std::string reportLocked(Clock::time_point now, size_t count) const;
+
+  mutable std::mutex m_mutex;
+  Clock::duration m_reportInterval = Clock::duration::zero();
+  Clock::time_point m_windowStart = Clock::now();
+  std::map<std::pair<const GlobalTensor*, const Pipeline*>, Counter> m_counters;
+  std::map<std::pair<const GlobalTensor*, const Pipeline*>, std::pair<bool, bool>> m_accesses;
+  std::unordered_map<const GlobalTensor*, std::string> m_labels;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_TENSORBANDWIDTH_H_
@@ -0,0 +1,208 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensormemory.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#include "pipeline.h"
+
+namespace SecureMR {
+
+namespace {
+
+size_t DataTypeByteSize(const XrSecureMrTensorDataTypePICO dataType) {
+  switch (dataType) {
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+      return 1;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
+      return 2;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
+      return 4;
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+const char* DataTypeName(const XrSecureMrTensorDataTypePICO dataType) {
+  switch (dataType) {
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO:
+      return "UINT8";
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO:
+      return "INT8";
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO:
+      return "UINT16";
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO:
+      return "INT16";
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO:
+      return "INT32";
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO:
+      return "FLOAT32";
+    case XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO:
+      return "FLOAT64";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+std::string FormatBytes(const size_t bytes) {
+  if (bytes >= (size_t{1} << 20)) return Fmt("%.2f MiB", static_cast<double>(bytes) / (1 << 20));
+  if (bytes >= (size_t{1} << 10)) return Fmt("%.2f KiB", static_cast<double>(bytes) / (1 << 10));
+  return Fmt("%zu B", bytes);
+}
+
+}  // namespace
+
+size_t TensorByteSize(const TensorAttribute& attribute) {
+  const size_t elements = std::accumulate(attribute.dimensions.begin(), attribute.dimensions.end(), size_t{1},
+                                          [](const size_t product, const int dim) {
+                                            return product * static_cast<size_t>(std::max(dim, 0));
+                                          });
+  return elements * static_cast<size_t>(std::max<int8_t>(attribute.channels, 1)) *
+         DataTypeByteSize(attribute.dataType);
+}
+
+std::string TensorDescription(const TensorAttribute& attribute) {
+  std::string shape;
+  for (const int dim : attribute.dimensions) shape += (shape.empty() ? "" : "x") + std::to_string(dim);
+  if (attribute.channels > 1) shape += "x" + std::to_string(attribute.channels);
+  return shape + " " + DataTypeName(attribute.dataType);
+}
+
+void TensorMemoryLedger::Add(Usage& usage, const size_t bytes) {
+  usage.liveBytes += bytes;
+  usage.peakBytes = std::max(usage.peakBytes, usage.liveBytes);
+  ++usage.tensorCount;
+}
+
+void TensorMemoryLedger::setBudget(const size_t bytes) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_budget = bytes;
+}
+
+size_t TensorMemoryLedger::budget() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_budget;
+}
+
+uint64_t TensorMemoryLedger::allocate(const Pipeline* pipeline, const size_t bytes, const std::string& description) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  CHECK_MSG(m_budget == 0 || m_total.liveBytes + bytes <= m_budget,
+            Fmt("Tensor memory budget exceeded: creating %s (%s) on top of %s live, budget %s", description.c_str(),
+                FormatBytes(bytes).c_str(), FormatBytes(m_total.liveBytes).c_str(), FormatBytes(m_budget).c_str()))
+  const uint64_t token = m_nextToken++;
+  m_allocations.emplace(token,
+                        Allocation{.token = token, .pipeline = pipeline, .bytes = bytes, .description = description});
+  Add(m_total, bytes);
+  Add(pipeline == nullptr ? m_globals : m_pipelines[pipeline], bytes);
+  return token;
+}
+
+void TensorMemoryLedger::release(const uint64_t token) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const auto it = m_allocations.find(token);
+  if (it == m_allocations.end()) return;
+  const Allocation& allocation = it->second;
+  m_total.liveBytes -= allocation.bytes;
+  --m_total.tensorCount;
+  if (allocation.pipeline == nullptr) {
+    m_globals.liveBytes -= allocation.bytes;
+    --m_globals.tensorCount;
+  } else {
+    auto& usage = m_pipelines[allocation.pipeline];
+    usage.liveBytes -= allocation.bytes;
+    --usage.tensorCount;
+  }
+  m_allocations.erase(it);
+}
+
+void TensorMemoryLedger::releasePipeline(const Pipeline* pipeline) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  for (auto it = m_allocations.begin(); it != m_allocations.end();) {
+    if (it->second.pipeline == pipeline) {
+      m_total.liveBytes -= it->second.bytes;
+      --m_total.tensorCount;
+      it = m_allocations.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  m_pipelines.erase(pipeline);
+}
+
+TensorMemoryLedger::Usage TensorMemoryLedger::total() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_total;
+}
+
+TensorMemoryLedger::Usage TensorMemoryLedger::globalTensors() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_globals;
+}
+
+TensorMemoryLedger::Usage TensorMemoryLedger::pipelineTensors(const Pipeline* pipeline) const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const auto it = m_pipelines.find(pipeline);
+  return it != m_pipelines.end() ? it->second : Usage{};
+}
+
+std::vector<TensorMemoryLedger::Allocation> TensorMemoryLedger::topConsumers(const size_t count) const {
+  std::vector<Allocation> result;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    result.reserve(m_allocations.size());
+    for (const auto& [token, allocation] : m_allocations) result.push_back(allocation);
+  }
+  const size_t kept = std::min(count, result.size());
+  std::partial_sort(result.begin(), result.begin() + static_cast<ptrdiff_t>(kept), result.end(),
+                    [](const Allocation& a, const Allocation& b) {
+                      return a.bytes != b.bytes ? a.bytes > b.bytes : a.token < b.token;
+                    });
+  result.resize(kept);
+  return result;
+}
+
+std::string TensorMemoryLedger::report(const size_t count) const {
+  std::string text;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    text += Fmt("Tensor memory: %s live in %zu tensors, peak %s", FormatBytes(m_total.liveBytes).c_str(),
+                m_total.tensorCount, FormatBytes(m_total.peakBytes).c_str());
+    if (m_budget > 0) text += Fmt(", budget %s", FormatBytes(m_budget).c_str());
+    text += Fmt("\n  global tensors: %s live in %zu tensors, peak %s", FormatBytes(m_globals.liveBytes).c_str(),
+                m_globals.tensorCount, FormatBytes(m_globals.peakBytes).c_str());
+    for (const auto& [pipeline, usage] : m_pipelines) {
+      text += Fmt("\n  pipeline %p: %s live in %zu tensors, peak %s", static_cast<const void*>(pipeline),
+                  FormatBytes(usage.liveBytes).c_str(), usage.tensorCount, FormatBytes(usage.peakBytes).c_str());
+    }
+  }
+  for (const auto& allocation : topConsumers(count)) {
+    text += Fmt("\n  %10s  %s", FormatBytes(allocation.bytes).c_str(), allocation.description.c_str());
+    if (allocation.pipeline != nullptr) {
+      text += Fmt(" (local to pipeline %p)", static_cast<const void*>(allocation.pipeline));
+    } else {
+      text += " (global)";
+    }
+  }
+  return text;
+}
+
+}  // namespace SecureMR
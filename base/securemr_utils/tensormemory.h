@@ -0,0 +1,118 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_TENSORMEMORY_H_
+#define SECUREMR_UTILS_TENSORMEMORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SecureMR {
+
+class Pipeline;
+struct TensorAttribute;
+
+/**
+ * Bytes of storage behind a tensor of the given attribute, i.e., elements x channels x size of the data type
+ */
+size_t TensorByteSize(const TensorAttribute& attribute);
+
+/**
+ * Human-readable shape and type of a tensor, such as <code>"640x640x3 FLOAT32"</code>
+ */
+std::string TensorDescription(const TensorAttribute& attribute);
+
+/**
+ * Accounts the tensor storage held by a framework session: the global tensors it owns, and the local (non-placeholder)
+ * tensors of each of its pipelines, including those created implicitly for literal operands.
+ * <br/>
+ * Every <code>FrameworkSession</code> has one ledger, fed by the constructors and destructors of
+ * <code>GlobalTensor</code>, <code>PipelineTensor</code> and <code>Pipeline</code>. Local tensors are released
+ * with their pipeline, which is when the runtime frees them.
+ * <br/>
+ * An optional budget turns the ledger into a hard limit: creating a tensor that would exceed it throws before
+ * the runtime allocates anything.
+ */
+class TensorMemoryLedger {
+ public:
+  struct Usage {
+    size_t liveBytes = 0;
+    size_t peakBytes = 0;
+    size_t tensorCount = 0;
+  };
+
+  struct Allocation {
+    uint64_t token = 0;
+    /**
+     * Owning pipeline of a local tensor, <code>nullptr</code> for global tensors
+     */
+    const Pipeline* pipeline = nullptr;
+    size_t bytes = 0;
+    std::string description;
+  };
+
+  /**
+   * @param bytes Largest total of live bytes, 0 for no limit
+   */
+  void setBudget(size_t bytes);
+  [[nodiscard]] size_t budget() const;
+
+  /**
+   * Account a new tensor
+   * @return The token to release it with
+   * @throw std::logic_error if the budget would be exceeded
+   */
+  uint64_t allocate(const Pipeline* pipeline, size_t bytes, const std::string& description);
+  /**
+   * Release a tensor; releasing token 0 or a released token has no effect
+   */
+  void release(uint64_t token);
+  /**
+   * Release all local tensors of a pipeline and forget its counters
+   */
+  void releasePipeline(const Pipeline* pipeline);
+
+  [[nodiscard]] Usage total() const;
+  [[nodiscard]] Usage globalTensors() const;
+  [[nodiscard]] Usage pipelineTensors(const Pipeline* pipeline) const;
+
+  /**
+   * @return The <code>count</code> largest live tensors, largest first
+   */
+  [[nodiscard]] std::vector<Allocation> topConsumers(size_t count) const;
+
+  /**
+   * Multi-line summary: totals, per-pipeline usage and the <code>count</code> largest tensors
+   */
+  [[nodiscard]] std::string report(size_t count = 10) const;
+
+ private:
+  static void Add(Usage& usage, size_t bytes);
+
+  mutable std::mutex m_mutex;
+  size_t m_budget = 0;
+  uint64_t m_nextToken = 1;
+  std::unordered_map<uint64_t, Allocation> m_allocations;
+  Usage m_total;
+  Usage m_globals;
+  std::unordered_map<const Pipeline*, Usage> m_pipelines;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_TENSORMEMORY_H_
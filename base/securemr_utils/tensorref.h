@@ -0,0 +1,80 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_TENSORREF_H_
+#define SECUREMR_UTILS_TENSORREF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace SecureMR {
+
+/**
+ * A lightweight, trivially-copyable reference to a pipeline tensor held in the tensor arena of its pipeline, as
+ * created by <code>Pipeline::createTensors</code>. The tensor is owned by the pipeline and lives as long as it.
+ * <br/>
+ * A default-constructed reference refers to no tensor.
+ */
+struct TensorRef {
+  /**
+   * <code>Pipeline::id()</code> of the owning pipeline, 0 for no tensor
+   */
+  uint32_t pipelineId = 0;
+  /**
+   * Index of the tensor in the arena of the owning pipeline
+   */
+  uint32_t index = 0;
+
+  [[nodiscard]] bool valid() const { return pipelineId != 0; }
+
+  bool operator==(const TensorRef& other) const { return pipelineId == other.pipelineId && index == other.index; }
+  bool operator!=(const TensorRef& other) const { return !(*this == other); }
+};
+
+class PipelineTensor;
+
+/**
+ * A tensor operand of a <code>Pipeline</code> operator: either a <code>PipelineTensor</code> or a
+ * <code>TensorRef</code>, or nothing for optional operands. It is a plain value that converts implicitly from
+ * <code>std::shared_ptr<PipelineTensor></code>, <code>TensorRef</code> and <code>nullptr</code>, without touching
+ * any reference count.
+ * <br/>
+ * <b>NOTE</b> an operand does not keep the tensor alive. It is only meant to pass arguments to operators, which
+ * resolve it to the runtime handle immediately.
+ */
+class TensorOperand {
+ public:
+  TensorOperand() = default;
+  TensorOperand(std::nullptr_t) {}
+  TensorOperand(const std::shared_ptr<PipelineTensor>& tensor) : m_tensor(tensor.get()) {}
+  TensorOperand(const TensorRef ref) : m_ref(ref) {}
+
+  /**
+   * @return The wrapped tensor, or <code>nullptr</code> if the operand is a <code>TensorRef</code> or empty
+   */
+  [[nodiscard]] const PipelineTensor* tensor() const { return m_tensor; }
+  [[nodiscard]] TensorRef ref() const { return m_ref; }
+
+  bool operator==(std::nullptr_t) const { return m_tensor == nullptr && !m_ref.valid(); }
+  bool operator!=(std::nullptr_t) const { return !(*this == nullptr); }
+
+ private:
+  const PipelineTensor* m_tensor = nullptr;
+  TensorRef m_ref;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_TENSORREF_H_
@@ -0,0 +1,329 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_TENSORSPEC_H_
+#define SECUREMR_UTILS_TENSORSPEC_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+/**
+ * Compile-time dimensions of a tensor, such as <code>Dims<8400, 80></code>
+ */
+template <int... Ds>
+struct Dims {
+  static_assert(sizeof...(Ds) > 0, "A tensor must have at least one dimension");
+  static_assert(((Ds > 0) && ...), "Tensor dimensions must be positive");
+
+  static constexpr size_t rank = sizeof...(Ds);
+  static constexpr std::array<int, sizeof...(Ds)> values{Ds...};
+  static constexpr size_t elementCount = (size_t{1} * ... * static_cast<size_t>(Ds));
+
+  template <size_t I>
+  static constexpr int at() {
+    static_assert(I < rank, "Dimension index out of range");
+    return values[I];
+  }
+};
+
+/**
+ * The SecureMR data type of a C++ value type
+ */
+template <typename T>
+struct TensorDataTypeOf {
+  static_assert(!std::is_same_v<T, T>, "No SecureMR tensor data type for this value type");
+};
+template <>
+struct TensorDataTypeOf<uint8_t> : std::integral_constant<XrSecureMrTensorDataTypePICO,
+                                                          XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO> {};
+template <>
+struct TensorDataTypeOf<int8_t> : std::integral_constant<XrSecureMrTensorDataTypePICO,
+                                                         XR_SECURE_MR_TENSOR_DATA_TYPE_INT8_PICO> {};
+template <>
+struct TensorDataTypeOf<uint16_t> : std::integral_constant<XrSecureMrTensorDataTypePICO,
+                                                           XR_SECURE_MR_TENSOR_DATA_TYPE_UINT16_PICO> {};
+template <>
+struct TensorDataTypeOf<int16_t> : std::integral_constant<XrSecureMrTensorDataTypePICO,
+                                                          XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO> {};
+template <>
+struct TensorDataTypeOf<int32_t> : std::integral_constant<XrSecureMrTensorDataTypePICO,
+                                                          XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO> {};
+template <>
+struct TensorDataTypeOf<float> : std::integral_constant<XrSecureMrTensorDataTypePICO,
+                                                        XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO> {};
+template <>
+struct TensorDataTypeOf<double> : std::integral_constant<XrSecureMrTensorDataTypePICO,
+                                                         XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO> {};
+
+/**
+ * A compile-time tensor descriptor, the typed counterpart of <code>TensorAttribute</code>. For example,
+ * <code>TensorSpec<float, Dims<8400, 80>></code> describes the 8400x80 1-channel FLOAT32 matrix that
+ * <code>TensorAttribute{.dimensions = {8400, 80}}</code> describes at run time.
+ * <br/>
+ * The usage rules documented on <code>TensorAttribute::usage</code> are checked when the descriptor is instantiated,
+ * and the byte size is known at compile time. A descriptor converts to <code>TensorAttribute</code>, so it can be
+ * passed wherever an attribute is expected.
+ */
+template <typename T, typename D, int8_t Channels = 1,
+          XrSecureMrTensorTypePICO Usage = XR_SECURE_MR_TENSOR_TYPE_MAT_PICO>
+struct TensorSpec {
+  using value_type = T;
+  using dims = D;
+
+  static constexpr int8_t channels = Channels;
+  static constexpr XrSecureMrTensorTypePICO usage = Usage;
+  static constexpr XrSecureMrTensorDataTypePICO dataType = TensorDataTypeOf<T>::value;
+  static constexpr size_t elementCount = D::elementCount;
+  /**
+   * Number of values, i.e., elements x channels
+   */
+  static constexpr size_t valueCount = D::elementCount * static_cast<size_t>(Channels);
+  static constexpr size_t byteSize = valueCount * sizeof(T);
+
+  static_assert(Channels > 0, "A tensor must have at least one channel");
+  static_assert(Usage != XR_SECURE_MR_TENSOR_TYPE_MAT_PICO || D::rank >= 2,
+                "MAT tensors require at least 2 dimensions; use (N, 1) or (1, N) for vectors");
+  static_assert(Usage != XR_SECURE_MR_TENSOR_TYPE_SCALAR_PICO || (D::rank == 1 && Channels == 1),
+                "SCALAR tensors require 1 dimension and 1 channel");
+  static_assert(Usage != XR_SECURE_MR_TENSOR_TYPE_SLICE_PICO || (D::rank == 1 && (Channels == 2 || Channels == 3)),
+                "SLICE tensors require 1 dimension and 2 or 3 channels");
+  static_assert(Usage != XR_SECURE_MR_TENSOR_TYPE_TIMESTAMP_PICO ||
+                    (D::rank == 1 && D::elementCount == 1 && Channels == 4 && std::is_same_v<T, int32_t>),
+                "TIMESTAMP tensors require dimensions {1} and 4 INT32 channels");
+  static_assert(Usage != XR_SECURE_MR_TENSOR_TYPE_COLOR_PICO || (D::rank == 1 && (Channels == 3 || Channels == 4)),
+                "COLOR tensors require 1 dimension and 3 or 4 channels");
+  static_assert(Usage != XR_SECURE_MR_TENSOR_TYPE_POINT_PICO || (D::rank == 1 && (Channels == 2 || Channels == 3)),
+                "POINT tensors require 1 dimension and 2 or 3 channels");
+
+  static TensorAttribute attribute() {
+    return {.dimensions = {D::values.begin(), D::values.end()},
+            .channels = Channels,
+            .usage = Usage,
+            .dataType = dataType};
+  }
+
+  operator TensorAttribute() const { return attribute(); }
+};
+
+template <typename T, int... Ds>
+using MatSpec = TensorSpec<T, Dims<Ds...>>;
+template <typename T, size_t N>
+using ScalarArraySpec = TensorSpec<T, Dims<static_cast<int>(N)>, 1, XR_SECURE_MR_TENSOR_TYPE_SCALAR_PICO>;
+template <typename T, size_t N>
+using Point2ArraySpec = TensorSpec<T, Dims<static_cast<int>(N)>, 2, XR_SECURE_MR_TENSOR_TYPE_POINT_PICO>;
+template <typename T, size_t N>
+using Point3ArraySpec = TensorSpec<T, Dims<static_cast<int>(N)>, 3, XR_SECURE_MR_TENSOR_TYPE_POINT_PICO>;
+template <size_t N>
+using RGBArraySpec = TensorSpec<uint8_t, Dims<static_cast<int>(N)>, 3, XR_SECURE_MR_TENSOR_TYPE_COLOR_PICO>;
+template <size_t N>
+using RGBAArraySpec = TensorSpec<uint8_t, Dims<static_cast<int>(N)>, 4, XR_SECURE_MR_TENSOR_TYPE_COLOR_PICO>;
+using TimestampSpec = TensorSpec<int32_t, Dims<1>, 4, XR_SECURE_MR_TENSOR_TYPE_TIMESTAMP_PICO>;
+
+template <typename DA, typename DB>
+constexpr bool SameDims() {
+  if constexpr (DA::rank != DB::rank) {
+    return false;
+  } else {
+    for (size_t i = 0; i < DA::rank; ++i) {
+      if (DA::values[i] != DB::values[i]) return false;
+    }
+    return true;
+  }
+}
+
+/**
+ * Whether two descriptors have the same dimensions and channels, regardless of value type and usage
+ */
+template <typename A, typename B>
+inline constexpr bool SameShape = SameDims<typename A::dims, typename B::dims>() && A::channels == B::channels;
+
+/**
+ * Whether a descriptor holds exactly one 1-channel value, as required by reductions such as <code>all</code>,
+ * <code>any</code> and <code>norm</code>
+ */
+template <typename S>
+inline constexpr bool SingleValue = S::valueCount == 1;
+
+/**
+ * Whether a descriptor is a (3, 1) or (1, 3) 1-channel floating-point MAT, such as a rotation or translation vector
+ */
+template <typename S>
+inline constexpr bool FloatVector3 = S::usage == XR_SECURE_MR_TENSOR_TYPE_MAT_PICO && S::channels == 1 &&
+                                     S::dims::rank == 2 && S::elementCount == 3 &&
+                                     std::is_floating_point_v<typename S::value_type>;
+
+/**
+ * A global tensor whose attribute is fixed by a <code>TensorSpec</code>.
+ */
+template <typename Spec>
+class TypedGlobalTensor {
+ public:
+  using spec = Spec;
+
+  explicit TypedGlobalTensor(const std::shared_ptr<FrameworkSession>& session)
+      : m_tensor(std::make_shared<GlobalTensor>(session, Spec::attribute())) {}
+
+  /**
+   * Write values, checking at compile time that <code>N</code> values can fill the tensor
+   */
+  template <size_t N>
+  void setData(const std::array<typename Spec::value_type, N>& values) const {
+    static_assert(N > 0 && N <= Spec::valueCount && Spec::valueCount % N == 0,
+                  "The number of values must divide the number of values of the tensor");
+    m_tensor->setData(reinterpret_cast<int8_t*>(const_cast<typename Spec::value_type*>(values.data())),
+                      N * sizeof(typename Spec::value_type));
+  }
+
+  [[nodiscard]] const std::shared_ptr<GlobalTensor>& get() const { return m_tensor; }
+  operator std::shared_ptr<GlobalTensor>() const { return m_tensor; }
+
+ private:
+  std::shared_ptr<GlobalTensor> m_tensor;
+};
+
+/**
+ * A pipeline tensor or placeholder whose attribute is fixed by a <code>TensorSpec</code>. The typed overloads of
+ * <code>Pipeline</code> methods check the shapes of typed operands at compile time; a typed tensor also converts to
+ * <code>std::shared_ptr<PipelineTensor></code> for all other methods.
+ */
+template <typename Spec>
+class TypedPipelineTensor {
+ public:
+  using spec = Spec;
+
+  explicit TypedPipelineTensor(const std::shared_ptr<Pipeline>& pipeline, const bool isPlaceholder = false)
+      : m_tensor(std::make_shared<PipelineTensor>(pipeline, Spec::attribute(), isPlaceholder)) {}
+
+  /**
+   * Create a placeholder for global tensors of the same descriptor
+   */
+  static TypedPipelineTensor Placeholder(const std::shared_ptr<Pipeline>& pipeline) {
+    return TypedPipelineTensor(pipeline, true);
+  }
+
+  /**
+   * Write values, checking at compile time that <code>N</code> values can fill the tensor
+   */
+  template <size_t N>
+  void setData(const std::array<typename Spec::value_type, N>& values) const {
+    static_assert(N > 0 && N <= Spec::valueCount && Spec::valueCount % N == 0,
+                  "The number of values must divide the number of values of the tensor");
+    m_tensor->setData(reinterpret_cast<int8_t*>(const_cast<typename Spec::value_type*>(values.data())),
+                      N * sizeof(typename Spec::value_type));
+  }
+
+  [[nodiscard]] const std::shared_ptr<PipelineTensor>& get() const { return m_tensor; }
+  operator std::shared_ptr<PipelineTensor>() const { return m_tensor; }
+  operator TensorOperand() const { return m_tensor; }
+
+ private:
+  std::shared_ptr<PipelineTensor> m_tensor;
+};
+
+// ------------------------------ Typed overloads declared in Pipeline ------------------------------ //
+
+template <typename Src, typename Dst>
+Pipeline& Pipeline::typeConvert(const TypedPipelineTensor<Src>& src, const TypedPipelineTensor<Dst>& dst) {
+  static_assert(SameShape<Src, Dst>, "typeConvert: dst must have the dimensions and channels of src");
+  return typeConvert(src.get(), dst.get());
+}
+
+template <typename Src, typename Dst>
+Pipeline& Pipeline::assignment(const TypedPipelineTensor<Src>& src, const TypedPipelineTensor<Dst>& dst) {
+  static_assert(SameShape<Src, Dst>, "assignment: dst must have the dimensions and channels of src");
+  return assignment(src.get(), dst.get());
+}
+
+template <typename A, typename B, typename R>
+Pipeline& Pipeline::elementwise(const ElementwiseOp operation, const TypedPipelineTensor<A>& op0,
+                                const TypedPipelineTensor<B>& op1, const TypedPipelineTensor<R>& result) {
+  static_assert(SameShape<A, B>, "elementwise: operands must have the same dimensions and channels");
+  static_assert(SameShape<A, R>, "elementwise: result must have the dimensions and channels of the operands");
+  return elementwise(operation, {op0.get(), op1.get()}, result.get());
+}
+
+template <typename S, typename R>
+Pipeline& Pipeline::all(const TypedPipelineTensor<S>& op, const TypedPipelineTensor<R>& result) {
+  static_assert(SingleValue<R> && R::usage == XR_SECURE_MR_TENSOR_TYPE_SCALAR_PICO &&
+                    std::is_integral_v<typename R::value_type>,
+                "all: result must be a single 1-channel integral SCALAR");
+  return all(op.get(), result.get());
+}
+
+template <typename S, typename R>
+Pipeline& Pipeline::any(const TypedPipelineTensor<S>& op, const TypedPipelineTensor<R>& result) {
+  static_assert(SingleValue<R> && R::usage == XR_SECURE_MR_TENSOR_TYPE_SCALAR_PICO &&
+                    std::is_integral_v<typename R::value_type>,
+                "any: result must be a single 1-channel integral SCALAR");
+  return any(op.get(), result.get());
+}
+
+template <typename S, typename R>
+Pipeline& Pipeline::norm(const TypedPipelineTensor<S>& src, const TypedPipelineTensor<R>& result_norm) {
+  static_assert(SingleValue<R>, "norm: result must hold a single 1-channel value");
+  return norm(src.get(), result_norm.get());
+}
+
+template <typename Src, typename Dst>
+Pipeline& Pipeline::convertHWC_CHW(const TypedPipelineTensor<Src>& src, const TypedPipelineTensor<Dst>& result) {
+  static_assert(Src::usage == XR_SECURE_MR_TENSOR_TYPE_MAT_PICO && Dst::usage == XR_SECURE_MR_TENSOR_TYPE_MAT_PICO,
+                "convertHWC_CHW: src and result must be MAT tensors");
+  if constexpr (Src::dims::rank == 2) {
+    static_assert(Dst::dims::rank == 3 && Dst::channels == 1 && Dst::dims::template at<0>() == Src::channels &&
+                      Dst::dims::template at<1>() == Src::dims::template at<0>() &&
+                      Dst::dims::template at<2>() == Src::dims::template at<1>(),
+                  "convertHWC_CHW: an (H, W) x C src requires a (C, H, W) x 1 result");
+  } else {
+    static_assert(Src::dims::rank == 3 && Src::channels == 1, "convertHWC_CHW: src must be (H, W) x C or (C, H, W)");
+    static_assert(Dst::dims::rank == 2 && Dst::channels == Src::dims::template at<0>() &&
+                      Dst::dims::template at<0>() == Src::dims::template at<1>() &&
+                      Dst::dims::template at<1>() == Src::dims::template at<2>(),
+                  "convertHWC_CHW: a (C, H, W) x 1 src requires an (H, W) x C result");
+  }
+  return convertHWC_CHW(src.get(), result.get());
+}
+
+template <typename Src, typename Dst>
+Pipeline& Pipeline::inversion(const TypedPipelineTensor<Src>& srcMat,
+                              const TypedPipelineTensor<Dst>& result_inverted) {
+  static_assert(Src::usage == XR_SECURE_MR_TENSOR_TYPE_MAT_PICO && Src::dims::rank == 2 && Src::channels == 1 &&
+                    Src::dims::template at<0>() == Src::dims::template at<1>(),
+                "inversion: srcMat must be a 2D 1-channel square MAT");
+  static_assert(std::is_same_v<Src, Dst>, "inversion: result_inverted must have the attribute of srcMat");
+  return inversion(srcMat.get(), result_inverted.get());
+}
+
+template <typename Rot, typename Trans, typename Scale, typename R>
+Pipeline& Pipeline::transform(const TypedPipelineTensor<Rot>& rotation, const TypedPipelineTensor<Trans>& translation,
+                              const TypedPipelineTensor<Scale>& scale, const TypedPipelineTensor<R>& result) {
+  static_assert(FloatVector3<Rot> && FloatVector3<Trans> && FloatVector3<Scale>,
+                "transform: rotation, translation and scale must be (3, 1) or (1, 3) 1-channel floating-point MATs");
+  static_assert(R::usage == XR_SECURE_MR_TENSOR_TYPE_MAT_PICO && R::channels == 1 &&
+                    SameDims<typename R::dims, Dims<4, 4>>() && std::is_floating_point_v<typename R::value_type>,
+                "transform: result must be a (4, 4) 1-channel floating-point MAT");
+  return transform(rotation.get(), translation.get(), scale.get(), result.get());
+}
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_TENSORSPEC_H_
@@ -0,0 +1,369 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "trace.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "pipeline.h"
+#include "tensor.h"
+
+namespace SecureMR {
+
+namespace {
+
+// File layout: {char[8] magic, uint64 length of the complete events}, then events of
+// {uint32 type, uint32 payloadSize, int64 nanoseconds since the start of the capture, payload}
+constexpr char TRACE_MAGIC[8] = {'S', 'M', 'R', 'T', 'R', 'C', '0', '1'};
+constexpr size_t TRACE_HEADER_SIZE = 16;
+constexpr size_t EVENT_HEADER_SIZE = 16;
+constexpr size_t INITIAL_CAPACITY = 1 << 20;
+constexpr size_t RECENT_RUNS = 256;
+
+// Payloads:
+//   LABEL:        uint8 kind, uint32 id, name
+//   TENSOR_WRITE: uint32 tensorId, bytes
+//   SUBMIT:       uint32 pipelineId, uint32 runIndex, uint32 waitForRunIndex, uint32 conditionTensorId,
+//                 int64 submitDurationNs, uint32 pairCount, pairCount x {uint32 placeholderId, uint32 tensorId}
+// Ids and run indices start at 1; 0 stands for none.
+constexpr uint32_t EVENT_LABEL = 1;
+constexpr uint32_t EVENT_TENSOR_WRITE = 2;
+constexpr uint32_t EVENT_SUBMIT = 3;
+
+constexpr const char* KIND_PREFIXES[3] = {"tensor#", "pipeline#", "placeholder#"};
+
+std::mutex activeMutex;
+std::shared_ptr<TraceRecorder> activeRecorder;
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t HandleValue(const XrSecureMrPipelineRunPICO run) { return reinterpret_cast<uint64_t>(run); }
+
+template <typename T>
+T ReadAt(const uint8_t* data, const size_t offset) {
+  T value;
+  std::memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* TraceRecorder                                                                                                    */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+TraceRecorder::TraceRecorder(const std::filesystem::path& path) : m_startNs(NowNs()) {
+  m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  CHECK_MSG(m_fd >= 0, Fmt("TraceRecorder: cannot create \"%s\"", path.c_str()))
+  reserve(INITIAL_CAPACITY);
+  std::memcpy(m_mapping, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  m_length = TRACE_HEADER_SIZE;
+  const uint64_t length = m_length;
+  std::memcpy(m_mapping + sizeof(TRACE_MAGIC), &length, sizeof(length));
+}
+
+TraceRecorder::~TraceRecorder() {
+  if (m_mapping != nullptr) munmap(m_mapping, m_capacity);
+  if (m_fd >= 0) {
+    // Drop the unused tail of the last growth step
+    if (ftruncate(m_fd, static_cast<off_t>(m_length)) != 0) {
+      Log::Write(Log::Level::Warning, "TraceRecorder: failed to trim the trace file");
+    }
+    close(m_fd);
+  }
+}
+
+std::shared_ptr<TraceRecorder> TraceRecorder::Start(const std::filesystem::path& path) {
+  auto recorder = std::make_shared<TraceRecorder>(path);
+  std::lock_guard<std::mutex> guard(activeMutex);
+  activeRecorder = recorder;
+  return recorder;
+}
+
+void TraceRecorder::Stop() {
+  std::lock_guard<std::mutex> guard(activeMutex);
+  activeRecorder.reset();
+}
+
+std::shared_ptr<TraceRecorder> TraceRecorder::Active() {
+  std::lock_guard<std::mutex> guard(activeMutex);
+  return activeRecorder;
+}
+
+void TraceRecorder::reserve(const size_t size) {
+  if (m_length + size <= m_capacity) return;
+  size_t capacity = std::max<size_t>(m_capacity, INITIAL_CAPACITY);
+  while (capacity < m_length + size) capacity *= 2;
+  if (m_mapping != nullptr) munmap(m_mapping, m_capacity);
+  m_mapping = nullptr;
+  CHECK_MSG(ftruncate(m_fd, static_cast<off_t>(capacity)) == 0, "TraceRecorder: cannot grow the trace file")
+  void* mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  CHECK_MSG(mapping != MAP_FAILED, "TraceRecorder: cannot map the trace file")
+  m_mapping = static_cast<uint8_t*>(mapping);
+  m_capacity = capacity;
+}
+
+void TraceRecorder::append(const uint32_t type, const std::vector<std::pair<const void*, size_t>>& parts) {
+  size_t payloadSize = 0;
+  for (const auto& part : parts) payloadSize += part.second;
+  CHECK_MSG(payloadSize <= UINT32_MAX, "TraceRecorder: event too large")
+  reserve(EVENT_HEADER_SIZE + payloadSize);
+
+  uint8_t* event = m_mapping + m_length;
+  const auto size = static_cast<uint32_t>(payloadSize);
+  const int64_t time = NowNs() - m_startNs;
+  std::memcpy(event, &type, sizeof(type));
+  std::memcpy(event + 4, &size, sizeof(size));
+  std::memcpy(event + 8, &time, sizeof(time));
+  size_t offset = EVENT_HEADER_SIZE;
+  for (const auto& [data, partSize] : parts) {
+    std::memcpy(event + offset, data, partSize);
+    offset += partSize;
+  }
+  // Publish the event only once it is complete
+  m_length += EVENT_HEADER_SIZE + payloadSize;
+  const uint64_t length = m_length;
+  std::memcpy(m_mapping + sizeof(TRACE_MAGIC), &length, sizeof(length));
+}
+
+uint32_t TraceRecorder::objectId(const ObjectKind kind, const void* object) {
+  auto& ids = m_ids[static_cast<size_t>(kind)];
+  const auto it = ids.find(object);
+  if (it != ids.end()) return it->second;
+  const uint32_t id = m_nextId[static_cast<size_t>(kind)]++;
+  ids.emplace(object, id);
+  const std::string name = KIND_PREFIXES[static_cast<size_t>(kind)] + std::to_string(id);
+  append(EVENT_LABEL, {{&kind, sizeof(kind)}, {&id, sizeof(id)}, {name.data(), name.size()}});
+  return id;
+}
+
+void TraceRecorder::setLabel(const ObjectKind kind, const void* object, const std::string& name) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto& ids = m_ids[static_cast<size_t>(kind)];
+  auto it = ids.find(object);
+  if (it == ids.end()) it = ids.emplace(object, m_nextId[static_cast<size_t>(kind)]++).first;
+  const uint32_t id = it->second;
+  append(EVENT_LABEL, {{&kind, sizeof(kind)}, {&id, sizeof(id)}, {name.data(), name.size()}});
+}
+
+void TraceRecorder::label(const GlobalTensor& tensor, const std::string& name) {
+  setLabel(ObjectKind::TENSOR, &tensor, name);
+}
+
+void TraceRecorder::label(const Pipeline& pipeline, const std::string& name) {
+  setLabel(ObjectKind::PIPELINE, &pipeline, name);
+}
+
+void TraceRecorder::label(const PipelineTensor& placeholder, const std::string& name) {
+  setLabel(ObjectKind::PLACEHOLDER, &placeholder, name);
+}
+
+void TraceRecorder::recordTensorWrite(const GlobalTensor& tensor, const int8_t* data, const size_t size) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const uint32_t id = objectId(ObjectKind::TENSOR, &tensor);
+  append(EVENT_TENSOR_WRITE, {{&id, sizeof(id)}, {data, size}});
+}
+
+void TraceRecorder::recordSubmit(
+    const Pipeline& pipeline,
+    const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap,
+    const XrSecureMrPipelineRunPICO waitFor, const std::shared_ptr<GlobalTensor>& condition,
+    const XrSecureMrPipelineRunPICO run, const int64_t submitDurationNs) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const uint32_t pipelineId = objectId(ObjectKind::PIPELINE, &pipeline);
+  const uint32_t conditionId = condition != nullptr ? objectId(ObjectKind::TENSOR, condition.get()) : 0;
+  std::vector<uint32_t> pairs;
+  pairs.reserve(argumentMap.size() * 2);
+  for (const auto& [placeholder, tensor] : argumentMap) {
+    pairs.push_back(objectId(ObjectKind::PLACEHOLDER, placeholder.get()));
+    pairs.push_back(objectId(ObjectKind::TENSOR, tensor.get()));
+  }
+  // The newest run of a reused handle is the one the application can still hold
+  const auto waited = std::find_if(m_recentRuns.rbegin(), m_recentRuns.rend(),
+                                   [&waitFor](const auto& recent) { return recent.first == HandleValue(waitFor); });
+  const uint32_t waitForIndex = waitFor != XR_NULL_HANDLE && waited != m_recentRuns.rend() ? waited->second : 0;
+  const uint32_t runIndex = m_nextRunIndex++;
+  m_recentRuns.emplace_back(HandleValue(run), runIndex);
+  if (m_recentRuns.size() > RECENT_RUNS) m_recentRuns.pop_front();
+  const auto pairCount = static_cast<uint32_t>(argumentMap.size());
+
+  append(EVENT_SUBMIT, {{&pipelineId, sizeof(pipelineId)},
+                        {&runIndex, sizeof(runIndex)},
+                        {&waitForIndex, sizeof(waitForIndex)},
+                        {&conditionId, sizeof(conditionId)},
+                        {&submitDurationNs, sizeof(submitDurationNs)},
+                        {&pairCount, sizeof(pairCount)},
+                        {pairs.data(), pairs.size() * sizeof(uint32_t)}});
+}
+
+size_t TraceRecorder::bytesWritten() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_length;
+}
+
+/* ---------------------------------------------------------------------------------------------------------------- */
+/* TraceReplayer                                                                                                    */
+/* ---------------------------------------------------------------------------------------------------------------- */
+
+TraceReplayer::TraceReplayer(const std::filesystem::path& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  CHECK_MSG(fd >= 0, Fmt("TraceReplayer: cannot open \"%s\"", path.c_str()))
+  struct stat status {};
+  if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < TRACE_HEADER_SIZE) {
+    close(fd);
+    THROW(Fmt("TraceReplayer: \"%s\" is not a trace", path.c_str()))
+  }
+  m_mappingSize = static_cast<size_t>(status.st_size);
+  // Private and writable, so that recorded buffers can be passed on as the non-const data of setData
+  void* mapping = mmap(nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  CHECK_MSG(mapping != MAP_FAILED, Fmt("TraceReplayer: cannot map \"%s\"", path.c_str()))
+  m_mapping = static_cast<uint8_t*>(mapping);
+  m_length = ReadAt<uint64_t>(m_mapping, sizeof(TRACE_MAGIC));
+  const auto reject = [this, &path](const char* reason) {
+    munmap(m_mapping, m_mappingSize);
+    m_mapping = nullptr;
+    THROW(Fmt("TraceReplayer: \"%s\" %s", path.c_str(), reason))
+  };
+  if (std::memcmp(m_mapping, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 || m_length < TRACE_HEADER_SIZE ||
+      m_length > m_mappingSize) {
+    reject("is not a trace or is truncated");
+  }
+
+  // Validate every event against the mapped length once, so that replay reads within the events only
+  size_t offset = TRACE_HEADER_SIZE;
+  while (offset < m_length) {
+    if (m_length - offset < EVENT_HEADER_SIZE) reject("ends with a truncated event header");
+    const auto type = ReadAt<uint32_t>(m_mapping, offset);
+    const uint64_t size = ReadAt<uint32_t>(m_mapping, offset + 4);
+    if (size > m_length - offset - EVENT_HEADER_SIZE) reject("has an event beyond its length");
+    const uint8_t* payload = m_mapping + offset + EVENT_HEADER_SIZE;
+    if (type == EVENT_LABEL) {
+      if (size < 5 || payload[0] >= 3) reject("has a corrupted label event");
+      const auto id = ReadAt<uint32_t>(payload, 1);
+      m_labels[payload[0]][id] = std::string(reinterpret_cast<const char*>(payload) + 5, size - 5);
+    } else if (type == EVENT_TENSOR_WRITE) {
+      if (size < 4) reject("has a corrupted tensor write event");
+    } else if (type == EVENT_SUBMIT) {
+      if (size < 28 || size < 28 + 8 * static_cast<uint64_t>(ReadAt<uint32_t>(payload, 24))) {
+        reject("has a corrupted submit event");
+      }
+    }
+    offset += EVENT_HEADER_SIZE + size;
+  }
+}
+
+TraceReplayer::~TraceReplayer() {
+  if (m_mapping != nullptr) munmap(m_mapping, m_mappingSize);
+}
+
+void TraceReplayer::bindTensor(const std::string& label, const std::shared_ptr<GlobalTensor>& tensor) {
+  m_tensors[label] = tensor;
+}
+
+void TraceReplayer::bindPipeline(const std::string& label, const std::shared_ptr<Pipeline>& pipeline) {
+  m_pipelines[label] = pipeline;
+}
+
+void TraceReplayer::bindPlaceholder(const std::string& label, const std::shared_ptr<PipelineTensor>& placeholder) {
+  m_placeholders[label] = placeholder;
+}
+
+std::vector<std::string> TraceReplayer::labels() const {
+  std::vector<std::string> result;
+  for (const auto& labels : m_labels) {
+    for (const auto& [id, label] : labels) result.push_back(label);
+  }
+  return result;
+}
+
+TraceReplayer::Stats TraceReplayer::replay(const Pacing pacing) {
+  const auto find = [](const auto& bound, const auto& labels, const uint32_t id) {
+    using Object = typename std::decay_t<decltype(bound)>::mapped_type;
+    const auto label = labels.find(id);
+    if (label == labels.end()) return Object{};
+    const auto object = bound.find(label->second);
+    return object != bound.end() ? object->second : Object{};
+  };
+  const auto& tensorLabels = m_labels[0];
+  const auto& pipelineLabels = m_labels[1];
+  const auto& placeholderLabels = m_labels[2];
+
+  Stats stats;
+  std::unordered_map<uint32_t, XrSecureMrPipelineRunPICO> runs;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t offset = TRACE_HEADER_SIZE; offset + EVENT_HEADER_SIZE <= m_length;) {
+    const auto type = ReadAt<uint32_t>(m_mapping, offset);
+    const auto size = ReadAt<uint32_t>(m_mapping, offset + 4);
+    const auto time = ReadAt<int64_t>(m_mapping, offset + 8);
+    uint8_t* payload = m_mapping + offset + EVENT_HEADER_SIZE;
+    offset += EVENT_HEADER_SIZE + size;
+    if (type == EVENT_LABEL) continue;
+
+    stats.recordedSeconds = static_cast<double>(time) * 1e-9;
+    if (pacing == Pacing::RECORDED) std::this_thread::sleep_until(start + std::chrono::nanoseconds(time));
+
+    if (type == EVENT_TENSOR_WRITE) {
+      const auto tensor = find(m_tensors, tensorLabels, ReadAt<uint32_t>(payload, 0));
+      if (tensor == nullptr) {
+        ++stats.skipped;
+        continue;
+      }
+      tensor->setData(reinterpret_cast<int8_t*>(payload + 4), size - 4);
+      ++stats.tensorWrites;
+    } else if (type == EVENT_SUBMIT) {
+      const auto pipeline = find(m_pipelines, pipelineLabels, ReadAt<uint32_t>(payload, 0));
+      const auto runIndex = ReadAt<uint32_t>(payload, 4);
+      const auto waitForIndex = ReadAt<uint32_t>(payload, 8);
+      const auto conditionId = ReadAt<uint32_t>(payload, 12);
+      const auto pairCount = ReadAt<uint32_t>(payload, 24);
+      std::shared_ptr<GlobalTensor> condition;
+      bool complete = pipeline != nullptr;
+      if (conditionId != 0) {
+        condition = find(m_tensors, tensorLabels, conditionId);
+        complete = complete && condition != nullptr;
+      }
+      std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>> argumentMap;
+      for (uint32_t i = 0; i < pairCount && complete; ++i) {
+        auto placeholder = find(m_placeholders, placeholderLabels, ReadAt<uint32_t>(payload, 28 + 8 * i));
+        auto tensor = find(m_tensors, tensorLabels, ReadAt<uint32_t>(payload, 32 + 8 * i));
+        complete = placeholder != nullptr && tensor != nullptr;
+        argumentMap.emplace(std::move(placeholder), std::move(tensor));
+      }
+      if (!complete) {
+        ++stats.skipped;
+        continue;
+      }
+      const auto waited = runs.find(waitForIndex);
+      runs[runIndex] = pipeline->submit(argumentMap, waited != runs.end() ? waited->second : XR_NULL_HANDLE,
+                                        condition);
+      ++stats.submits;
+    }
+  }
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
+
+}  // namespace SecureMR
@@ -0,0 +1,164 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_UTILS_TRACE_H_
+#define SECUREMR_UTILS_TRACE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "openxr/openxr.h"
+
+namespace SecureMR {
+
+class GlobalTensor;
+class Pipeline;
+class PipelineTensor;
+
+/**
+ * Captures the global tensor traffic of a session into an append-only trace file, for reproducible offline
+ * benchmarks with <code>TraceReplayer</code>.
+ * <br/>
+ * While a recorder is active (see <code>Start</code>), every <code>GlobalTensor::setData</code> records the bytes
+ * written, and every <code>Pipeline::submit</code> records its placeholder bindings, wait-for dependency, condition
+ * and the time spent submitting, all with timestamps. The SecureMR runtime offers no read-back of global tensors, so
+ * contents produced <i>by</i> pipelines cannot be captured; replaying the writes of the application re-creates them.
+ * <br/>
+ * Pipelines, global tensors and placeholders are identified by labels, by default <code>"pipeline#N"</code>,
+ * <code>"tensor#N"</code> and <code>"placeholder#N"</code> in the order they are first seen. Call
+ * <code>label</code> beforehand to give them names that survive changes in construction order.
+ * <br/>
+ * The file is grown and written through a memory mapping; its header always holds the length of the complete
+ * events, so a trace cut short by a crash remains readable.
+ */
+class TraceRecorder {
+ public:
+  explicit TraceRecorder(const std::filesystem::path& path);
+  ~TraceRecorder();
+
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+  /**
+   * Start capturing into a new trace file, replacing the active recorder if any
+   */
+  static std::shared_ptr<TraceRecorder> Start(const std::filesystem::path& path);
+  /**
+   * Stop capturing. The trace file is finalized once the last reference to the recorder is dropped.
+   */
+  static void Stop();
+  /**
+   * @return The active recorder, or <code>nullptr</code> if capture is off
+   */
+  static std::shared_ptr<TraceRecorder> Active();
+
+  void label(const GlobalTensor& tensor, const std::string& name);
+  void label(const Pipeline& pipeline, const std::string& name);
+  void label(const PipelineTensor& placeholder, const std::string& name);
+
+  void recordTensorWrite(const GlobalTensor& tensor, const int8_t* data, size_t size);
+  void recordSubmit(const Pipeline& pipeline,
+                    const std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>& argumentMap,
+                    XrSecureMrPipelineRunPICO waitFor, const std::shared_ptr<GlobalTensor>& condition,
+                    XrSecureMrPipelineRunPICO run, int64_t submitDurationNs);
+
+  [[nodiscard]] size_t bytesWritten() const;
+
+ private:
+  enum class ObjectKind : uint8_t { TENSOR = 0, PIPELINE = 1, PLACEHOLDER = 2 };
+
+  uint32_t objectId(ObjectKind kind, const void* object);
+  void setLabel(ObjectKind kind, const void* object, const std::string& name);
+  /**
+   * Append one event whose payload is the concatenation of <code>parts</code>. Must be called with
+   * <code>m_mutex</code> held.
+   */
+  void append(uint32_t type, const std::vector<std::pair<const void*, size_t>>& parts);
+  void reserve(size_t size);
+
+  mutable std::mutex m_mutex;
+  int m_fd = -1;
+  uint8_t* m_mapping = nullptr;
+  size_t m_capacity = 0;
+  size_t m_length = 0;
+  int64_t m_startNs = 0;
+  std::unordered_map<const void*, uint32_t> m_ids[3];
+  uint32_t m_nextId[3] = {1, 1, 1};
+  /**
+   * Handle and index of the latest runs, newest last, to resolve the run a submission waits for. Bounded, as the
+   * runtime reuses the handles of finished runs and a run is waited for shortly after it is submitted.
+   */
+  std::deque<std::pair<uint64_t, uint32_t>> m_recentRuns;
+  uint32_t m_nextRunIndex = 1;
+};
+
+/**
+ * Re-feeds a trace recorded by <code>TraceRecorder</code> into the pipelines of a new session.
+ * <br/>
+ * Bind the labels of the trace to the objects of the session, then call <code>replay</code>: tensor writes are
+ * re-issued and pipelines re-submitted in the recorded order, either at the recorded pace or as fast as possible.
+ * Events referring to unbound labels are skipped and counted.
+ */
+class TraceReplayer {
+ public:
+  explicit TraceReplayer(const std::filesystem::path& path);
+  ~TraceReplayer();
+
+  TraceReplayer(const TraceReplayer&) = delete;
+  TraceReplayer& operator=(const TraceReplayer&) = delete;
+
+  void bindTensor(const std::string& label, const std::shared_ptr<GlobalTensor>& tensor);
+  void bindPipeline(const std::string& label, const std::shared_ptr<Pipeline>& pipeline);
+  void bindPlaceholder(const std::string& label, const std::shared_ptr<PipelineTensor>& placeholder);
+
+  /**
+   * Labels found in the trace, to check the bindings against
+   */
+  [[nodiscard]] std::vector<std::string> labels() const;
+
+  enum class Pacing { RECORDED, MAXIMUM };
+
+  struct Stats {
+    size_t tensorWrites = 0;
+    size_t submits = 0;
+    size_t skipped = 0;
+    double seconds = 0.0;
+    double recordedSeconds = 0.0;
+    [[nodiscard]] double submitsPerSecond() const { return seconds > 0.0 ? submits / seconds : 0.0; }
+  };
+
+  Stats replay(Pacing pacing = Pacing::MAXIMUM);
+
+ private:
+  uint8_t* m_mapping = nullptr;
+  size_t m_mappingSize = 0;
+  size_t m_length = 0;
+  std::unordered_map<uint32_t, std::string> m_labels[3];
+  std::unordered_map<std::string, std::shared_ptr<GlobalTensor>> m_tensors;
+  std::unordered_map<std::string, std::shared_ptr<Pipeline>> m_pipelines;
+  std::unordered_map<std::string, std::shared_ptr<PipelineTensor>> m_placeholders;
+};
+
+}  // namespace SecureMR
+
+#endif  // SECUREMR_UTILS_TRACE_H_
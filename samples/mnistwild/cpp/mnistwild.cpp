@@ -426,12 +426,16 @@ void MnistWildApp::CreateInferencePipeline() {
     runAlg["model_name"] = "mnist";
     runAlg["model_asset"] = "mnist.serialized.bin";
     runAlg["inputs"] = MappedTensorListToJson({{"input_1", kTensorNormalized}});
+    runAlg["input_encodings"] = {{"input_1", {{"layout", "hwc"}}}};
     runAlg["outputs"] =
         MappedTensorListToJson({{"_538", kTensorPredictedScore}, {"_539", kTensorPredictedClass}});
     operators.push_back(runAlg);
   }
 
   spec["operators"] = operators;
+  // Drop the transposes the declared model layouts make redundant, and log what is left, before the pipeline is
+  // rebuilt from the spec
+  ReconcileModelLayouts(spec);
 
   const std::filesystem::path jsonPath = ResolveWritablePath(kInferencePipelineJson);
   if (WriteJsonToFile(jsonPath, spec)) {
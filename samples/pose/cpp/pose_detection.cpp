@@ -14,6 +14,7 @@
 
 #include "pose_detection.h"
 
+#include <iterator>
 #include <sstream>
 
 extern AAssetManager* g_assetManager;
@@ -59,6 +60,21 @@ PoseDetector::~PoseDetector() {
 void PoseDetector::CreateFramework() {
   Log::Write(Log::Level::Info, "CreateFramework ...");
   frameworkSession = std::make_shared<FrameworkSession>(xr_instance, xr_session, 512, 512);
+  // Pre-create the pipeline rendering the glTF at a pose, off the pipeline initialization
+  m_pipelinePool = std::make_unique<PipelinePool>(frameworkSession);
+  m_placeGltfTemplate = m_pipelinePool->registerTemplate(
+      "place glTF",
+      [](const std::shared_ptr<Pipeline>& pipeline) {
+        const auto pose = std::make_shared<PipelineTensor>(
+            pipeline, TensorAttribute{.dimensions = {4, 4},
+                                      .channels = 1,
+                                      .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO});
+        const auto gltfPlaceholder = PipelineTensor::PipelineGLTFPlaceholder(pipeline);
+        pipeline->execRenderCommand(std::make_shared<RenderCommand_Render>(gltfPlaceholder, pose, true));
+        return std::unordered_map<std::string, std::shared_ptr<PipelineTensor>>{{"pose", pose},
+                                                                                {"gltf", gltfPlaceholder}};
+      },
+      1);
   Log::Write(Log::Level::Info, "CreateFramework done.");
 }
 
@@ -70,6 +86,7 @@ void PoseDetector::CreatePipelines() {
     CreateSecureMrVSTImagePipeline();
     CreateSecureMrModelInferencePipeline();
     CreateSecureMrRenderingPipeline();
+    CreateSecureMrMovePipeline();
 
     initialized.notify_all();
     pipelineAllInitialized = true;
@@ -81,7 +98,7 @@ void PoseDetector::UpdateHandPose(const XrVector3f* const leftHandDelta, const X
   if (hand == nullptr) hand = rightHandDelta;
   if (hand == nullptr) return;
 
-  CreateAndRunSecureMrMovePipeline(hand->x, hand->y, hand->z);
+  RunSecureMrMovePipeline(hand->x, hand->y, hand->z);
 }
 
 void PoseDetector::CreateGlobalTensor() {
@@ -109,15 +126,10 @@ void PoseDetector::CreateGlobalTensor() {
   std::vector<char> gltfData;
   if (LoadModelData(GLTF_PATH, gltfData)) {
     poseMarkerGltf = std::make_shared<GlobalTensor>(frameworkSession, gltfData.data(), gltfData.size());
-    const auto initPipeline = std::make_shared<Pipeline>(frameworkSession);
-    const auto initPose = std::make_shared<PipelineTensor>(
-        initPipeline,
-        TensorAttribute{.dimensions = {4, 4}, .channels = 1, .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO},
-        reinterpret_cast<int8_t*>(stagePoseData), sizeof(stagePoseData));
-    const auto transitPlaceholder = PipelineTensor::PipelineGLTFPlaceholder(initPipeline);
-    initPipeline->execRenderCommand(std::make_shared<RenderCommand_Render>(transitPlaceholder, initPose, true));
-    initPipeline->submit({{transitPlaceholder, poseMarkerGltf}}, XR_NULL_HANDLE, nullptr);
-
+    auto placeGltf = m_pipelinePool->acquire(m_placeGltfTemplate);
+    placeGltf.setData("pose", stagePoseData, std::size(stagePoseData));
+    placeGltf.submit({{placeGltf.tensor("gltf"), poseMarkerGltf}});
+    Log::Write(Log::Level::Info, m_pipelinePool->report());
   } else {
     Log::Write(Log::Level::Error, "Failed to load glTF data from file.");
   }
@@ -347,6 +359,22 @@ void PoseDetector::CreateSecureMrModelInferencePipeline() {
           .transform(rvecTensor, landmarkTVecLast[idx], nullptr, landmarkMat)
           .assignment(landmarkMat, (*bodyLandmarkPlaceholder)[{{idx, idx + 1}, {0, 4}, {0, 4}}]);
     }
+
+    // Step 4: register the placeholder roles, from which the graph waits the affine update for the detection,
+    // and the landmark for the affine update
+    m_modelInferenceGraph
+        .add(m_secureMrDetectionPipeline,
+             {{smallF32ImagePlaceholder, resizedLeftFp32Global, TensorRole::READ},
+              {isPoseDetectedPlaceholder, isPoseDetectedGlobal, TensorRole::WRITE},
+              {roiAffinePh1, roiAffineGlobal, TensorRole::WRITE}})
+        .add(m_secureMrAffineUpdatePipeline,
+             {{roiAffinePh2, roiAffineGlobal, TensorRole::READ},
+              {roiAffinePh3, roiAffineUpdatedGlobal, TensorRole::WRITE}},
+             isPoseDetectedGlobal)
+        .add(m_secureMrLandmarkPipeline, {{largeU8ImagePlaceholder, vstOutputLeftUint8Global, TensorRole::READ},
+                                          {bodyLandmarkPlaceholder, bodyLandmarkGlobal, TensorRole::WRITE},
+                                          {roiAffinePh4, roiAffineUpdatedGlobal, TensorRole::READ}});
+    Log::Write(Log::Level::Info, "Secure MR: model inference graph\n" + m_modelInferenceGraph.describe());
   } else {
     Log::Write(Log::Level::Error, "Failed to load model data from file.");
   }
@@ -365,6 +393,15 @@ void PoseDetector::CreateSecureMrRenderingPipeline() {
   m_secureMrRenderingPipeline->execRenderCommand(std::make_shared<RenderCommand_UpdateNodesLocalPoses>(
       gltfPlaceholderTensor, std::vector<uint16_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12},
       bodyLandmarkPlaceholder2));
+
+  // Step 3: no node update without a detected pose, nor between two updates of the landmarks
+  m_gatedRenderingPipeline = std::make_unique<GatedPipeline>(
+      m_secureMrRenderingPipeline,
+      std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>{
+          {gltfPlaceholderTensor, poseMarkerGltf},
+          {isPoseDetectedPlaceholder2, isPoseDetectedGlobal},
+          {bodyLandmarkPlaceholder2, bodyLandmarkGlobal}},
+      isPoseDetectedGlobal, "rendering", GatedPipelineOptions{.reportEvery = 500});
 }
 
 XrSecureMrPipelineRunPICO PoseDetector::RunSecureMrVSTImagePipeline(const XrSecureMrPipelineRunPICO pre) {
@@ -374,47 +411,57 @@ XrSecureMrPipelineRunPICO PoseDetector::RunSecureMrVSTImagePipeline(const XrSecu
 }
 
 XrSecureMrPipelineRunPICO PoseDetector::RunSecureMrModelInferencePipeline(const XrSecureMrPipelineRunPICO pre) {
-  const auto detection = m_secureMrDetectionPipeline->submit({{smallF32ImagePlaceholder, resizedLeftFp32Global},
-                                                              {isPoseDetectedPlaceholder, isPoseDetectedGlobal},
-                                                              {roiAffinePh1, roiAffineGlobal}},
-                                                             pre, nullptr);
-  const auto affine = m_secureMrAffineUpdatePipeline->submit(
-      {{roiAffinePh2, roiAffineGlobal}, {roiAffinePh3, roiAffineUpdatedGlobal}}, detection, isPoseDetectedGlobal);
-  return m_secureMrLandmarkPipeline->submit({{largeU8ImagePlaceholder, vstOutputLeftUint8Global},
-                                             {bodyLandmarkPlaceholder, bodyLandmarkGlobal},
-                                             {roiAffinePh4, roiAffineUpdatedGlobal}},
-                                            affine, nullptr);
+  const auto run = m_modelInferenceGraph.submit(pre);
+  m_gatedRenderingPipeline->noteUpdate(run);
+  return run;
 }
 
 XrSecureMrPipelineRunPICO PoseDetector::RunSecureMrRenderingPipeline(const XrSecureMrPipelineRunPICO pre) {
-  return m_secureMrRenderingPipeline->submit({{gltfPlaceholderTensor, poseMarkerGltf},
-                                              {isPoseDetectedPlaceholder2, isPoseDetectedGlobal},
-                                              {bodyLandmarkPlaceholder2, bodyLandmarkGlobal}},
-                                             pre, nullptr);
+  return m_gatedRenderingPipeline->submit(pre);
+}
+
+void PoseDetector::CreateSecureMrMovePipeline() {
+  if (poseMarkerGltf == nullptr) return;
+  static const TensorAttribute stagePoseAttribute{
+      .dimensions = {4, 4}, .channels = 1, .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO};
+  const auto buildMove = [](const std::shared_ptr<Pipeline>& pipeline, const std::shared_ptr<PipelineTensor>& pose) {
+    const auto gltfPlaceholder = PipelineTensor::PipelineGLTFPlaceholder(pipeline);
+    pipeline->execRenderCommand(std::make_shared<RenderCommand_UpdatePose>(gltfPlaceholder, pose));
+    return gltfPlaceholder;
+  };
+  const std::vector<int8_t> stagePoseBytes(reinterpret_cast<const int8_t*>(stagePoseData),
+                                           reinterpret_cast<const int8_t*>(stagePoseData) + sizeof(stagePoseData));
+
+  m_secureMrMovePipeline = std::make_unique<ParametricPipeline>(frameworkSession);
+  const auto stagePose = m_secureMrMovePipeline->addParameter("stage pose", stagePoseAttribute, stagePoseBytes);
+  m_secureMrMovePipeline->bind(buildMove(m_secureMrMovePipeline->pipeline(), stagePose), poseMarkerGltf);
+
+#ifdef POSE_BENCHMARK_MOVE_PIPELINE
+  // Writes the current stage pose, hence no visible move
+  const auto benchmark = BenchmarkEventSubmit(
+      frameworkSession, stagePoseAttribute, stagePoseBytes,
+      [this, &buildMove](const std::shared_ptr<Pipeline>& pipeline, const std::shared_ptr<PipelineTensor>& pose) {
+        return std::map<std::shared_ptr<PipelineTensor>, std::shared_ptr<GlobalTensor>>{
+            {buildMove(pipeline, pose), poseMarkerGltf}};
+      },
+      100);
+  Log::Write(Log::Level::Info, Fmt("Move pipeline event-to-submit latency over %zu events: %.1f us rebuilt per event, "
+                                   "%.1f us parametric",
+                                   benchmark.events, benchmark.rebuiltMicrosPerEvent,
+                                   benchmark.parametricMicrosPerEvent));
+#endif
 }
 
-void PoseDetector::CreateAndRunSecureMrMovePipeline(const float x, const float y, const float z) {
+void PoseDetector::RunSecureMrMovePipeline(const float x, const float y, const float z) {
   std::ostringstream oss;
   oss << "updated hand-pose delta {" << x << ',' << y << ',' << z << '}';
   Log::Write(Log::Level::Info, oss.str());
-  if (!pipelineAllInitialized) return;
-  if (m_secureMrMovePipeline == nullptr) {
-    m_secureMrMovePipeline = std::make_shared<Pipeline>(frameworkSession);
-    gltfPlaceholderTensor2 = PipelineTensor::PipelineGLTFPlaceholder(m_secureMrMovePipeline);
-
-    stagePose = std::make_shared<PipelineTensor>(
-        m_secureMrMovePipeline,
-        TensorAttribute{.dimensions = {4, 4}, .channels = 1, .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO});
-
-    m_secureMrMovePipeline->execRenderCommand(
-        std::make_shared<RenderCommand_UpdatePose>(gltfPlaceholderTensor2, stagePose));
-  }
+  if (!pipelineAllInitialized || m_secureMrMovePipeline == nullptr) return;
 
   stagePoseData[3] += x;
   stagePoseData[7] += y;
   stagePoseData[11] += z;
-  stagePose->setData(reinterpret_cast<int8_t*>(stagePoseData), sizeof(stagePoseData));
-  m_secureMrMovePipeline->submit({{gltfPlaceholderTensor2, poseMarkerGltf}}, nullptr, nullptr);
+  m_secureMrMovePipeline->set("stage pose", stagePoseData, std::size(stagePoseData)).submit();
 }
 
 std::shared_ptr<ISecureMR> CreateSecureMrProgram(const XrInstance& instance, const XrSession& session) {
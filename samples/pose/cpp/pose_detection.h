@@ -21,7 +21,11 @@
 #include "common.h"
 #include "securemr_base.h"
 #include "securemr_utils/adapter.hpp"
+#include "securemr_utils/gatedpipeline.h"
+#include "securemr_utils/parametric.h"
 #include "securemr_utils/pipeline.h"
+#include "securemr_utils/pipelinegraph.h"
+#include "securemr_utils/pipelinepool.h"
 #include "securemr_utils/tensor.h"
 #include "securemr_utils/rendercommand.h"
 #include "securemr_utils/session.h"
@@ -86,6 +90,11 @@ class PoseDetector : public ISecureMR {
    */
   void CreateSecureMrRenderingPipeline();
 
+  /**
+   * Create the pipeline moving the glTF by hand-pose events, once, with the stage pose as its parameter
+   */
+  void CreateSecureMrMovePipeline();
+
   /**
    * Submit the pipeline for retrieving RGB images for execution
    */
@@ -101,7 +110,10 @@ class PoseDetector : public ISecureMR {
    */
   XrSecureMrPipelineRunPICO RunSecureMrRenderingPipeline(XrSecureMrPipelineRunPICO pre = XR_NULL_HANDLE);
 
-  void CreateAndRunSecureMrMovePipeline(float x, float y, float z);
+  /**
+   * Move the stage pose of the glTF by a hand-pose delta, and resubmit the move pipeline with it
+   */
+  void RunSecureMrMovePipeline(float x, float y, float z);
 
   XrInstance xr_instance;
   XrSession xr_session;
@@ -194,12 +206,26 @@ class PoseDetector : public ISecureMR {
    * animation
    */
   std::shared_ptr<Pipeline> m_secureMrLandmarkPipeline;
+  /**
+   * The detection, affine-update and landmark pipelines with the roles of their
+   * placeholders, which chains the runs of the three pipelines
+   */
+  PipelineGraph m_modelInferenceGraph;
 
   /**
    * Render pipeline, where the animation is updated timely
    */
   std::shared_ptr<Pipeline> m_secureMrRenderingPipeline;
-  std::shared_ptr<Pipeline> m_secureMrMovePipeline;
+  /**
+   * The render pipeline, submitted only when a pose is detected, and only once per
+   * update of the landmarks
+   */
+  std::unique_ptr<GatedPipeline> m_gatedRenderingPipeline;
+  /**
+   * Move pipeline, built once and resubmitted on each hand-pose event with the new
+   * stage pose of the glTF
+   */
+  std::unique_ptr<ParametricPipeline> m_secureMrMovePipeline;
 
   // Placeholders for each pipeline
   // Recall placeholders are pipeline's local references to
@@ -236,9 +262,14 @@ class PoseDetector : public ISecureMR {
   std::shared_ptr<PipelineTensor> isPoseDetectedPlaceholder2;
   std::shared_ptr<PipelineTensor> bodyLandmarkPlaceholder2;
 
-  // Pipeline placeholder/local tensor for the move pipeline
-  std::shared_ptr<PipelineTensor> gltfPlaceholderTensor2;
-  std::shared_ptr<PipelineTensor> stagePose;
+  /**
+   * Pre-created pipelines of one-off jobs, such as placing the glTF at its stage
+   * pose once loaded
+   */
+  std::unique_ptr<PipelinePool> m_pipelinePool;
+  PipelinePool::TemplateId m_placeGltfTemplate = 0;
+
+  // Stage pose of the glTF, the parameter of the move pipeline
   float stagePoseData[16]{
       0.8f, 0.0f, 0.0f, 0.66f,  //
       0.0f, 0.8f, 0.0f, -0.5f,  //
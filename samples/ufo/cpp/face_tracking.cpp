@@ -189,6 +189,10 @@ void FaceTracker::CreateSecureMrModelInferencePipeline() {
   Log::Write(Log::Level::Info, "Secure MR: CreateSecureMrModelInferencePipeline");
 
   m_secureMrModelInferencePipeline = std::make_shared<Pipeline>(frameworkSession);
+  // Skip the inference on the camera frames older than 100 ms, or already inferred
+  m_inferenceGate = std::make_unique<FrameGate>(
+      frameworkSession, vstTimestampGlobal, "inference",
+      FrameGateOptions{.budget = std::chrono::milliseconds(100), .reportEvery = 100});
 
   // Step 1: pipeline placeholders for global tensors
   vstImagePlaceholder =
@@ -282,6 +286,10 @@ void FaceTracker::CreateSecureMrModelInferencePipeline() {
 
 void FaceTracker::CreateSecureMrMap2dTo3dPipeline() {
   m_secureMrMap2dTo3dPipeline = std::make_shared<Pipeline>(frameworkSession);
+  // Likewise for the mapping, which reads the camera frames again
+  m_map2dTo3dGate = std::make_unique<FrameGate>(
+      frameworkSession, vstTimestampGlobal, "2D to 3D",
+      FrameGateOptions{.budget = std::chrono::milliseconds(100), .reportEvery = 100});
 
   // Step 1: pipeline placeholders
   uvPlaceholder1 = PipelineTensor::PipelinePlaceholderLike(m_secureMrMap2dTo3dPipeline, uvGlobal);
@@ -380,23 +388,23 @@ void FaceTracker::RunSecureMrVSTImagePipeline() {
                                       {vstCameraMatrixPlaceholder, vstCameraMatrixGlobal},
                                       {vstOutputLeftFp32Placeholder, vstOutputLeftFp32Global}},
                                      XR_NULL_HANDLE, nullptr);
+  m_inferenceGate->noteFrame();
+  m_map2dTo3dGate->noteFrame();
 }
 
 void FaceTracker::RunSecureMrModelInferencePipeline() {
-  m_secureMrModelInferencePipeline->submit({{vstImagePlaceholder, vstOutputLeftFp32Global},
-                                            {uvPlaceholder, uvGlobal},
-                                            {isFaceDetectedPlaceholder, isFaceDetectedGlobal}},
-                                           XR_NULL_HANDLE, nullptr);
+  m_inferenceGate->submit(*m_secureMrModelInferencePipeline, {{vstImagePlaceholder, vstOutputLeftFp32Global},
+                                                              {uvPlaceholder, uvGlobal},
+                                                              {isFaceDetectedPlaceholder, isFaceDetectedGlobal}});
 }
 
 void FaceTracker::RunSecureMrMap2dTo3dPipeline() {
-  m_secureMrMap2dTo3dPipeline->submit({{uvPlaceholder1, uvGlobal},
-                                       {timestampPlaceholder1, vstTimestampGlobal},
-                                       {cameraMatrixPlaceholder1, vstCameraMatrixGlobal},
-                                       {leftImgePlaceholder, vstOutputLeftUint8Global},
-                                       {rightImagePlaceholder, vstOutputRightUint8Global},
-                                       {currentPositionPlaceholder, currentPositionGlobal}},
-                                      XR_NULL_HANDLE, nullptr);
+  m_map2dTo3dGate->submit(*m_secureMrMap2dTo3dPipeline, {{uvPlaceholder1, uvGlobal},
+                                                         {timestampPlaceholder1, vstTimestampGlobal},
+                                                         {cameraMatrixPlaceholder1, vstCameraMatrixGlobal},
+                                                         {leftImgePlaceholder, vstOutputLeftUint8Global},
+                                                         {rightImagePlaceholder, vstOutputRightUint8Global},
+                                                         {currentPositionPlaceholder, currentPositionGlobal}});
 }
 
 void FaceTracker::RunSecureMrRenderingPipeline() {
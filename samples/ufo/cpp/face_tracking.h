@@ -20,6 +20,7 @@
 #include "common.h"
 #include "securemr_base.h"
 #include "securemr_utils/adapter.hpp"
+#include "securemr_utils/framegate.h"
 #include "securemr_utils/pipeline.h"
 #include "securemr_utils/tensor.h"
 #include "securemr_utils/rendercommand.h"
@@ -165,6 +166,12 @@ class FaceTracker : public ISecureMR {
    * Render pipeline, where the animation is updated timely
    */
   std::shared_ptr<Pipeline> m_secureMrRenderingPipeline;
+  /**
+   * Gates of the inference and 2D-to-3D pipelines, skipping the
+   * camera frames which are stale or were already processed
+   */
+  std::unique_ptr<FrameGate> m_inferenceGate;
+  std::unique_ptr<FrameGate> m_map2dTo3dGate;
 
   // Placeholders for each pipeline
   // Recall placeholders are pipeline's local references to
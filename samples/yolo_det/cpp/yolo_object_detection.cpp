@@ -309,18 +309,18 @@ void YoloDetector::CreateSecureMrVSTImagePipeline()  {
 
   m_secureMrVSTImagePipeline = std::make_shared<Pipeline>(frameworkSession);
 
+  // The left camera frame doubles as the model input, normalized to [0, 1]: it is stored as the uint8 image the
+  // camera writes, and only the inference pipeline widens it to float32
   vstOutputLeftUint8Global = std::make_shared<GlobalTensor>(frameworkSession, TensorAttribute{.dimensions = {640, 640},
                                                                                                                   .channels = 3,
                                                                                                                   .usage = XR_SECURE_MR_TENSOR_TYPE_MAT_PICO,
-                                                                                                                  .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO});
+                                                                                                                  .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO},
+                                                            TensorTransport{.storageType = XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO,
+                                                                            .scale = 255.0f});
   vstOutputRightUint8Global = std::make_shared<GlobalTensor>(frameworkSession, TensorAttribute{.dimensions = {640, 640},
                                                                                                                    .channels = 3,
                                                                                                                    .usage = XR_SECURE_MR_TENSOR_TYPE_MAT_PICO,
                                                                                                                    .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO});
-  vstOutputLeftFp32Global = std::make_shared<GlobalTensor>(frameworkSession, TensorAttribute{.dimensions = {640, 640},
-                                                                                                                 .channels = 3,
-                                                                                                                 .usage = XR_SECURE_MR_TENSOR_TYPE_MAT_PICO,
-                                                                                                                 .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO});
   vstTimestampGlobal = std::make_shared<GlobalTensor>(frameworkSession, TensorAttribute{.dimensions = {1},
                                                                                                             .channels = 4,
                                                                                                             .usage = XR_SECURE_MR_TENSOR_TYPE_TIMESTAMP_PICO,
@@ -330,26 +330,32 @@ void YoloDetector::CreateSecureMrVSTImagePipeline()  {
                                                                                                                .usage = XR_SECURE_MR_TENSOR_TYPE_MAT_PICO,
                                                                                                                .dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO});
 
+  // Log the bytes of the camera frames bound to each pipeline, which dominate the traffic between pipelines
+  frameworkSession->bandwidth().label(*vstOutputLeftUint8Global, "vstOutputLeftUint8Global");
+  frameworkSession->bandwidth().label(*vstOutputRightUint8Global, "vstOutputRightUint8Global");
+  frameworkSession->bandwidth().setReportInterval(std::chrono::seconds(5));
+
   vstOutputLeftUint8Placeholder = PipelineTensor::PipelinePlaceholderLike(m_secureMrVSTImagePipeline, vstOutputLeftUint8Global);
   vstOutputRightUint8Placeholder = PipelineTensor::PipelinePlaceholderLike(m_secureMrVSTImagePipeline, vstOutputRightUint8Global);
   vstTimestampPlaceholder = PipelineTensor::PipelinePlaceholderLike(m_secureMrVSTImagePipeline, vstTimestampGlobal);
   vstCameraMatrixPlaceholder = PipelineTensor::PipelinePlaceholderLike(m_secureMrVSTImagePipeline, vstCameraMatrixGlobal);
 
-  vstOutputLeftFp32Placeholder = PipelineTensor::PipelinePlaceholderLike(m_secureMrVSTImagePipeline, vstOutputLeftFp32Global);
-
   (*m_secureMrVSTImagePipeline).cameraAccess(vstOutputLeftUint8Placeholder,
                                              vstOutputRightUint8Placeholder,
                                              vstTimestampPlaceholder,
-                                             vstCameraMatrixPlaceholder)
-      .assignment(vstOutputLeftUint8Placeholder, vstOutputLeftFp32Placeholder)
-      .arithmetic("{0} / 255.0", {vstOutputLeftFp32Placeholder}, vstOutputLeftFp32Placeholder);
+                                             vstCameraMatrixPlaceholder);
 }
 
 void YoloDetector::CreateSecureMrModelInferencePipeline() {
   Log::Write(Log::Level::Info, "Secure MR: CreateSecureMrModelInferencePipeline");
 
   m_secureMrModelInferencePipeline = std::make_shared<Pipeline>(frameworkSession);
-  vstImagePlaceholder = PipelineTensor::PipelinePlaceholderLike(m_secureMrModelInferencePipeline, vstOutputLeftFp32Global);
+  // Skip the inference on the camera frames older than 100 ms, or already inferred
+  m_inferenceGate = std::make_unique<FrameGate>(
+      frameworkSession, vstTimestampGlobal, "inference",
+      FrameGateOptions{.budget = std::chrono::milliseconds(100), .reportEvery = 100});
+  const auto vstImage = PipelineTensor::PipelineTransportReader(m_secureMrModelInferencePipeline, vstOutputLeftUint8Global);
+  vstImagePlaceholder = vstImage.placeholder;
 
   classesSelectGlobal = std::make_shared<GlobalTensor>(frameworkSession, TensorAttribute{.dimensions = {NUMBER_OF_OBJECTS, 1},
                                                                                                              .channels = 1,
@@ -368,7 +374,7 @@ void YoloDetector::CreateSecureMrModelInferencePipeline() {
     auto algPackageSize = modelData.size();
 
     std::unordered_map<std::string, std::shared_ptr<PipelineTensor>> algOps;
-    algOps["images"] = vstImagePlaceholder;
+    algOps["images"] = vstImage.logical;
 
     std::unordered_map<std::string, std::string> operandAliasing;
     operandAliasing["images"] = "images";
@@ -379,7 +385,13 @@ void YoloDetector::CreateSecureMrModelInferencePipeline() {
     std::unordered_map<std::string, std::string> resultAliasing;
     resultAliasing["output0"] = "output0";
 
-    (*m_secureMrModelInferencePipeline).runAlgorithm(algPackageBuf, algPackageSize, algOps, operandAliasing, algResults, resultAliasing, "yolo");
+    // The model takes NHWC images, per the custom I/O layout of its conversion (Docker/custom_io.yaml), so the
+    // interleaved camera frame is bound without a transpose
+    std::unordered_map<std::string, ModelIoEncoding> operandEncodings;
+    operandEncodings["images"] = ModelIoEncoding{.layout = ModelIoLayout::HWC};
+
+    (*m_secureMrModelInferencePipeline).runAlgorithm(algPackageBuf, algPackageSize, algOps, operandAliasing, algResults, resultAliasing, "yolo",
+                                                     operandEncodings);
   } else {
     Log::Write(Log::Level::Error, "Failed to load model data from file.");
   }
@@ -468,6 +480,10 @@ void YoloDetector::CreateSecureMrModelInferencePipeline() {
 void YoloDetector::CreateSecureMrMap2dTo3dPipeline() {
 
   m_secureMrMap2dTo3dPipeline = std::make_shared<Pipeline>(frameworkSession);
+  // Likewise for the mapping, which reads the camera frames again
+  m_map2dTo3dGate = std::make_unique<FrameGate>(
+      frameworkSession, vstTimestampGlobal, "2D to 3D",
+      FrameGateOptions{.budget = std::chrono::milliseconds(100), .reportEvery = 100});
 
   nmsBoxesPlaceholder1 = PipelineTensor::PipelinePlaceholderLike(m_secureMrMap2dTo3dPipeline, nmsBoxesGlobal);
   timestampPlaceholder1 = PipelineTensor::PipelinePlaceholderLike(m_secureMrMap2dTo3dPipeline, vstTimestampGlobal);
@@ -652,26 +668,26 @@ void YoloDetector::RunSecureMrVSTImagePipeline() {
   m_secureMrVSTImagePipeline->submit({{vstOutputLeftUint8Placeholder, vstOutputLeftUint8Global},
                                       {vstOutputRightUint8Placeholder, vstOutputRightUint8Global},
                                       {vstTimestampPlaceholder, vstTimestampGlobal},
-                                      {vstCameraMatrixPlaceholder, vstCameraMatrixGlobal},
-                                      {vstOutputLeftFp32Placeholder, vstOutputLeftFp32Global}}, XR_NULL_HANDLE, nullptr);
+                                      {vstCameraMatrixPlaceholder, vstCameraMatrixGlobal}}, XR_NULL_HANDLE, nullptr);
+  m_inferenceGate->noteFrame();
+  m_map2dTo3dGate->noteFrame();
 }
 
 void YoloDetector::RunSecureMrModelInferencePipeline() {
-  m_secureMrModelInferencePipeline->submit({{vstImagePlaceholder, vstOutputLeftFp32Global},
-                                            {nmsBoxesPlaceholder, nmsBoxesGlobal},
-                                            {nmsScoresPlaceholder, nmsScoresGlobal},
-                                            {classesSelectPlaceholder, classesSelectGlobal}},
-                                           XR_NULL_HANDLE, nullptr);
+  m_inferenceGate->submit(*m_secureMrModelInferencePipeline, {{vstImagePlaceholder, vstOutputLeftUint8Global},
+                                                              {nmsBoxesPlaceholder, nmsBoxesGlobal},
+                                                              {nmsScoresPlaceholder, nmsScoresGlobal},
+                                                              {classesSelectPlaceholder, classesSelectGlobal}});
 }
 
 void YoloDetector::RunSecureMrMap2dTo3dPipeline() {
-  m_secureMrMap2dTo3dPipeline->submit({{nmsBoxesPlaceholder1, nmsBoxesGlobal},
-                                       {timestampPlaceholder1, vstTimestampGlobal},
-                                       {cameraMatrixPlaceholder1, vstCameraMatrixGlobal},
-                                       {leftImgePlaceholder, vstOutputLeftUint8Global},
-                                       {rightImagePlaceholder, vstOutputRightUint8Global},
-                                       {pointXYZPlaceholder, pointXYZGlobal},
-                                       {scalePlaceholder, scaleGlobal}}, XR_NULL_HANDLE, nullptr);
+  m_map2dTo3dGate->submit(*m_secureMrMap2dTo3dPipeline, {{nmsBoxesPlaceholder1, nmsBoxesGlobal},
+                                                         {timestampPlaceholder1, vstTimestampGlobal},
+                                                         {cameraMatrixPlaceholder1, vstCameraMatrixGlobal},
+                                                         {leftImgePlaceholder, vstOutputLeftUint8Global},
+                                                         {rightImagePlaceholder, vstOutputRightUint8Global},
+                                                         {pointXYZPlaceholder, pointXYZGlobal},
+                                                         {scalePlaceholder, scaleGlobal}});
 }
 
 void YoloDetector::RunSecureMrRenderingPipeline() {
@@ -20,6 +20,7 @@
 #include "common.h"
 #include "securemr_base.h"
 #include "securemr_utils/adapter.hpp"
+#include "securemr_utils/framegate.h"
 #include "securemr_utils/pipeline.h"
 #include "securemr_utils/tensor.h"
 #include "securemr_utils/rendercommand.h"
@@ -90,18 +91,18 @@ class YoloDetector : public ISecureMR {
   std::shared_ptr<Pipeline> m_secureMrModelInferencePipeline;  // YOLO model inference pipeline
   std::shared_ptr<Pipeline> m_secureMrMap2dTo3dPipeline;       // 2D to 3D coordinate mapping pipeline
   std::shared_ptr<Pipeline> m_secureMrRenderingPipeline;       // Result visualization pipeline
+  std::unique_ptr<FrameGate> m_inferenceGate;                  // Skips inference on stale or processed frames
+  std::unique_ptr<FrameGate> m_map2dTo3dGate;                  // Skips 2D to 3D mapping on stale or processed frames
 
   // VST Pipeline IO
   // Handles stereo camera input processing and format conversion
-  std::shared_ptr<GlobalTensor> vstOutputLeftUint8Global;      // Left camera frame in uint8 format
+  std::shared_ptr<GlobalTensor> vstOutputLeftUint8Global;      // Left camera frame in uint8, read as float32 by the model
   std::shared_ptr<GlobalTensor> vstOutputRightUint8Global;     // Right camera frame in uint8 format
-  std::shared_ptr<GlobalTensor> vstOutputLeftFp32Global;       // Left camera frame in float32 format for model input
   std::shared_ptr<GlobalTensor> vstTimestampGlobal;           // Camera frame timestamp for synchronization
   std::shared_ptr<GlobalTensor> vstCameraMatrixGlobal;        // Camera calibration matrix
   // Pipeline placeholders for VST tensors
   std::shared_ptr<PipelineTensor> vstOutputLeftUint8Placeholder;
   std::shared_ptr<PipelineTensor> vstOutputRightUint8Placeholder;
-  std::shared_ptr<PipelineTensor> vstOutputLeftFp32Placeholder;
   std::shared_ptr<PipelineTensor> vstTimestampPlaceholder;
   std::shared_ptr<PipelineTensor> vstCameraMatrixPlaceholder;
 
@@ -0,0 +1,171 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "test_util.h"
+#include "host/camera.h"
+
+using namespace SecureMR::Host;
+
+namespace {
+
+constexpr size_t WIDTH = 64, HEIGHT = 48, FRAME_COUNT = 4;
+constexpr int DISPARITY = 8;
+
+uint64_t Nanoseconds(const CameraFrame& frame) {
+  return static_cast<uint64_t>(static_cast<uint32_t>(frame.timestamp[0])) << 32 |
+         static_cast<uint32_t>(frame.timestamp[1]);
+}
+
+/**
+ * A frame of the procedural source with its own image buffers, the reference the recorded frames must reproduce
+ */
+struct OwnedFrame {
+  CameraFrame frame;
+  std::vector<uint8_t> left = std::vector<uint8_t>(WIDTH * HEIGHT * 3);
+  std::vector<uint8_t> right = std::vector<uint8_t>(WIDTH * HEIGHT * 3);
+};
+
+OwnedFrame Produce(ProceduralCameraSource& source, const uint64_t index) {
+  OwnedFrame owned;
+  source.produce(index, owned.frame, owned.left.data(), owned.right.data());
+  owned.frame.leftEye = owned.left.data();
+  owned.frame.rightEye = owned.right.data();
+  return owned;
+}
+
+bool SameImages(const CameraFrame& frame, const OwnedFrame& expected) {
+  return frame.width == WIDTH && frame.height == HEIGHT &&
+         std::memcmp(frame.leftEye, expected.left.data(), expected.left.size()) == 0 &&
+         std::memcmp(frame.rightEye, expected.right.data(), expected.right.size()) == 0;
+}
+
+/**
+ * Whether opening a copy of the recording, with its header replaced by <code>{width, height, frameCount}</code>
+ * and its last <code>cut</code> bytes removed, is refused
+ */
+bool Rejects(const std::filesystem::path& recording, const std::array<uint64_t, 3>& header, const size_t cut = 0) {
+  std::ifstream in(recording, std::ios::binary);
+  std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  std::memcpy(bytes.data() + 8, header.data(), sizeof(header));
+  bytes.resize(bytes.size() - cut);
+  const auto path = std::filesystem::temp_directory_path() / "securemr_camera_test_corrupt.raw";
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  out.close();
+  bool rejected = false;
+  try {
+    RawSequenceCameraSource source(path);
+  } catch (const std::exception&) {
+    rejected = true;
+  }
+  std::filesystem::remove(path);
+  return rejected;
+}
+
+}  // namespace
+
+int main() {
+  ProceduralCameraSource procedural(WIDTH, HEIGHT, std::chrono::milliseconds(10), DISPARITY);
+
+  // The right eye sees column x + disparity of the left eye
+  const auto first = Produce(procedural, 0);
+  bool shifted = true;
+  for (size_t y = 0; y < HEIGHT; ++y) {
+    for (size_t x = 0; x + DISPARITY < WIDTH; ++x) {
+      shifted = shifted && std::memcmp(&first.right[(y * WIDTH + x) * 3], &first.left[(y * WIDTH + x + DISPARITY) * 3],
+                                       3) == 0;
+    }
+  }
+  EXPECT(shifted);
+  EXPECT(Nanoseconds(Produce(procedural, 3).frame) == 30'000'000);
+
+  // A recording replays the frames of its source unchanged, from the mapping
+  const auto path = std::filesystem::temp_directory_path() / "securemr_camera_test.raw";
+  RawSequenceCameraSource::Write(path, procedural, FRAME_COUNT);
+  {
+    RawSequenceCameraSource recording(path);
+    EXPECT(recording.width() == WIDTH && recording.height() == HEIGHT && recording.frameCount() == FRAME_COUNT);
+    EXPECT(!recording.copiesFrames());
+    bool matches = true;
+    for (uint64_t index = 0; index < FRAME_COUNT; ++index) {
+      CameraFrame frame;
+      recording.produce(index, frame, nullptr, nullptr);
+      const auto expected = Produce(procedural, index);
+      frame.width = WIDTH, frame.height = HEIGHT;
+      matches = matches && SameImages(frame, expected) && Nanoseconds(frame) == Nanoseconds(expected.frame) &&
+                std::memcmp(frame.cameraMatrix, expected.frame.cameraMatrix, sizeof(frame.cameraMatrix)) == 0;
+    }
+    EXPECT(matches);
+  }
+
+  // Looping: the images repeat, the timestamps keep increasing
+  {
+    CameraProvider provider(std::make_unique<RawSequenceCameraSource>(path),
+                            CameraProviderConfig{.frameRate = 0.0, .prefetchDepth = 2, .loop = true});
+    uint64_t previous = 0;
+    bool increasing = true, matches = true;
+    for (uint64_t index = 0; index < 3 * FRAME_COUNT; ++index) {
+      CameraFrame frame;
+      EXPECT(provider.acquire(frame));
+      increasing = increasing && (index == 0 || Nanoseconds(frame) > previous);
+      previous = Nanoseconds(frame);
+      matches = matches && SameImages(frame, Produce(procedural, index % FRAME_COUNT));
+    }
+    EXPECT(increasing);
+    EXPECT(matches);
+    EXPECT(provider.stats().framesDelivered == 3 * FRAME_COUNT);
+  }
+
+  // Without looping, the sequence ends after its last frame
+  {
+    CameraProvider provider(std::make_unique<RawSequenceCameraSource>(path),
+                            CameraProviderConfig{.frameRate = 0.0, .prefetchDepth = 2, .loop = false});
+    CameraFrame frame;
+    size_t delivered = 0;
+    while (provider.acquire(frame)) ++delivered;
+    EXPECT(delivered == FRAME_COUNT);
+  }
+
+  // A truncated recording or a corrupt header is refused, even when the frame size would overflow
+  EXPECT(!Rejects(path, {WIDTH, HEIGHT, FRAME_COUNT}));
+  EXPECT(Rejects(path, {WIDTH, HEIGHT, FRAME_COUNT}, 1));
+  EXPECT(Rejects(path, {WIDTH, HEIGHT, FRAME_COUNT + 1}));
+  EXPECT(Rejects(path, {0, HEIGHT, FRAME_COUNT}));
+  EXPECT(Rejects(path, {WIDTH, 0, FRAME_COUNT}));
+  EXPECT(Rejects(path, {uint64_t{1} << 32, uint64_t{1} << 32, 1}));
+  EXPECT(Rejects(path, {WIDTH, HEIGHT, uint64_t{1} << 60}));
+  std::filesystem::remove(path);
+
+  // A copying source is delivered from the provider's own buffers
+  {
+    CameraProvider provider(std::make_unique<ProceduralCameraSource>(WIDTH, HEIGHT, std::chrono::milliseconds(10),
+                                                                     DISPARITY),
+                            CameraProviderConfig{.frameRate = 0.0, .prefetchDepth = 3, .loop = true});
+    bool matches = true;
+    for (uint64_t index = 0; index < 5; ++index) {
+      CameraFrame frame;
+      EXPECT(provider.acquire(frame));
+      matches = matches && frame.index == index && SameImages(frame, Produce(procedural, index));
+    }
+    EXPECT(matches);
+  }
+
+  return Test::Finish("camera");
+}
@@ -0,0 +1,142 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "test_util.h"
+#include "host/expression.h"
+
+using namespace SecureMR::Host;
+
+namespace {
+
+/**
+ * Flat index into an operand of shape <code>operandShape</code> of the result element at <code>index</code>,
+ * broadcasting numpy-style
+ */
+size_t BroadcastIndex(size_t index, const std::vector<size_t>& resultShape, const std::vector<size_t>& operandShape) {
+  size_t operandIndex = 0, stride = 1;
+  for (size_t axis = 0; axis < resultShape.size(); ++axis) {
+    const size_t resultAxis = resultShape.size() - 1 - axis;
+    const size_t coordinate = index % resultShape[resultAxis];
+    index /= resultShape[resultAxis];
+    if (axis >= operandShape.size()) continue;
+    const size_t extent = operandShape[operandShape.size() - 1 - axis];
+    operandIndex += (extent == 1 ? 0 : coordinate) * stride;
+    stride *= extent;
+  }
+  return operandIndex;
+}
+
+/**
+ * Evaluate <code>expression</code> with the kernel and compare it against <code>reference</code> evaluated element
+ * by element in double precision, then rounded and saturated for integer results
+ */
+template <typename A, typename B, typename R>
+void CheckExpression(const std::string& expression, const std::function<double(double, double)>& reference,
+                     const std::vector<A>& a, const std::vector<size_t>& aShape, const std::vector<B>& b,
+                     const std::vector<size_t>& bShape, const std::vector<size_t>& resultShape,
+                     const XrSecureMrTensorDataTypePICO aType, const XrSecureMrTensorDataTypePICO bType,
+                     const XrSecureMrTensorDataTypePICO resultType, ThreadPool& pool) {
+  const ConstTensorView aView{a.data(), aType, aShape};
+  const ConstTensorView bView{b.data(), bType, bShape};
+  std::vector<R> result(TensorView{nullptr, resultType, resultShape}.elementCount());
+  ExpressionProgram::Compile(expression).evaluate({aView, bView}, TensorView{result.data(), resultType, resultShape},
+                                                  pool);
+
+  bool matches = true;
+  for (size_t i = 0; i < result.size(); ++i) {
+    const double expected = reference(static_cast<double>(a[BroadcastIndex(i, resultShape, aShape)]),
+                                      static_cast<double>(b[BroadcastIndex(i, resultShape, bShape)]));
+    if constexpr (std::is_floating_point_v<R>) {
+      matches = matches && std::abs(result[i] - expected) <= 1e-5 * std::max(1.0, std::abs(expected));
+    } else {
+      const double clamped = std::clamp<double>(std::nearbyint(expected), std::numeric_limits<R>::lowest(),
+                                                std::numeric_limits<R>::max());
+      matches = matches && static_cast<double>(result[i]) == clamped;
+    }
+  }
+  EXPECT(matches);
+}
+
+}  // namespace
+
+int main() {
+  ThreadPool pool(3);
+  constexpr auto FLOAT32 = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO;
+  constexpr auto FLOAT64 = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT64_PICO;
+  constexpr auto UINT8 = XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO;
+  constexpr auto INT16 = XR_SECURE_MR_TENSOR_DATA_TYPE_INT16_PICO;
+  constexpr auto INT32 = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO;
+
+  // Same shapes, long enough to span several evaluation blocks and a ragged tail
+  const auto x = Test::RandomValues<float>(3001, -10.0f, 10.0f, 1);
+  const auto y = Test::RandomValues<float>(3001, 0.5f, 4.0f, 2);
+  CheckExpression<float, float, float>(
+      "({0} / 256.0 + {1}) * 256.0", [](const double a, const double b) { return (a / 256.0 + b) * 256.0; }, x, {3001},
+      y, {3001}, {3001}, FLOAT32, FLOAT32, FLOAT32, pool);
+  CheckExpression<float, float, float>(
+      "-{0} * 2 - {1} / (1 + 1)", [](const double a, const double b) { return -a * 2 - b / 2; }, x, {3001}, y, {3001},
+      {3001}, FLOAT32, FLOAT32, FLOAT32, pool);
+  CheckExpression<float, float, double>(
+      "{0} * {1} - ({0} - {1}) * 0.5", [](const double a, const double b) { return a * b - (a - b) * 0.5; }, x, {3001},
+      y, {3001}, {3001}, FLOAT32, FLOAT32, FLOAT64, pool);
+
+  // Broadcasting: a row vector, and size-1 axes on both sides
+  const auto image = Test::RandomValues<float>(20 * 30 * 3, 0.0f, 255.0f, 3);
+  const std::vector<float> mean = {123.5f, 116.25f, 103.5f};
+  CheckExpression<float, float, float>(
+      "({0} - {1}) / 58.0", [](const double a, const double b) { return (a - b) / 58.0; }, image, {20, 30, 3}, mean,
+      {3}, {20, 30, 3}, FLOAT32, FLOAT32, FLOAT32, pool);
+  const auto column = Test::RandomValues<float>(20 * 1 * 3, -1.0f, 1.0f, 4);
+  const auto row = Test::RandomValues<float>(30 * 1, -1.0f, 1.0f, 5);
+  CheckExpression<float, float, float>(
+      "{0} + {1}", [](const double a, const double b) { return a + b; }, column, {20, 1, 3}, row, {30, 1},
+      {20, 30, 3}, FLOAT32, FLOAT32, FLOAT32, pool);
+
+  // Integer operands and results: rounded to nearest, saturated to the result type
+  const auto bytes = Test::RandomValues<uint8_t>(1000, 0, 255, 6);
+  const auto shorts = Test::RandomValues<int16_t>(1000, -300, 300, 7);
+  CheckExpression<uint8_t, int16_t, int16_t>(
+      "{0} * 200 - {1} / 3", [](const double a, const double b) { return a * 200 - b / 3; }, bytes, {1000}, shorts,
+      {1000}, {1000}, UINT8, INT16, INT16, pool);
+  CheckExpression<int16_t, uint8_t, uint8_t>(
+      "{0} + {1} * 0.5", [](const double a, const double b) { return a + b * 0.5; }, shorts, {1000}, bytes, {1000},
+      {1000}, INT16, UINT8, UINT8, pool);
+  const auto ints = Test::RandomValues<int32_t>(1000, -2000000000, 2000000000, 8);
+  const auto divisors = Test::RandomValues<int32_t>(1000, 1, 7, 9);
+  CheckExpression<int32_t, int32_t, int32_t>(
+      "{0} / {1} + {0}", [](const double a, const double b) { return a / b + a; }, ints, {1000}, divisors, {1000},
+      {1000}, INT32, INT32, INT32, pool);
+
+  // Compilation
+  EXPECT(ExpressionProgram::Compile("{2} * 2").operandCount() == 3);
+  EXPECT(ExpressionProgram::Compile("(1 + 2) * {0}").instructionCount() <= 3);
+  for (const char* invalid : {"{0} +", "({0}", "{0} {1}", "{x}", ""}) {
+    bool thrown = false;
+    try {
+      ExpressionProgram::Compile(invalid);
+    } catch (const std::exception&) {
+      thrown = true;
+    }
+    EXPECT(thrown);
+  }
+
+  return Test::Finish("expression");
+}
@@ -0,0 +1,193 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+#include "test_util.h"
+#include "host/model.h"
+
+using namespace SecureMR::Host;
+
+namespace {
+
+constexpr size_t IN_H = 7, IN_W = 6, IN_C = 2, FILTERS = 3, K = 3, UNITS = 4;
+
+/**
+ * Convolution (same padding, stride 1, ReLU) then 2x2 max pooling, a dense layer and softmax, computed directly
+ * from the definitions on HWC tensors
+ */
+std::vector<float> ReferenceForward(const std::vector<float>& input, const std::vector<float>& convWeights,
+                                    const std::vector<float>& convBias, const std::vector<float>& denseWeights,
+                                    const std::vector<float>& denseBias) {
+  // "same" padding of a 3x3 window at stride 1 is one pixel on every side
+  std::vector<float> conv(IN_H * IN_W * FILTERS);
+  for (size_t y = 0; y < IN_H; ++y) {
+    for (size_t x = 0; x < IN_W; ++x) {
+      for (size_t f = 0; f < FILTERS; ++f) {
+        double sum = convBias[f];
+        for (size_t ky = 0; ky < K; ++ky) {
+          for (size_t kx = 0; kx < K; ++kx) {
+            const auto iy = static_cast<ptrdiff_t>(y + ky) - 1, ix = static_cast<ptrdiff_t>(x + kx) - 1;
+            if (iy < 0 || ix < 0 || iy >= static_cast<ptrdiff_t>(IN_H) || ix >= static_cast<ptrdiff_t>(IN_W)) {
+              continue;
+            }
+            for (size_t c = 0; c < IN_C; ++c) {
+              sum += convWeights[((f * K + ky) * K + kx) * IN_C + c] * input[(iy * IN_W + ix) * IN_C + c];
+            }
+          }
+        }
+        conv[(y * IN_W + x) * FILTERS + f] = static_cast<float>(std::max(sum, 0.0));
+      }
+    }
+  }
+
+  // "valid" 2x2 pooling drops the last row of the odd height
+  constexpr size_t POOL_H = IN_H / 2, POOL_W = IN_W / 2;
+  std::vector<float> pooled(POOL_H * POOL_W * FILTERS);
+  for (size_t y = 0; y < POOL_H; ++y) {
+    for (size_t x = 0; x < POOL_W; ++x) {
+      for (size_t f = 0; f < FILTERS; ++f) {
+        float best = conv[(2 * y * IN_W + 2 * x) * FILTERS + f];
+        for (size_t dy = 0; dy < 2; ++dy) {
+          for (size_t dx = 0; dx < 2; ++dx) {
+            best = std::max(best, conv[((2 * y + dy) * IN_W + 2 * x + dx) * FILTERS + f]);
+          }
+        }
+        pooled[(y * POOL_W + x) * FILTERS + f] = best;
+      }
+    }
+  }
+
+  std::vector<double> logits(UNITS);
+  for (size_t u = 0; u < UNITS; ++u) {
+    logits[u] = denseBias[u];
+    for (size_t i = 0; i < pooled.size(); ++i) logits[u] += denseWeights[u * pooled.size() + i] * pooled[i];
+  }
+  const double largest = *std::max_element(logits.begin(), logits.end());
+  double total = 0.0;
+  for (auto& logit : logits) total += (logit = std::exp(logit - largest));
+  std::vector<float> probabilities(UNITS);
+  for (size_t u = 0; u < UNITS; ++u) probabilities[u] = static_cast<float>(logits[u] / total);
+  return probabilities;
+}
+
+void CheckReferenceNetwork() {
+  const auto input = Test::RandomValues<float>(IN_H * IN_W * IN_C, 0.0f, 1.0f, 1);
+  const auto convWeights = Test::RandomValues<float>(FILTERS * K * K * IN_C, -0.5f, 0.5f, 2);
+  const auto convBias = Test::RandomValues<float>(FILTERS, -0.1f, 0.1f, 3);
+  const auto denseWeights = Test::RandomValues<float>(UNITS * (IN_H / 2) * (IN_W / 2) * FILTERS, -0.5f, 0.5f, 4);
+  const auto denseBias = Test::RandomValues<float>(UNITS, -0.1f, 0.1f, 5);
+
+  const nlohmann::json network = {
+      {"format", ReferenceModelBackend::FORMAT},
+      {"inputs", {{{"name", "input_1"}, {"shape", {IN_H, IN_W, IN_C}}}}},
+      {"layers",
+       {{{"type", "conv2d"}, {"input", "input_1"}, {"output", "c1"}, {"filters", FILTERS}, {"kernel", {K, K}},
+         {"padding", "same"}, {"activation", "relu"}, {"weights", convWeights}, {"bias", convBias}},
+        {{"type", "max_pool2d"}, {"input", "c1"}, {"output", "p1"}, {"size", 2}},
+        {{"type", "dense"}, {"input", "p1"}, {"output", "logits"}, {"units", UNITS}, {"weights", denseWeights},
+         {"bias", denseBias}},
+        {{"type", "softmax"}, {"input", "logits"}, {"output", "prob"}},
+        {{"type", "reduce_max"}, {"input", "prob"}, {"output", "_538"}},
+        {{"type", "argmax"}, {"input", "prob"}, {"output", "_539"}}}}};
+  const auto package = network.dump();
+  EXPECT(ReferenceModelBackend::IsReferencePackage(package.data(), package.size()));
+
+  // Created through the registry, as a host harness does for a model name without a factory
+  const auto backend = ModelBackendRegistry::Default().create(package.data(), package.size(), "mnist");
+  constexpr auto FLOAT32 = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO;
+  std::vector<float> probabilities(UNITS), score(1);
+  std::vector<int32_t> label(1);
+  // The second run reuses the buffers of the first
+  for (int run = 0; run < 2; ++run) {
+    backend->run({{"input_1", ConstTensorView{input.data(), FLOAT32, {IN_H, IN_W, IN_C}}}},
+                 {{"prob", TensorView{probabilities.data(), FLOAT32, {UNITS}}},
+                  {"_538", TensorView{score.data(), FLOAT32, {1}}},
+                  {"_539", TensorView{label.data(), XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO, {1}}}});
+  }
+
+  const auto expected = ReferenceForward(input, convWeights, convBias, denseWeights, denseBias);
+  float error = 0.0f;
+  for (size_t u = 0; u < UNITS; ++u) error = std::max(error, std::abs(probabilities[u] - expected[u]));
+  EXPECT(error < 1e-5f);
+  const auto best = std::max_element(expected.begin(), expected.end());
+  EXPECT(label[0] == static_cast<int32_t>(best - expected.begin()));
+  EXPECT(std::abs(score[0] - *best) < 1e-5f);
+
+  // A missing input is an error rather than a run on stale data
+  bool thrown = false;
+  try {
+    backend->run({}, {{"prob", TensorView{probabilities.data(), FLOAT32, {UNITS}}}});
+  } catch (const std::exception&) {
+    thrown = true;
+  }
+  EXPECT(thrown);
+}
+
+void CheckReplay() {
+  // Two recorded frames, played back in a loop after a save/load round trip
+  ReplayModelBackend recorder;
+  const std::vector<float> boxes[2] = {{1.0f, 2.0f, 3.0f, 4.0f}, {5.0f, 6.0f, 7.0f, 8.0f}};
+  const std::vector<int32_t> classes[2] = {{3}, {7}};
+  constexpr auto FLOAT32 = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO;
+  constexpr auto INT32 = XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO;
+  for (int frame = 0; frame < 2; ++frame) {
+    recorder.record({{"boxes", ConstTensorView{boxes[frame].data(), FLOAT32, {4}}},
+                     {"classes", ConstTensorView{classes[frame].data(), INT32, {1}}}});
+  }
+  const auto path = std::filesystem::temp_directory_path() / "securemr_replay_test.bin";
+  recorder.save(path);
+  const std::shared_ptr<ReplayModelBackend> recording = ReplayModelBackend::Load(path);
+  std::filesystem::remove(path);
+  EXPECT(recording->frameCount() == 2);
+
+  // Registered by name, as a sample does for a model that needs the QNN SDK
+  ModelBackendRegistry::Default().registerFactory("yolo", [recording](const char*, size_t, const std::string&) {
+    return std::make_unique<ReplayModelBackend>(*recording);
+  });
+  const char qnnPackage[] = "not a reference network";
+  const auto replay = ModelBackendRegistry::Default().create(qnnPackage, sizeof(qnnPackage), "yolo");
+
+  std::vector<float> outBoxes(4);
+  std::vector<int32_t> outClasses(1);
+  bool matches = true;
+  for (int run = 0; run < 5; ++run) {
+    replay->run({}, {{"boxes", TensorView{outBoxes.data(), FLOAT32, {4}}},
+                     {"classes", TensorView{outClasses.data(), INT32, {1}}}});
+    matches = matches && outBoxes == boxes[run % 2] && outClasses == classes[run % 2];
+  }
+  EXPECT(matches);
+
+  // Without a factory, a package that is not a reference network has no host backend
+  bool thrown = false;
+  try {
+    ModelBackendRegistry::Default().create(qnnPackage, sizeof(qnnPackage), "pose");
+  } catch (const std::logic_error&) {
+    thrown = true;
+  }
+  EXPECT(thrown);
+}
+
+}  // namespace
+
+int main() {
+  CheckReferenceNetwork();
+  CheckReplay();
+  return Test::Finish("model");
+}
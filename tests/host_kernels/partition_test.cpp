@@ -0,0 +1,317 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+#include "partition.h"
+
+using namespace SecureMR;
+using SecureMR::Host::Test::Finish;
+
+namespace {
+
+Json Tensor(const std::vector<int>& dimensions, const bool placeholder = false, const int channels = 1,
+            const XrSecureMrTensorTypePICO usage = XR_SECURE_MR_TENSOR_TYPE_MAT_PICO,
+            const XrSecureMrTensorDataTypePICO dataType = XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO) {
+  Json tensor{{"dimensions", dimensions}, {"channels", channels}, {"usage", usage}, {"data_type", dataType}};
+  if (placeholder) tensor["is_placeholder"] = true;
+  return tensor;
+}
+
+Json Binding(const std::string& name, const std::string& role, const bool external) {
+  return {{"placeholder", name}, {"global", name}, {"role", role}, {"external", external}};
+}
+
+Json Operator(const std::string& type, const std::vector<std::string>& inputs,
+              const std::vector<std::string>& outputs) {
+  return {{"type", type}, {"inputs", inputs}, {"outputs", outputs}};
+}
+
+std::vector<std::string> OperatorTypes(const Json& stage) {
+  std::vector<std::string> types;
+  for (const auto& op : stage["pipeline"]["operators"]) types.push_back(op["type"].get<std::string>());
+  return types;
+}
+
+const Json* FindBinding(const Json& stage, const std::string& placeholder) {
+  for (const auto& binding : stage["bindings"]) {
+    if (binding["placeholder"] == placeholder) return &binding;
+  }
+  return nullptr;
+}
+
+bool HasBinding(const Json& stage, const std::string& name, const std::string& role, const bool external) {
+  const Json* binding = FindBinding(stage, name);
+  return binding != nullptr && (*binding)["global"] == name && (*binding)["role"] == role &&
+         (*binding)["external"] == external;
+}
+
+/**
+ * A chain of four operators costing 10, 10, 10 and 30, the third one writing a 4 MB tensor for the last one
+ */
+Json CostedChain() {
+  Json k = Tensor({1});
+  k["value"] = {2.0};
+  Json spec{{"tensors",
+             {{"frame", Tensor({1}, true)},
+              {"k", k},
+              {"a", Tensor({1})},
+              {"c", Tensor({1})},
+              {"b", Tensor({1000, 1000})},
+              {"out", Tensor({1})}}},
+            {"operators",
+             {Operator("arithmetic", {"frame", "k"}, {"a"}), Operator("arithmetic", {"a"}, {"c"}),
+              Operator("arithmetic", {"c"}, {"b"}), Operator("arithmetic", {"b", "k"}, {"out"})}},
+            {"outputs", {"out"}}};
+  for (const size_t i : {0u, 1u, 2u}) spec["operators"][i]["cost"] = 10.0;
+  spec["operators"][3]["cost"] = 30.0;
+  return spec;
+}
+
+void CheckCutPlacement() {
+  // Operator costs only: 10 + 10 + 10 against 30
+  PipelinePartitionOptions free;
+  free.costPerByte = 0.0;
+  const Json byCost = PartitionPipelineSpec(CostedChain(), free);
+  EXPECT(byCost["stages"].size() == 2);
+  EXPECT(byCost["stages"][0]["pipeline"]["operators"].size() == 3);
+  EXPECT(byCost["stages"][0]["cost"] == 30.0);
+  EXPECT(byCost["stages"][1]["cost"] == 30.0);
+  EXPECT(byCost["globals"].size() == 1 && byCost["globals"].contains("b"));
+
+  // Reading the 4 MB tensor from another stage costs 40 more, so the cut moves before its producer
+  const Json byBytes = PartitionPipelineSpec(CostedChain());
+  EXPECT(byBytes["stages"].size() == 2);
+  EXPECT(byBytes["stages"][0]["pipeline"]["operators"].size() == 2);
+  EXPECT(byBytes["stages"][0]["cost"] == 20.0);
+  EXPECT(byBytes["stages"][1]["cost"] == 40.0);
+
+  // A single stage when cutting does not lower the most expensive one
+  PipelinePartitionOptions one;
+  one.maxStagesPerRate = 1;
+  const Json whole = PartitionPipelineSpec(CostedChain(), one);
+  EXPECT(whole["stages"].size() == 1 && whole["stages"][0]["cost"] == 60.0);
+  EXPECT(whole["globals"].empty());
+  EXPECT(whole["stages"][0]["bindings"].size() == 1 && HasBinding(whole["stages"][0], "frame", "read", true));
+}
+
+void CheckCutEdge() {
+  const Json plan = PartitionPipelineSpec(CostedChain());
+  const Json& first = plan["stages"][0];
+  const Json& second = plan["stages"][1];
+  EXPECT(first["name"] == "stage0" && second["name"] == "stage1");
+
+  // The edge a -> c -> b is cut at c: a global tensor with the attributes of c, and a placeholder on both sides
+  EXPECT(plan["globals"].size() == 1 && plan["globals"].contains("c"));
+  EXPECT(plan["globals"]["c"] == Tensor({1}));
+  EXPECT(first["pipeline"]["tensors"]["c"].value("is_placeholder", false));
+  EXPECT(second["pipeline"]["tensors"]["c"].value("is_placeholder", false));
+  EXPECT(HasBinding(first, "c", "write", false));
+  EXPECT(HasBinding(second, "c", "read", false));
+  EXPECT(ParseTensorList(first["pipeline"]["outputs"]) == std::vector<std::string>{"c"});
+  EXPECT(ParseTensorList(second["pipeline"]["inputs"]) == std::vector<std::string>{"c"});
+
+  // The placeholder of the logical spec stays external, the locals stay local, the constant goes to both stages
+  EXPECT(first["bindings"].size() == 2 && HasBinding(first, "frame", "read", true));
+  EXPECT(second["bindings"].size() == 1);
+  EXPECT(ParseTensorList(first["pipeline"]["inputs"]) == std::vector<std::string>{"frame"});
+  EXPECT(!first["pipeline"]["tensors"]["a"].value("is_placeholder", false));
+  EXPECT(!second["pipeline"]["tensors"].contains("a") && !first["pipeline"]["tensors"].contains("b"));
+  EXPECT(first["pipeline"]["tensors"]["k"].contains("value") && second["pipeline"]["tensors"]["k"].contains("value"));
+  EXPECT(ParseTensorList(second["pipeline"]["outputs"]) == std::vector<std::string>{"out"});
+}
+
+void CheckRateGroups() {
+  // A 5 Hz branch declared first, a 30 Hz camera branch, and an operator joining both
+  Json camera = Operator("camera_access", {}, {"img"});
+  camera["rate_hz"] = 30.0f;
+  Json load = Operator("assignment", {}, {"x"});
+  load["rate_hz"] = 5.0f;
+  const Json spec{{"tensors",
+                   {{"x", Tensor({1})},
+                    {"img", Tensor({8, 8})},
+                    {"y", Tensor({1})},
+                    {"z", Tensor({1})},
+                    {"w", Tensor({1})}}},
+                  {"operators",
+                   {load, camera, Operator("arithmetic", {"img"}, {"y"}), Operator("run_algorithm", {"x"}, {"z"}),
+                    Operator("arithmetic", {"y", "z"}, {"w"})}}};
+  PipelinePartitionOptions one;
+  one.maxStagesPerRate = 1;
+  const Json plan = PartitionPipelineSpec(spec, one);
+  EXPECT(plan["stages"].size() == 2);
+
+  // Stages are in the order of their first operator, not by rate; unhinted operators run at their producers' rate
+  const Json& slow = plan["stages"][0];
+  const Json& fast = plan["stages"][1];
+  EXPECT(slow["rate_hz"] == 5.0f && fast["rate_hz"] == 30.0f);
+  EXPECT(OperatorTypes(slow) == (std::vector<std::string>{"assignment", "run_algorithm"}));
+  EXPECT(OperatorTypes(fast) == (std::vector<std::string>{"camera_access", "arithmetic", "arithmetic"}));
+  EXPECT(slow["cost"] == 102.0 && fast["cost"] == 14.0);
+
+  // Only the tensor crossing the rates is exchanged
+  EXPECT(plan["globals"].size() == 1 && plan["globals"].contains("z"));
+  EXPECT(HasBinding(slow, "z", "write", false) && HasBinding(fast, "z", "read", false));
+
+  // With two stages per rate, the model and the camera get stages of their own, still never mixing the rates
+  const Json cut = PartitionPipelineSpec(spec);
+  EXPECT(cut["stages"].size() == 4);
+  for (const auto& stage : cut["stages"]) {
+    const auto types = OperatorTypes(stage);
+    const bool slowStage = stage["rate_hz"] == 5.0f;
+    for (const auto& type : types) EXPECT(slowStage == (type == "assignment" || type == "run_algorithm"));
+  }
+  EXPECT(OperatorTypes(cut["stages"][1]) == std::vector<std::string>{"camera_access"});
+  EXPECT(OperatorTypes(cut["stages"][3]) == std::vector<std::string>{"run_algorithm"});
+}
+
+void CheckMergeRoundTrip() {
+  // The two stages of the costed chain hand c over at 30 Hz; merged, c is written once and read once less per run
+  const Json plan = PartitionPipelineSpec(CostedChain());
+  PipelineMergeReport report;
+  const Json merged = MergePartitionPlan(plan, {}, &report);
+  EXPECT(merged["stages"].size() == 1);
+  const Json& stage = merged["stages"][0];
+  EXPECT(stage["name"] == "stage0+stage1" && stage["rate_hz"] == 30.0f && stage["cost"] == 60.0);
+  EXPECT(stage["pipeline"]["operators"] == CostedChain()["operators"]);
+  EXPECT(stage["pipeline"]["tensors"]["c"] == Tensor({1}));
+  EXPECT(merged["globals"].empty());
+  EXPECT(stage["bindings"].size() == 1 && HasBinding(stage, "frame", "read", true));
+  EXPECT(report.mergedStages == 1);
+  EXPECT(report.submitsSavedPerSecond == 30.0);
+  EXPECT(report.bytesSavedPerSecond == 4.0 * 2 * 30.0);
+  EXPECT(report.internalizedGlobals == std::vector<std::string>{"c"});
+
+  // Nothing is merged past the cost bound
+  PipelineMergeOptions bounded;
+  bounded.maxStageCost = 50.0;
+  PipelineMergeReport none;
+  EXPECT(MergePartitionPlan(plan, bounded, &none) == plan);
+  EXPECT(none.mergedStages == 0 && none.bytesSavedPerSecond == 0.0 && none.internalizedGlobals.empty());
+}
+
+/**
+ * The 2D to 3D mapping and the rendering pipelines of the yolo sample, both submitted at 5 Hz, written by hand as a
+ * plan: the mapping hands the 3D points of the detected objects over to the rendering through a global tensor. The
+ * operator types name the <code>Pipeline</code> calls of the sample, as the merge only reads their tensors.
+ */
+Json YoloMappingAndRendering() {
+  constexpr int OBJECTS = 3;
+  const Json pointXYZ = Tensor({OBJECTS}, false, 3, XR_SECURE_MR_TENSOR_TYPE_POINT_PICO);
+  Json placeholderXYZ = pointXYZ;
+  placeholderXYZ["is_placeholder"] = true;
+  const Json timestamp =
+      Tensor({1}, true, 4, XR_SECURE_MR_TENSOR_TYPE_TIMESTAMP_PICO, XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO);
+  const Json image =
+      Tensor({640, 640}, true, 3, XR_SECURE_MR_TENSOR_TYPE_MAT_PICO, XR_SECURE_MR_TENSOR_DATA_TYPE_UINT8_PICO);
+  Json divider = Tensor({OBJECTS, 2});
+  divider["value"] = std::vector<float>(OBJECTS * 2, 2000.0f);
+  Json gltf{{"is_gltf", true}, {"is_placeholder", true}};
+
+  const Json mapping{
+      {"name", "map2d_to_3d"},
+      {"rate_hz", 5.0f},
+      {"cost", 7.0},
+      {"pipeline",
+       {{"tensors",
+         {{"nms_boxes", Tensor({OBJECTS, 4}, true)},
+          {"timestamp", timestamp},
+          {"camera_matrix", Tensor({3, 3}, true)},
+          {"left", image},
+          {"right", image},
+          {"image_point",
+           Tensor({OBJECTS}, false, 2, XR_SECURE_MR_TENSOR_TYPE_POINT_PICO, XR_SECURE_MR_TENSOR_DATA_TYPE_INT32_PICO)},
+          {"point_xyz", placeholderXYZ},
+          {"ratio", Tensor({OBJECTS, 2})},
+          {"divider", divider},
+          {"scale", Tensor({OBJECTS, 3}, true)}}},
+        {"operators",
+         {Operator("arithmetic", {"nms_boxes"}, {"image_point"}),
+          Operator("uv_to_cam", {"image_point", "timestamp", "camera_matrix", "left", "right"}, {"point_xyz"}),
+          Operator("arithmetic", {"nms_boxes", "divider"}, {"ratio"}), Operator("assignment", {"ratio"}, {"scale"})}},
+        {"inputs", {"nms_boxes", "timestamp", "camera_matrix", "left", "right"}},
+        {"outputs", {"point_xyz", "scale"}}}},
+      // The application initializes the depth of the scales, so that they stay a global tensor of its own
+      {"bindings",
+       {Binding("nms_boxes", "read", true), Binding("timestamp", "read", true), Binding("camera_matrix", "read", true),
+        Binding("left", "read", true), Binding("right", "read", true), Binding("point_xyz", "write", false),
+        Binding("scale", "write", true)}}};
+  const Json rendering{
+      {"name", "rendering"},
+      {"rate_hz", 5.0f},
+      {"cost", 3.0},
+      {"pipeline",
+       {{"tensors",
+         {{"point_xyz", placeholderXYZ},
+          {"timestamp", timestamp},
+          {"classes_select", Tensor({OBJECTS, 1}, true)},
+          {"scale", Tensor({OBJECTS, 3}, true)},
+          {"point0", Tensor({1, 3})},
+          {"gltf", gltf}}},
+        {"operators",
+         {Operator("assignment", {"point_xyz"}, {"point0"}),
+          Operator("render_gltf", {"point0", "scale", "classes_select", "timestamp", "gltf"}, {"gltf"})}},
+        {"inputs", {"point_xyz", "timestamp", "classes_select", "scale", "gltf"}},
+        {"outputs", {"gltf"}}}},
+      {"bindings",
+       {Binding("point_xyz", "read", false), Binding("timestamp", "read", true),
+        Binding("classes_select", "read", true), Binding("scale", "read", true),
+        Binding("gltf", "read_write", true)}}};
+  return {{"globals", {{"point_xyz", pointXYZ}}}, {"stages", {mapping, rendering}}};
+}
+
+void CheckMergeYoloChain() {
+  PipelineMergeReport report;
+  const Json merged = MergePartitionPlan(YoloMappingAndRendering(), {}, &report);
+  EXPECT(merged["stages"].size() == 1 && merged["globals"].empty());
+  const Json& stage = merged["stages"][0];
+  EXPECT(stage["name"] == "map2d_to_3d+rendering" && stage["rate_hz"] == 5.0f && stage["cost"] == 10.0);
+  EXPECT(OperatorTypes(stage) == (std::vector<std::string>{"arithmetic", "uv_to_cam", "arithmetic", "assignment",
+                                                           "assignment", "render_gltf"}));
+
+  // The 3D points became a local tensor; every global tensor of the application is still bound
+  const Json& tensors = stage["pipeline"]["tensors"];
+  EXPECT(tensors["point_xyz"] == YoloMappingAndRendering()["globals"]["point_xyz"]);
+  EXPECT(FindBinding(stage, "point_xyz") == nullptr);
+  EXPECT(stage["bindings"].size() == 8);
+  EXPECT(HasBinding(stage, "scale", "read_write", true) && HasBinding(stage, "gltf", "read_write", true));
+  EXPECT(HasBinding(stage, "timestamp", "read", true) && HasBinding(stage, "classes_select", "read", true));
+  for (const auto& binding : stage["bindings"]) {
+    EXPECT(tensors[binding["placeholder"].get<std::string>()].value("is_placeholder", false));
+  }
+  const auto inputs = ParseTensorList(stage["pipeline"]["inputs"]);
+  const auto outputs = ParseTensorList(stage["pipeline"]["outputs"]);
+  EXPECT(std::find(inputs.begin(), inputs.end(), "point_xyz") == inputs.end());
+  EXPECT(std::find(outputs.begin(), outputs.end(), "point_xyz") == outputs.end());
+
+  // One submission fewer per run, and the 36 bytes of 3D points neither written to nor read from a global tensor
+  EXPECT(report.mergedStages == 1);
+  EXPECT(report.submitsSavedPerSecond == 5.0);
+  EXPECT(report.bytesSavedPerSecond == 36.0 * 2 * 5.0);
+  EXPECT(report.internalizedGlobals == std::vector<std::string>{"point_xyz"});
+}
+
+}  // namespace
+
+int main() {
+  CheckCutPlacement();
+  CheckCutEdge();
+  CheckRateGroups();
+  CheckMergeRoundTrip();
+  CheckMergeYoloChain();
+  return Finish("partition");
+}
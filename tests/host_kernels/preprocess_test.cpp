@@ -0,0 +1,149 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <string>
+#include <tuple>
+
+#include "test_util.h"
+#include "host/expression.h"
+#include "host/preprocess.h"
+
+using namespace SecureMR::Host;
+
+namespace {
+
+/**
+ * <code>Pipeline::cvtColor</code> as OpenCV defines it for the supported codes, on an interleaved uint8 image
+ */
+std::vector<uint8_t> ReferenceCvtColor(const std::vector<uint8_t>& src, const size_t pixels, const size_t srcChannels,
+                                       const int code, size_t& dstChannels) {
+  // Source channel of each destination channel, -1 for an opaque alpha
+  std::vector<int> source;
+  switch (code) {
+    case -1:
+      for (size_t c = 0; c < srcChannels; ++c) source.push_back(static_cast<int>(c));
+      break;
+    case 0: source = {0, 1, 2, -1}; break;
+    case 1: source = {0, 1, 2}; break;
+    case 2: source = {2, 1, 0, -1}; break;
+    case 3: source = {2, 1, 0}; break;
+    case 4: source = {2, 1, 0}; break;
+    case 5: source = {2, 1, 0, 3}; break;
+    default: break;
+  }
+
+  std::vector<uint8_t> dst;
+  if (!source.empty()) {
+    dstChannels = source.size();
+    dst.resize(pixels * dstChannels);
+    for (size_t i = 0; i < pixels; ++i) {
+      for (size_t c = 0; c < dstChannels; ++c) {
+        dst[i * dstChannels + c] = source[c] < 0 ? 255 : src[i * srcChannels + source[c]];
+      }
+    }
+    return dst;
+  }
+
+  // Gray: OpenCV's 14-bit fixed-point weights of 0.299 R + 0.587 G + 0.114 B, rounded
+  const bool bgr = code == 6 || code == 10;
+  dstChannels = 1;
+  dst.resize(pixels);
+  for (size_t i = 0; i < pixels; ++i) {
+    const uint8_t* pixel = &src[i * srcChannels];
+    const int32_t r = pixel[bgr ? 2 : 0], g = pixel[1], b = pixel[bgr ? 0 : 2];
+    dst[i] = static_cast<uint8_t>((r * 4899 + g * 9617 + b * 1868 + (1 << 13)) >> 14);
+  }
+  return dst;
+}
+
+/**
+ * The operator chain <code>PreprocessImage</code> replaces: cvtColor, conversion to float, the normalizing
+ * arithmetic expression and, for planar output, the HWC to CHW transpose
+ */
+std::vector<float> ReferenceChain(const std::vector<uint8_t>& src, const size_t width, const size_t height,
+                                  const size_t srcChannels, const int code, const std::string& expression,
+                                  const bool planar) {
+  size_t channels = 0;
+  const auto converted = ReferenceCvtColor(src, width * height, srcChannels, code, channels);
+  const std::vector<float> asFloat(converted.begin(), converted.end());
+  std::vector<float> normalized(asFloat.size());
+  const std::vector<size_t> shape = {height, width, channels};
+  ExpressionProgram::Compile(expression)
+      .evaluate({ConstTensorView{asFloat.data(), XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO, shape}},
+                TensorView{normalized.data(), XR_SECURE_MR_TENSOR_DATA_TYPE_FLOAT32_PICO, shape});
+  if (!planar) return normalized;
+
+  std::vector<float> transposed(normalized.size());
+  for (size_t i = 0; i < width * height; ++i) {
+    for (size_t c = 0; c < channels; ++c) transposed[c * width * height + i] = normalized[i * channels + c];
+  }
+  return transposed;
+}
+
+bool BitIdentical(const std::vector<float>& a, const std::vector<float>& b) {
+  return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+}  // namespace
+
+int main() {
+  ThreadPool pool(3);
+  const size_t width = 37, height = 23;
+
+  // {0} / 255.0 and ({0} - 127.5) / 127.5, the normalizations of the samples, as mean and standard deviation
+  const std::vector<std::tuple<std::string, float, float>> normalizations = {
+      {"{0} / 255.0", 0.0f, 255.0f}, {"({0} - 127.5) / 127.5", 127.5f, 127.5f}, {"({0} - 3.0) / 7.0", 3.0f, 7.0f}};
+  const std::vector<std::pair<int, size_t>> conversions = {{-1, 3}, {-1, 1}, {0, 3}, {1, 4}, {2, 3}, {3, 4},
+                                                           {4, 3},  {5, 4},  {6, 3}, {7, 3}, {10, 4}, {11, 4}};
+
+  for (const auto& [code, srcChannels] : conversions) {
+    const auto image = Test::RandomValues<uint8_t>(width * height * srcChannels, 0, 255, code + 10);
+    for (const auto& [expression, mean, stddev] : normalizations) {
+      for (const bool planar : {false, true}) {
+        PreprocessParams params;
+        params.cvtColorFlag = code;
+        params.mean.fill(mean);
+        params.stddev.fill(stddev);
+        params.planarOutput = planar;
+        const size_t channels = PreprocessOutputChannels(srcChannels, params);
+        std::vector<float> fused(width * height * channels);
+        PreprocessImage(image.data(), width, height, srcChannels, params, fused.data(), pool);
+        EXPECT(BitIdentical(fused, ReferenceChain(image, width, height, srcChannels, code, expression, planar)));
+      }
+    }
+  }
+
+  // Per-channel statistics, against the same float32 arithmetic done one element at a time
+  const auto image = Test::RandomValues<uint8_t>(width * height * 3, 0, 255);
+  PreprocessParams params;
+  params.cvtColorFlag = 4;
+  params.mean = {123.675f, 116.28f, 103.53f, 0.0f};
+  params.stddev = {58.395f, 57.12f, 57.375f, 1.0f};
+  std::vector<float> fused(width * height * 3);
+  PreprocessImage(image.data(), width, height, 3, params, fused.data(), pool);
+  std::vector<float> expected(fused.size());
+  for (size_t i = 0; i < width * height; ++i) {
+    for (size_t c = 0; c < 3; ++c) {
+      expected[i * 3 + c] = (static_cast<float>(image[i * 3 + 2 - c]) - params.mean[c]) / params.stddev[c];
+    }
+  }
+  EXPECT(BitIdentical(fused, expected));
+
+  // Unsupported combinations are reported as 0 output channels
+  params.cvtColorFlag = 1;
+  EXPECT(PreprocessOutputChannels(3, params) == 0);
+
+  return Test::Finish("preprocess");
+}
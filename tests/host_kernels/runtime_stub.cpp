@@ -0,0 +1,35 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Stands in for the OpenXR loader and the logger of the samples, so that the plan-level functions of
+// securemr_utils, which never reach the runtime, can be linked and tested on the desktop
+
+#include <cstdio>
+#include <string>
+
+#include "logger.h"
+#include "openxr/openxr.h"
+
+namespace Log {
+void SetLevel(Level) {}
+
+void Write(const Level severity, const std::string& msg) {
+  if (severity >= Level::Warning) std::fprintf(stderr, "%s\n", msg.c_str());
+}
+}  // namespace Log
+
+extern "C" XrResult xrGetInstanceProcAddr(XrInstance, const char*, PFN_xrVoidFunction* function) {
+  *function = nullptr;
+  return XR_ERROR_FUNCTION_UNSUPPORTED;
+}
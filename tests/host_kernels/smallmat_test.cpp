@@ -0,0 +1,230 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "test_util.h"
+#include "host/smallmat.h"
+
+using namespace SecureMR::Host;
+
+namespace {
+
+template <int N>
+std::vector<float> Multiply(const float* a, const float* b) {
+  std::vector<float> product(N * N, 0.0f);
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      for (int k = 0; k < N; ++k) product[i * N + j] += a[i * N + k] * b[k * N + j];
+    }
+  }
+  return product;
+}
+
+float MaxDifference(const float* a, const float* b, const size_t count) {
+  float difference = 0.0f;
+  for (size_t i = 0; i < count; ++i) difference = std::max(difference, std::abs(a[i] - b[i]));
+  return difference;
+}
+
+/**
+ * Rotation of angle <code>|r|</code> around the axis <code>r / |r|</code> by the Rodrigues formula, in double
+ */
+std::vector<double> ReferenceRotation(const float rvec[3]) {
+  const double angle = std::sqrt(double{rvec[0]} * rvec[0] + double{rvec[1]} * rvec[1] + double{rvec[2]} * rvec[2]);
+  std::vector<double> rotation = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  if (angle == 0.0) return rotation;
+  const double k[3] = {rvec[0] / angle, rvec[1] / angle, rvec[2] / angle};
+  const double c = std::cos(angle), s = std::sin(angle);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) rotation[i * 3 + j] = c * (i == j) + (1 - c) * k[i] * k[j];
+  }
+  rotation[1] -= s * k[2];
+  rotation[2] += s * k[1];
+  rotation[3] += s * k[2];
+  rotation[5] -= s * k[0];
+  rotation[6] -= s * k[1];
+  rotation[7] += s * k[0];
+  return rotation;
+}
+
+template <int N>
+void CheckInvert(ThreadPool& pool) {
+  constexpr size_t count = 64;
+  // Diagonally dominant, hence well conditioned, matrices
+  auto matrices = Test::RandomValues<float>(count * N * N, -1.0f, 1.0f, N);
+  for (size_t m = 0; m < count; ++m) {
+    for (int i = 0; i < N; ++i) matrices[m * N * N + i * N + i] += static_cast<float>(N) + 1.0f;
+  }
+  std::vector<float> inverses(matrices.size());
+  EXPECT(InvertBatch<N>(matrices.data(), inverses.data(), count, pool) == 0);
+
+  std::vector<float> identity(N * N, 0.0f);
+  for (int i = 0; i < N; ++i) identity[i * N + i] = 1.0f;
+  float error = 0.0f;
+  for (size_t m = 0; m < count; ++m) {
+    const auto product = Multiply<N>(&matrices[m * N * N], &inverses[m * N * N]);
+    error = std::max(error, MaxDifference(product.data(), identity.data(), N * N));
+  }
+  EXPECT(error < 1e-5f);
+
+  // A singular matrix is reported and zero-filled
+  std::vector<float> singular(N * N, 1.0f), inverse(N * N, 7.0f);
+  EXPECT(!Invert<N>(singular.data(), inverse.data()));
+  EXPECT(MaxDifference(inverse.data(), std::vector<float>(N * N, 0.0f).data(), N * N) == 0.0f);
+}
+
+template <int N>
+void CheckSvd(ThreadPool& pool) {
+  constexpr size_t count = 64;
+  const auto matrices = Test::RandomValues<float>(count * N * N, -2.0f, 2.0f, 10 + N);
+  std::vector<float> w(count * N), u(count * N * N), vt(count * N * N);
+  SvdBatch<N>(matrices.data(), w.data(), u.data(), vt.data(), count, pool);
+
+  float reconstructionError = 0.0f, orthogonalityError = 0.0f;
+  bool descending = true;
+  std::vector<float> identity(N * N, 0.0f);
+  for (int i = 0; i < N; ++i) identity[i * N + i] = 1.0f;
+  for (size_t m = 0; m < count; ++m) {
+    std::vector<float> uw(N * N), ut(N * N);
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) {
+        uw[i * N + j] = u[m * N * N + i * N + j] * w[m * N + j];
+        ut[i * N + j] = u[m * N * N + j * N + i];
+      }
+      descending = descending && w[m * N + i] >= 0.0f && (i == 0 || w[m * N + i] <= w[m * N + i - 1]);
+    }
+    const auto reconstructed = Multiply<N>(uw.data(), &vt[m * N * N]);
+    reconstructionError =
+        std::max(reconstructionError, MaxDifference(reconstructed.data(), &matrices[m * N * N], N * N));
+    const auto utu = Multiply<N>(ut.data(), &u[m * N * N]);
+    orthogonalityError = std::max(orthogonalityError, MaxDifference(utu.data(), identity.data(), N * N));
+  }
+  EXPECT(descending);
+  EXPECT(reconstructionError < 1e-4f);
+  EXPECT(orthogonalityError < 1e-4f);
+}
+
+template <int N>
+void CheckMultiply(ThreadPool& pool) {
+  constexpr size_t count = 32;
+  const auto a = Test::RandomValues<float>(count * N * N, -1.0f, 1.0f, 20 + N);
+  const auto b = Test::RandomValues<float>(count * N * N, -1.0f, 1.0f, 30 + N);
+  std::vector<float> products(count * N * N), broadcast(count * N * N);
+  MultiplyBatch<N>(a.data(), count, b.data(), count, products.data(), pool);
+  MultiplyBatch<N>(a.data(), 1, b.data(), count, broadcast.data(), pool);
+  float error = 0.0f;
+  for (size_t m = 0; m < count; ++m) {
+    const auto product = Multiply<N>(&a[m * N * N], &b[m * N * N]);
+    const auto broadcastProduct = Multiply<N>(a.data(), &b[m * N * N]);
+    error = std::max(error, MaxDifference(product.data(), &products[m * N * N], N * N));
+    error = std::max(error, MaxDifference(broadcastProduct.data(), &broadcast[m * N * N], N * N));
+  }
+  EXPECT(error < 1e-6f);
+}
+
+void CheckTransform(ThreadPool& pool) {
+  constexpr size_t count = 13;
+  const auto rvecs = Test::RandomValues<float>(count * 3, -2.0f, 2.0f, 40);
+  const auto tvecs = Test::RandomValues<float>(count * 3, -5.0f, 5.0f, 41);
+  const float scale[3] = {0.5f, 2.0f, 1.5f};
+  std::vector<float> results(count * 16);
+  // One shared scale, as for the skeleton nodes
+  TransformBatch(rvecs.data(), count, tvecs.data(), count, scale, 1, results.data(), count, pool);
+
+  float error = 0.0f;
+  for (size_t m = 0; m < count; ++m) {
+    const auto rotation = ReferenceRotation(&rvecs[m * 3]);
+    std::vector<float> expected(16, 0.0f);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) expected[i * 4 + j] = static_cast<float>(rotation[i * 3 + j] * scale[j]);
+      expected[i * 4 + 3] = tvecs[m * 3 + i];
+    }
+    expected[15] = 1.0f;
+    error = std::max(error, MaxDifference(expected.data(), &results[m * 16], 16));
+  }
+  EXPECT(error < 1e-5f);
+
+  // Without a scale, and for the zero rotation
+  const float zero[3] = {0.0f, 0.0f, 0.0f}, t[3] = {1.0f, 2.0f, 3.0f};
+  float single[16];
+  Transform(zero, t, nullptr, single);
+  const float expected[16] = {1, 0, 0, 1, 0, 1, 0, 2, 0, 0, 1, 3, 0, 0, 0, 1};
+  EXPECT(MaxDifference(single, expected, 16) < 1e-7f);
+}
+
+/**
+ * Project object points with a known pose and check that <code>SolvePnP</code> recovers it
+ */
+void CheckSolvePnP(const bool planar, ThreadPool& pool) {
+  const float cameraMatrix[9] = {500.0f, 0.0f, 320.0f, 0.0f, 500.0f, 240.0f, 0.0f, 0.0f, 1.0f};
+  const float rvec[3] = {0.2f, -0.3f, 0.1f}, tvec[3] = {0.1f, -0.05f, 2.0f};
+  constexpr size_t pointCount = 8, count = 4;
+  auto objectPoints = Test::RandomValues<float>(pointCount * 3, -0.5f, 0.5f, planar ? 50 : 51);
+  if (planar) {
+    for (size_t i = 0; i < pointCount; ++i) objectPoints[i * 3 + 2] = 0.0f;
+  }
+
+  const auto rotation = ReferenceRotation(rvec);
+  std::vector<float> imagePoints(pointCount * 2);
+  for (size_t i = 0; i < pointCount; ++i) {
+    double camera[3];
+    for (int r = 0; r < 3; ++r) {
+      camera[r] = tvec[r];
+      for (int c = 0; c < 3; ++c) camera[r] += rotation[r * 3 + c] * objectPoints[i * 3 + c];
+    }
+    imagePoints[i * 2] = static_cast<float>(cameraMatrix[0] * camera[0] / camera[2] + cameraMatrix[2]);
+    imagePoints[i * 2 + 1] = static_cast<float>(cameraMatrix[4] * camera[1] / camera[2] + cameraMatrix[5]);
+  }
+
+  // The same problem in every batch slot
+  std::vector<float> batchObjects, batchImages;
+  for (size_t m = 0; m < count; ++m) {
+    batchObjects.insert(batchObjects.end(), objectPoints.begin(), objectPoints.end());
+    batchImages.insert(batchImages.end(), imagePoints.begin(), imagePoints.end());
+  }
+  std::vector<float> rvecs(count * 3), tvecs(count * 3);
+  EXPECT(SolvePnPBatch(batchObjects.data(), batchImages.data(), pointCount, cameraMatrix, rvecs.data(), tvecs.data(),
+                       count, pool) == 0);
+  for (size_t m = 0; m < count; ++m) {
+    EXPECT(MaxDifference(&rvecs[m * 3], rvec, 3) < 1e-3f);
+    EXPECT(MaxDifference(&tvecs[m * 3], tvec, 3) < 1e-3f);
+  }
+
+  // Fewer than 4 points cannot be solved
+  float r[3], t[3];
+  EXPECT(!SolvePnP(objectPoints.data(), imagePoints.data(), 3, cameraMatrix, r, t));
+}
+
+}  // namespace
+
+int main() {
+  ThreadPool pool(3);
+
+  CheckInvert<2>(pool);
+  CheckInvert<3>(pool);
+  CheckInvert<4>(pool);
+  CheckSvd<2>(pool);
+  CheckSvd<3>(pool);
+  CheckSvd<4>(pool);
+  CheckMultiply<2>(pool);
+  CheckMultiply<3>(pool);
+  CheckMultiply<4>(pool);
+  CheckTransform(pool);
+  CheckSolvePnP(false, pool);
+  CheckSolvePnP(true, pool);
+
+  return Test::Finish("smallmat");
+}
@@ -0,0 +1,184 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "test_util.h"
+#include "host/sort.h"
+
+using namespace SecureMR::Host;
+
+namespace {
+
+/**
+ * Descending stable sort by std::sort, the semantics the kernels promise: ties keep the smaller index first
+ */
+template <typename T>
+void ReferenceSort(const std::vector<T>& values, const size_t topK, std::vector<T>& sorted,
+                   std::vector<int32_t>& indices) {
+  std::vector<int32_t> order(values.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](const int32_t a, const int32_t b) {
+    return values[a] > values[b] || (values[a] == values[b] && a < b);
+  });
+  const size_t k = topK == 0 ? values.size() : std::min(topK, values.size());
+  order.resize(k);
+  sorted.resize(k);
+  for (size_t i = 0; i < k; ++i) sorted[i] = values[order[i]];
+  indices = order;
+}
+
+template <typename T>
+void CheckVec(const size_t n, const size_t topK, const T low, const T high) {
+  const auto values = Test::RandomValues<T>(n, low, high, static_cast<uint32_t>(n * 31 + topK));
+  std::vector<T> expectedSorted;
+  std::vector<int32_t> expectedIndices;
+  ReferenceSort(values, topK, expectedSorted, expectedIndices);
+
+  std::vector<T> sorted(expectedSorted.size());
+  std::vector<int32_t> indices(expectedSorted.size());
+  SortVec(values.data(), n, sorted.data(), indices.data(), topK);
+  EXPECT(sorted == expectedSorted);
+  EXPECT(indices == expectedIndices);
+}
+
+template <typename T>
+void CheckRows(const size_t rows, const size_t cols, const size_t topK, const T low, const T high,
+               ThreadPool& pool) {
+  const auto values = Test::RandomValues<T>(rows * cols, low, high, static_cast<uint32_t>(rows + cols + topK));
+  const size_t k = topK == 0 ? cols : std::min(topK, cols);
+  std::vector<T> sorted(rows * k);
+  std::vector<int32_t> indices(rows * k);
+  SortMatByRow(values.data(), rows, cols, sorted.data(), indices.data(), topK, pool);
+
+  bool matches = true;
+  for (size_t r = 0; r < rows; ++r) {
+    const std::vector<T> row(values.begin() + r * cols, values.begin() + (r + 1) * cols);
+    std::vector<T> expectedSorted;
+    std::vector<int32_t> expectedIndices;
+    ReferenceSort(row, topK, expectedSorted, expectedIndices);
+    matches = matches && std::equal(expectedSorted.begin(), expectedSorted.end(), sorted.begin() + r * k) &&
+              std::equal(expectedIndices.begin(), expectedIndices.end(), indices.begin() + r * k);
+  }
+  EXPECT(matches);
+}
+
+template <typename T>
+void CheckColumns(const size_t rows, const size_t cols, const size_t topK, const T low, const T high,
+                  ThreadPool& pool) {
+  const auto values = Test::RandomValues<T>(rows * cols, low, high, static_cast<uint32_t>(rows * cols + topK));
+  const size_t k = topK == 0 ? rows : std::min(topK, rows);
+  std::vector<T> sorted(k * cols);
+  std::vector<int32_t> indices(k * cols);
+  SortMatByColumn(values.data(), rows, cols, sorted.data(), indices.data(), topK, pool);
+
+  bool matches = true;
+  for (size_t c = 0; c < cols; ++c) {
+    std::vector<T> column(rows);
+    for (size_t r = 0; r < rows; ++r) column[r] = values[r * cols + c];
+    std::vector<T> expectedSorted;
+    std::vector<int32_t> expectedIndices;
+    ReferenceSort(column, topK, expectedSorted, expectedIndices);
+    for (size_t r = 0; r < k; ++r) {
+      matches = matches && sorted[r * cols + c] == expectedSorted[r] && indices[r * cols + c] == expectedIndices[r];
+    }
+  }
+  EXPECT(matches);
+}
+
+/**
+ * Indices of a row in the order the kernels promise with NaN: the other values descending, then the NaNs
+ */
+std::vector<int32_t> OrderWithNaN(const float* values, const size_t n) {
+  std::vector<int32_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](const int32_t a, const int32_t b) {
+    return !std::isnan(values[a]) && (std::isnan(values[b]) || values[a] > values[b]);
+  });
+  return order;
+}
+
+void CheckNaN(ThreadPool& pool) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float values[] = {0.5f, nan, 2.0f, nan, -std::numeric_limits<float>::infinity(), 1.0f};
+  std::vector<float> sorted(6);
+  std::vector<int32_t> indices(6);
+  SortVec(values, 6, sorted.data(), indices.data(), 0);
+  EXPECT(indices == (std::vector<int32_t>{2, 5, 0, 4, 1, 3}));
+  SortVec(values, 6, sorted.data(), indices.data(), 3);
+  EXPECT(std::vector<int32_t>(indices.begin(), indices.begin() + 3) == (std::vector<int32_t>{2, 5, 0}));
+
+  // The argmax skips a leading NaN
+  const float leading[] = {nan, 0.1f, -1.0f};
+  SortVec(leading, 3, sorted.data(), indices.data(), 1);
+  EXPECT(indices[0] == 1 && sorted[0] == 0.1f);
+
+  // Rows short enough for the sorting network, with NaNs in some of them
+  for (const size_t topK : {0u, 1u, 3u}) {
+    constexpr size_t ROWS = 9, COLS = 5;
+    auto matrix = Test::RandomValues<float>(ROWS * COLS, -1.0f, 1.0f, 0x7a7a);
+    matrix[2 * COLS + 1] = nan;
+    matrix[5 * COLS + 4] = nan;
+    matrix[5 * COLS + 0] = nan;
+    matrix[8 * COLS + 3] = nan;
+    const size_t k = topK == 0 ? COLS : topK;
+    std::vector<int32_t> rowIndices(ROWS * k);
+    SortMatByRow(matrix.data(), ROWS, COLS, static_cast<float*>(nullptr), rowIndices.data(), topK, pool);
+    bool matches = true;
+    for (size_t r = 0; r < ROWS; ++r) {
+      const auto expected = OrderWithNaN(matrix.data() + r * COLS, COLS);
+      matches = matches && std::equal(expected.begin(), expected.begin() + k, rowIndices.begin() + r * k);
+    }
+    EXPECT(matches);
+  }
+}
+
+}  // namespace
+
+int main() {
+  ThreadPool pool(3);
+
+  for (const size_t n : {1u, 2u, 15u, 16u, 17u, 100u, 4096u}) {
+    for (const size_t topK : {0u, 1u, 5u}) {
+      CheckVec<float>(n, topK, -1.0f, 1.0f);
+      // Narrow ranges force ties
+      CheckVec<uint8_t>(n, topK, 0, 3);
+      CheckVec<int16_t>(n, topK, -100, 100);
+      CheckVec<int32_t>(n, topK, -2, 2);
+    }
+  }
+
+  // Rows of at most 16 floats take the SIMD sorting network, longer ones the generic path
+  for (const size_t cols : {1u, 3u, 4u, 8u, 13u, 16u, 17u, 80u}) {
+    for (const size_t topK : {0u, 1u, 4u}) {
+      CheckRows<float>(37, cols, topK, 0.0f, 1.0f, pool);
+      CheckRows<float>(37, cols, topK, 0.0f, 0.0f, pool);
+      CheckRows<uint8_t>(37, cols, topK, 0, 5, pool);
+      CheckRows<double>(37, cols, topK, -1.0, 1.0, pool);
+    }
+  }
+  CheckRows<float>(8400, 80, 1, 0.0f, 1.0f, pool);
+
+  for (const size_t topK : {0u, 1u, 10u}) {
+    CheckColumns<float>(50, 7, topK, -1.0f, 1.0f, pool);
+    CheckColumns<int8_t>(50, 7, topK, -3, 3, pool);
+  }
+
+  CheckNaN(pool);
+
+  return Test::Finish("sort");
+}
@@ -0,0 +1,69 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+
+#include "test_util.h"
+#include "host/stereo.h"
+
+using namespace SecureMR::Host;
+
+int main() {
+  ThreadPool pool(3);
+
+  // A rectified pair of a fronto-parallel textured plane: the right eye sees every pixel shifted left by 12 pixels
+  constexpr size_t width = 160, height = 96, channels = 3;
+  constexpr int disparity = 12;
+  const auto texture = Test::RandomValues<uint8_t>(width * height, 0, 255);
+  const auto noise = Test::RandomValues<uint8_t>(width * height, 0, 255, 77);
+  std::vector<uint8_t> left(width * height * channels), right(width * height * channels);
+  for (size_t y = 0; y < height; ++y) {
+    for (size_t x = 0; x < width; ++x) {
+      const uint8_t rightValue = x + disparity < width ? texture[y * width + x + disparity] : noise[y * width + x];
+      for (size_t c = 0; c < channels; ++c) {
+        left[(y * width + x) * channels + c] = texture[y * width + x];
+        right[(y * width + x) * channels + c] = rightValue;
+      }
+    }
+  }
+
+  const float cameraMatrix[9] = {200.0f, 0.0f, 80.0f, 0.0f, 210.0f, 48.0f, 0.0f, 0.0f, 1.0f};
+  const StereoMatchConfig config{.baseline = 0.064f, .maxDisparity = 32, .blockRadius = 3};
+  // Interior points first, then points too close to the border for a full block or for any positive disparity
+  const std::vector<int32_t> uv = {40, 20, 100, 50, 150, 80, 20, 10, 60, 3, 1, 50, 158, 40, 3, 30};
+  const size_t interiorCount = 5, pointCount = uv.size() / 2;
+  std::vector<float> xyz(pointCount * 3, -1.0f);
+  Uv2Cam(uv.data(), pointCount, cameraMatrix, StereoImage{left.data(), width, height, channels},
+         StereoImage{right.data(), width, height, channels}, config, xyz.data(), pool);
+
+  // The reference back-projection of the known disparity
+  for (size_t i = 0; i < interiorCount; ++i) {
+    const float z = cameraMatrix[0] * config.baseline / disparity;
+    const float x = (static_cast<float>(uv[2 * i]) - cameraMatrix[2]) * z / cameraMatrix[0];
+    const float y = (static_cast<float>(uv[2 * i + 1]) - cameraMatrix[5]) * z / cameraMatrix[4];
+    EXPECT(std::abs(xyz[3 * i + 2] - z) < 0.01f * z);
+    EXPECT(std::abs(xyz[3 * i] - x) < 0.01f * std::max(std::abs(x), z));
+    EXPECT(std::abs(xyz[3 * i + 1] - y) < 0.01f * std::max(std::abs(y), z));
+  }
+  for (size_t i = interiorCount; i < pointCount; ++i) {
+    EXPECT(xyz[3 * i] == 0.0f && xyz[3 * i + 1] == 0.0f && xyz[3 * i + 2] == 0.0f);
+  }
+
+  // A slanted plane, against the dense full-frame block matcher with the same cost
+  const auto benchmark = BenchmarkUv2Cam(320, 240, 200, 1, config);
+  EXPECT(benchmark.agreementWithDense == 1.0);
+  EXPECT(benchmark.meanDisparityError < 0.5);
+
+  return Test::Finish("stereo");
+}
@@ -0,0 +1,67 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SECUREMR_TESTS_HOST_KERNELS_TEST_UTIL_H_
+#define SECUREMR_TESTS_HOST_KERNELS_TEST_UTIL_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace SecureMR::Host::Test {
+
+inline int g_failures = 0;
+
+/**
+ * Values drawn uniformly from <code>[low, high]</code>, the same sequence for the same seed
+ */
+template <typename T>
+std::vector<T> RandomValues(const size_t count, const T low, const T high, const uint32_t seed = 0x5ec3e) {
+  std::mt19937 rng(seed);
+  std::vector<T> values(count);
+  if constexpr (std::is_floating_point_v<T>) {
+    std::uniform_real_distribution<T> distribution(low, high);
+    for (auto& value : values) value = distribution(rng);
+  } else {
+    std::uniform_int_distribution<int64_t> distribution(low, high);
+    for (auto& value : values) value = static_cast<T>(distribution(rng));
+  }
+  return values;
+}
+
+/**
+ * The exit code of a test: 0 if no expectation failed
+ */
+inline int Finish(const char* name) {
+  if (g_failures == 0) {
+    std::printf("%s: passed\n", name);
+    return 0;
+  }
+  std::printf("%s: %d expectations failed\n", name, g_failures);
+  return 1;
+}
+
+}  // namespace SecureMR::Host::Test
+
+#define EXPECT(condition)                                                                        \
+  do {                                                                                           \
+    if (!(condition)) {                                                                          \
+      std::fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__, #condition);              \
+      ++SecureMR::Host::Test::g_failures;                                                        \
+    }                                                                                            \
+  } while (false)
+
+#endif  // SECUREMR_TESTS_HOST_KERNELS_TEST_UTIL_H_
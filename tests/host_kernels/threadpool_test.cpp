@@ -0,0 +1,90 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <stdexcept>
+
+#include "test_util.h"
+#include "host/threadpool.h"
+
+using namespace SecureMR::Host;
+
+int main() {
+  ThreadPool pool(3);
+
+  // Every index is visited exactly once, whatever the grain
+  for (const size_t grain : {1u, 7u, 1000u, 5000u}) {
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(0, visits.size(), grain, [&](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; ++i) visits[i]++;
+    });
+    bool once = true;
+    for (const auto& visit : visits) once = once && visit == 1;
+    EXPECT(once);
+  }
+
+  // An empty range never calls the body
+  bool called = false;
+  pool.parallelFor(5, 5, 1, [&](size_t, size_t) { called = true; });
+  EXPECT(!called);
+
+  // A nested parallelFor runs inline instead of waiting on the busy workers
+  std::atomic<size_t> nestedSum{0};
+  pool.parallelFor(0, 8, 1, [&](const size_t outerBegin, const size_t outerEnd) {
+    for (size_t outer = outerBegin; outer < outerEnd; ++outer) {
+      pool.parallelFor(0, 100, 10, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) nestedSum += i;
+      });
+    }
+  });
+  EXPECT(nestedSum == 8 * 4950);
+
+  // Running a job of another pool from a chunk does not lose track of the pool of the chunk: a parallelFor on it
+  // afterwards still runs inline instead of deadlocking on its busy workers
+  ThreadPool otherPool(2);
+  std::atomic<size_t> mixedSum{0};
+  pool.parallelFor(0, 8, 1, [&](const size_t outerBegin, const size_t outerEnd) {
+    for (size_t outer = outerBegin; outer < outerEnd; ++outer) {
+      otherPool.parallelFor(0, 100, 10, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) mixedSum += i;
+      });
+      pool.parallelFor(0, 100, 10, [&](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i) mixedSum += i;
+      });
+    }
+  });
+  EXPECT(mixedSum == 2 * 8 * 4950);
+
+  // An exception in a chunk reaches the caller, and the pool stays usable
+  bool thrown = false;
+  try {
+    pool.parallelFor(0, 64, 1, [](const size_t begin, const size_t end) {
+      if (begin <= 13 && 13 < end) throw std::runtime_error("index 13");
+    });
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  EXPECT(thrown);
+  std::atomic<size_t> count{0};
+  pool.parallelFor(0, 64, 1, [&](const size_t begin, const size_t end) { count += end - begin; });
+  EXPECT(count == 64);
+
+  // A pool without workers runs everything on the caller
+  ThreadPool inlinePool(0);
+  size_t inlineCount = 0;
+  inlinePool.parallelFor(0, 100, 3, [&](const size_t begin, const size_t end) { inlineCount += end - begin; });
+  EXPECT(inlineCount == 100);
+
+  return Test::Finish("threadpool");
+}
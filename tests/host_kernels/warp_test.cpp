@@ -0,0 +1,107 @@
+// Copyright (2025) Bytedance Ltd. and/or its affiliates
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "test_util.h"
+#include "host/warp.h"
+
+using namespace SecureMR::Host;
+
+namespace {
+
+/**
+ * Per-pixel bilinear warp in double precision, with a zero border: the semantics of <code>ApplyAffine</code>
+ */
+template <typename T>
+std::vector<double> ReferenceAffine(const float affine[6], const std::vector<T>& src, const size_t srcWidth,
+                                    const size_t srcHeight, const size_t channels, const size_t dstWidth,
+                                    const size_t dstHeight) {
+  const double a = affine[0], b = affine[1], c = affine[2], d = affine[3], e = affine[4], f = affine[5];
+  const double det = a * e - b * d;
+  const auto sample = [&](const int64_t x, const int64_t y, const size_t ch) -> double {
+    if (x < 0 || y < 0 || x >= static_cast<int64_t>(srcWidth) || y >= static_cast<int64_t>(srcHeight)) return 0.0;
+    return static_cast<double>(src[(static_cast<size_t>(y) * srcWidth + static_cast<size_t>(x)) * channels + ch]);
+  };
+
+  std::vector<double> dst(dstWidth * dstHeight * channels);
+  for (size_t y = 0; y < dstHeight; ++y) {
+    for (size_t x = 0; x < dstWidth; ++x) {
+      // Invert the source-to-destination matrix for this pixel alone
+      const double dx = static_cast<double>(x) - c;
+      const double dy = static_cast<double>(y) - f;
+      const double sx = (e * dx - b * dy) / det;
+      const double sy = (a * dy - d * dx) / det;
+      const auto x0 = static_cast<int64_t>(std::floor(sx));
+      const auto y0 = static_cast<int64_t>(std::floor(sy));
+      const double wx = sx - static_cast<double>(x0);
+      const double wy = sy - static_cast<double>(y0);
+      for (size_t ch = 0; ch < channels; ++ch) {
+        const double top = sample(x0, y0, ch) * (1.0 - wx) + sample(x0 + 1, y0, ch) * wx;
+        const double bottom = sample(x0, y0 + 1, ch) * (1.0 - wx) + sample(x0 + 1, y0 + 1, ch) * wx;
+        dst[(y * dstWidth + x) * channels + ch] = top * (1.0 - wy) + bottom * wy;
+      }
+    }
+  }
+  return dst;
+}
+
+template <typename T>
+void CheckAffine(const float affine[6], const size_t srcWidth, const size_t srcHeight, const size_t channels,
+                 const size_t dstWidth, const size_t dstHeight, ThreadPool& pool) {
+  const auto src = Test::RandomValues<T>(srcWidth * srcHeight * channels, T(0), T(255),
+                                         static_cast<uint32_t>(srcWidth * 7 + channels));
+  std::vector<T> dst(dstWidth * dstHeight * channels);
+  ApplyAffine(affine, src.data(), srcWidth, srcHeight, channels, dst.data(), dstWidth, dstHeight, pool);
+  const auto expected = ReferenceAffine(affine, src, srcWidth, srcHeight, channels, dstWidth, dstHeight);
+
+  // The kernel steps along rows in float; uint8 output additionally rounds and saturates
+  const double tolerance = std::is_same_v<T, uint8_t> ? 1.0 : 0.02;
+  double maxError = 0.0;
+  for (size_t i = 0; i < dst.size(); ++i) {
+    maxError = std::max(maxError, std::abs(static_cast<double>(dst[i]) - expected[i]));
+  }
+  EXPECT(maxError <= tolerance);
+  if (maxError > tolerance) std::fprintf(stderr, "  max error %f\n", maxError);
+}
+
+}  // namespace
+
+int main() {
+  ThreadPool pool(3);
+
+  // Source-to-destination matrices: identity, integer shift, downscale, and a rotate-and-scale partly outside
+  const float identity[6] = {1, 0, 0, 0, 1, 0};
+  const float shift[6] = {1, 0, -5, 0, 1, 3};
+  const float downscale[6] = {0.5f, 0, 0.25f, 0, 0.5f, 0.25f};
+  const float angle = 0.3f;
+  const float rotate[6] = {0.8f * std::cos(angle), -0.8f * std::sin(angle), 20.0f,
+                           0.8f * std::sin(angle), 0.8f * std::cos(angle), -10.0f};
+
+  for (const size_t channels : {1u, 3u, 4u}) {
+    for (const float* affine : {identity, shift, downscale, rotate}) {
+      CheckAffine<uint8_t>(affine, 97, 61, channels, 83, 70, pool);
+      CheckAffine<float>(affine, 97, 61, channels, 83, 70, pool);
+    }
+  }
+
+  // The identity on uint8 input reproduces it exactly
+  const auto image = Test::RandomValues<uint8_t>(64 * 48 * 3, 0, 255);
+  std::vector<uint8_t> copy(image.size());
+  ApplyAffine(identity, image.data(), 64, 48, 3, copy.data(), 64, 48, pool);
+  EXPECT(copy == image);
+
+  return Test::Finish("warp");
+}